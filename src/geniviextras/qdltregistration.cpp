@@ -45,6 +45,8 @@
 
 #include <QDebug>
 #include <QLoggingCategory>
+#include <QMutexLocker>
+#include <QtMath>
 
 #define GENIVIEXTRAS_DEBUG 0
 #if GENIVIEXTRAS_DEBUG
@@ -67,15 +69,225 @@ QDltRegistration *globalDltRegistration()
 
 QT_END_NAMESPACE
 
+namespace {
+    // Markers used in the context cache for categories which are not registered with a dlt context.
+    // Messages of these categories are either forwarded to the default context or dropped.
+    DltContext fallbackContextMarker;
+    DltContext noContextMarker;
+}
+
+QDltAsyncLogger::QDltAsyncLogger(int capacity, QDltRegistration::OverflowPolicy overflowPolicy, QAtomicInteger<quint64> *droppedMessages)
+    : m_mask(qNextPowerOfTwo(quint32(qMax(capacity, 2) - 1)) - 1)
+    , m_overflowPolicy(overflowPolicy)
+    , m_slots(new Slot[m_mask + 1])
+    , m_enqueuePos(0)
+    , m_dequeuePos(0)
+    , m_processed(0)
+    , m_pending(0)
+    , m_waiting(0)
+    , m_progressWaiters(0)
+    , m_stop(0)
+    , m_finished(false)
+    , m_droppedMessages(droppedMessages)
+{
+    for (quintptr i = 0; i <= m_mask; ++i)
+        m_slots[i].m_sequence.store(i);
+}
+
+QDltAsyncLogger::~QDltAsyncLogger()
+{
+    stop();
+}
+
+void QDltAsyncLogger::log(DltContext *context, DltLogLevelType logLevel, const QByteArray &message)
+{
+    // Messages logged by DLT itself can't wait for the logger thread. Once the logger is stopped,
+    // nobody forwards queued messages anymore.
+    if (QThread::currentThread() == this || m_stop.loadAcquire()) {
+        DLT_LOG(*context, logLevel, DLT_STRING(message.constData()));
+        return;
+    }
+
+    while (!tryPush(context, logLevel, message)) {
+        switch (m_overflowPolicy) {
+        case QDltRegistration::DropNewestMessage:
+            m_droppedMessages->fetchAndAddRelaxed(1);
+            return;
+        case QDltRegistration::DropOldestMessage:
+            if (tryPop([](Slot &) {}))
+                m_droppedMessages->fetchAndAddRelaxed(1);
+            break;
+        case QDltRegistration::BlockUntilSpaceAvailable:
+            if (m_stop.loadAcquire()) {
+                DLT_LOG(*context, logLevel, DLT_STRING(message.constData()));
+                return;
+            }
+            // A slot is free again once the logger thread processed one more message
+            waitForProcessed(m_processed.loadAcquire() + 1);
+            break;
+        }
+    }
+
+    // The logger thread might have done its final drain while the message was added
+    if (m_stop.loadAcquire())
+        drain();
+    else if (m_waiting.load())
+        wakeUp();
+}
+
+/*
+    Waits until all messages which have been queued before have been forwarded to DLT.
+*/
+void QDltAsyncLogger::flush()
+{
+    if (QThread::currentThread() == this)
+        return;
+
+    waitForProcessed(m_enqueuePos.loadAcquire());
+}
+
+void QDltAsyncLogger::stop()
+{
+    m_stop.fetchAndStoreOrdered(1);
+    wakeUp();
+    wait();
+}
+
+void QDltAsyncLogger::run()
+{
+    while (true) {
+        if (drain() > 0)
+            continue;
+
+        if (m_stop.loadAcquire()) {
+            // Everything which was queued before stopping gets logged
+            drain();
+            QMutexLocker locker(&m_waitMutex);
+            m_finished = true;
+            m_progressCondition.wakeAll();
+            return;
+        }
+
+        QMutexLocker locker(&m_waitMutex);
+        m_waiting.fetchAndStoreOrdered(1);
+        // The timeout is only a safety net, producers wake up the thread when it is waiting
+        if (m_pending.load() == 0 && !m_stop.load())
+            m_waitCondition.wait(&m_waitMutex, 100);
+        m_waiting.fetchAndStoreOrdered(0);
+    }
+}
+
+void QDltAsyncLogger::wakeUp()
+{
+    QMutexLocker locker(&m_waitMutex);
+    m_waitCondition.wakeOne();
+}
+
+/*
+    Blocks until \a target messages have been taken from the queue in total, or the logger
+    thread finished.
+*/
+void QDltAsyncLogger::waitForProcessed(quintptr target)
+{
+    QMutexLocker locker(&m_waitMutex);
+    m_progressWaiters.ref();
+    while (m_processed.loadAcquire() < target && !m_finished) {
+        m_waitCondition.wakeOne();
+        // The timeout is only a safety net, the logger thread wakes up the waiting threads
+        m_progressCondition.wait(&m_waitMutex, 100);
+    }
+    m_progressWaiters.deref();
+}
+
+void QDltAsyncLogger::notifyProgress()
+{
+    if (!m_progressWaiters.loadAcquire())
+        return;
+
+    QMutexLocker locker(&m_waitMutex);
+    m_progressCondition.wakeAll();
+}
+
+int QDltAsyncLogger::drain()
+{
+    int count = 0;
+    while (tryPop([](Slot &slot) {
+        DLT_LOG(*slot.m_context, slot.m_logLevel, DLT_STRING(slot.m_payload));
+    })) {
+        ++count;
+        notifyProgress();
+    }
+    return count;
+}
+
+// Bounded multi-producer/multi-consumer queue, see Dmitry Vyukov's bounded MPMC queue
+bool QDltAsyncLogger::tryPush(DltContext *context, DltLogLevelType logLevel, const QByteArray &message)
+{
+    quintptr pos = m_enqueuePos.load();
+    Slot *slot;
+    while (true) {
+        slot = &m_slots[pos & m_mask];
+        const qintptr diff = qintptr(slot->m_sequence.loadAcquire()) - qintptr(pos);
+        if (diff == 0) {
+            if (m_enqueuePos.testAndSetRelaxed(pos, pos + 1))
+                break;
+            pos = m_enqueuePos.load();
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = m_enqueuePos.load();
+        }
+    }
+
+    slot->m_context = context;
+    slot->m_logLevel = logLevel;
+    const int length = qMin(message.size(), int(MaxPayloadSize) - 1);
+    memcpy(slot->m_payload, message.constData(), size_t(length));
+    slot->m_payload[length] = '\0';
+
+    m_pending.fetchAndAddOrdered(1);
+    slot->m_sequence.storeRelease(pos + 1);
+    return true;
+}
+
+template <typename Function> bool QDltAsyncLogger::tryPop(Function function)
+{
+    quintptr pos = m_dequeuePos.load();
+    Slot *slot;
+    while (true) {
+        slot = &m_slots[pos & m_mask];
+        const qintptr diff = qintptr(slot->m_sequence.loadAcquire()) - qintptr(pos + 1);
+        if (diff == 0) {
+            if (m_dequeuePos.testAndSetRelaxed(pos, pos + 1))
+                break;
+            pos = m_dequeuePos.load();
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = m_dequeuePos.load();
+        }
+    }
+
+    function(*slot);
+
+    slot->m_sequence.storeRelease(pos + m_mask + 1);
+    m_pending.fetchAndAddOrdered(-1);
+    m_processed.fetchAndAddOrdered(1);
+    return true;
+}
+
 QDltRegistrationPrivate::QDltRegistrationPrivate(QDltRegistration *parent)
     : q_ptr(parent)
     , m_dltAppRegistered(false)
     , m_registerOnFirstUse(false)
+    , m_mutex(QMutex::Recursive)
+    , m_droppedMessages(0)
 {
 }
 
 void QDltRegistrationPrivate::registerCategory(const QLoggingCategory *category, DltContext *dltContext, const char *dltCtxName, const char *dltCtxDescription)
 {
+    QMutexLocker locker(&m_mutex);
     CategoryInfo info;
     info.m_category = const_cast<QLoggingCategory*>(category);
     info.m_ctxName = dltCtxName;
@@ -86,6 +298,8 @@ void QDltRegistrationPrivate::registerCategory(const QLoggingCategory *category,
         registerCategory(info);
     } else {
         info.m_registered = false;
+        // Make sure the next message is not forwarded to the fallback context anymore
+        cacheContext(category->categoryName(), nullptr);
     }
 
     m_categoryInfoHash.insert(QString::fromLatin1(category->categoryName()), info);
@@ -105,6 +319,9 @@ void QDltRegistrationPrivate::registerCategory(CategoryInfo &info)
     DLT_REGISTER_LOG_LEVEL_CHANGED_CALLBACK(*info.m_context, &qtGeniviLogLevelChangedHandler);
 #endif
     info.m_registered = true;
+    cacheContext(info.m_category->categoryName(), info.m_context);
+    if (m_defaultCategory == QLatin1String(info.m_category->categoryName()))
+        m_defaultContext.storeRelease(info.m_context);
 }
 
 void QDltRegistrationPrivate::registerApplication()
@@ -116,30 +333,121 @@ void QDltRegistrationPrivate::registerApplication()
 
 void QDltRegistrationPrivate::setDefaultCategory(const QString &category)
 {
+    QMutexLocker locker(&m_mutex);
     Q_ASSERT_X(m_categoryInfoHash.contains(category), "setDefaultContext", "The category needs to be registered as a dlt logging category before it can be set as a default context");
     m_defaultCategory = category;
+
+    const CategoryInfo info = m_categoryInfoHash.value(category);
+    m_defaultContext.storeRelease(info.m_registered ? info.m_context : nullptr);
+
+    // Categories which have been dropped so far use the new default context from now on
+    for (ContextCacheEntry &entry : m_contextCache) {
+        if (entry.m_context.loadAcquire() == &noContextMarker)
+            entry.m_context.storeRelease(&fallbackContextMarker);
+    }
 }
 
+/*
+    Resolves the dlt context for \a categoryName, registers it with the dlt-daemon if needed and
+    stores the result in the context cache.
+*/
 DltContext *QDltRegistrationPrivate::context(const char *categoryName)
 {
+    QMutexLocker locker(&m_mutex);
     QString category = QString::fromLatin1(categoryName);
-    if (!m_categoryInfoHash.contains(category) && !m_defaultCategory.isEmpty())
+    const bool fallback = !m_categoryInfoHash.contains(category);
+    if (fallback) {
+        if (m_defaultCategory.isEmpty()) {
+            cacheContext(categoryName, &noContextMarker);
+            return nullptr;
+        }
         category = m_defaultCategory;
+    }
 
-    CategoryInfo &info = m_categoryInfoHash[category];
+    const auto it = m_categoryInfoHash.find(category);
+    if (it == m_categoryInfoHash.end())
+        return nullptr;
+
+    CategoryInfo &info = it.value();
     if (info.m_context && !info.m_registered) {
         if (!m_dltAppRegistered)
             registerApplication();
         registerCategory(info);
     }
 
+    if (fallback)
+        cacheContext(categoryName, &fallbackContextMarker);
+    else if (info.m_registered)
+        cacheContext(categoryName, info.m_context);
+
     return info.m_context;
 }
 
+/*
+    Looks up \a categoryName in the context cache without taking any lock.
+
+    Returns \c false if the category is not cached yet and context() needs to be used instead.
+    Otherwise \a context is set to the registered dlt context or \c nullptr if the messages of
+    this category should be dropped.
+*/
+bool QDltRegistrationPrivate::cachedContext(const char *categoryName, DltContext **context) const
+{
+    const uint start = qHash(quintptr(categoryName));
+    for (int i = 0; i < ContextCacheSize; ++i) {
+        const ContextCacheEntry &entry = m_contextCache[(start + uint(i)) % ContextCacheSize];
+        const char *category = entry.m_category.loadAcquire();
+        if (!category)
+            return false;
+        if (category != categoryName)
+            continue;
+
+        DltContext *dltContext = entry.m_context.loadAcquire();
+        if (dltContext == &noContextMarker) {
+            *context = nullptr;
+            return true;
+        }
+        if (dltContext == &fallbackContextMarker)
+            dltContext = m_defaultContext.loadAcquire();
+        if (!dltContext)
+            return false;
+
+        *context = dltContext;
+        return true;
+    }
+    return false;
+}
+
+/*
+    Stores \a context for \a categoryName in the context cache. Needs to be called with m_mutex
+    locked. A \c nullptr \a context invalidates an existing entry.
+*/
+void QDltRegistrationPrivate::cacheContext(const char *categoryName, DltContext *context)
+{
+    const uint start = qHash(quintptr(categoryName));
+    for (int i = 0; i < ContextCacheSize; ++i) {
+        ContextCacheEntry &entry = m_contextCache[(start + uint(i)) % ContextCacheSize];
+        const char *category = entry.m_category.loadAcquire();
+        if (category == categoryName) {
+            entry.m_context.storeRelease(context);
+            return;
+        }
+        if (!category) {
+            if (!context)
+                return;
+            // Publish the context before the key, a reader matching the key always sees a valid context
+            entry.m_context.storeRelease(context);
+            entry.m_category.storeRelease(categoryName);
+            return;
+        }
+    }
+    // The cache is full, the category is always resolved using context()
+}
+
 void QDltRegistrationPrivate::dltLogLevelChanged(char context_id[], uint8_t log_level, uint8_t trace_status)
 {
     Q_Q(QDltRegistration);
     Q_UNUSED(trace_status)
+    QMutexLocker locker(&m_mutex);
 
     for (auto it = m_categoryInfoHash.begin(); it != m_categoryInfoHash.end(); ++it) {
         if (it.value().m_ctxName != context_id)
@@ -207,6 +515,37 @@ DltLogLevelType QDltRegistrationPrivate::category2dltLevel(const QLoggingCategor
     return logLevel;
 }
 
+DltLogLevelType QDltRegistrationPrivate::severity2dltLevel(QtMsgType type)
+{
+    switch (type) {
+    case QtDebugMsg: return DLT_LOG_DEBUG;
+#if QT_VERSION >= 0x050500
+    case QtInfoMsg: return DLT_LOG_INFO;
+#endif
+    case QtWarningMsg: return DLT_LOG_WARN;
+    case QtCriticalMsg: return DLT_LOG_ERROR;
+    case QtFatalMsg: return DLT_LOG_FATAL;
+    }
+
+    return DLT_LOG_OFF;
+}
+
+/*
+    Returns whether the dlt-daemon accepts messages with \a logLevel for \a context.
+
+    This is the same check DLT does when logging a message, but doing it upfront allows to skip
+    formatting messages which would be discarded anyway.
+*/
+bool QDltRegistrationPrivate::isLogLevelEnabled(const DltContext *context, DltLogLevelType logLevel)
+{
+    if (!context->log_level_ptr)
+        return true;
+
+    // A negative level means the default log level of the daemon is used, let DLT decide
+    const int contextLogLevel = *context->log_level_ptr;
+    return contextLogLevel < 0 || int(logLevel) <= contextLogLevel;
+}
+
 /*!
     \class QDltRegistration
     \inmodule QtGeniviExtras
@@ -227,6 +566,10 @@ QDltRegistration::QDltRegistration(QObject *parent)
 
 QDltRegistration::~QDltRegistration()
 {
+    Q_D(QDltRegistration);
+    disableAsynchronousLogging();
+    qDeleteAll(d->m_asyncLoggers);
+    d->m_asyncLoggers.clear();
     unregisterApplication();
 }
 
@@ -244,6 +587,7 @@ QDltRegistration::~QDltRegistration()
 void QDltRegistration::registerApplication(const char *dltAppID, const char *dltAppDescription)
 {
     Q_D(QDltRegistration);
+    QMutexLocker locker(&d->m_mutex);
     bool registerCategories = false;
     if (d->m_dltAppRegistered) {
         unregisterApplication();
@@ -307,6 +651,7 @@ void QDltRegistration::setDefaultContext(const char *categoryName)
 void QDltRegistration::setRegisterContextOnFirstUseEnabled(bool enabled)
 {
     Q_D(QDltRegistration);
+    QMutexLocker locker(&d->m_mutex);
     d->m_registerOnFirstUse = enabled;
 }
 
@@ -325,6 +670,7 @@ void QDltRegistration::registerUnregisteredContexts()
     std::cout << "REGISTERING UNREGISTERED CONTEXTS" << std::endl;
 #endif
     Q_D(QDltRegistration);
+    QMutexLocker locker(&d->m_mutex);
     if (!d->m_dltAppRegistered)
         d->registerApplication();
     for (auto it = d->m_categoryInfoHash.begin(); it != d->m_categoryInfoHash.end(); ++it) {
@@ -334,6 +680,92 @@ void QDltRegistration::registerUnregisteredContexts()
     }
 }
 
+/*!
+    \enum QDltRegistration::OverflowPolicy
+
+    Defines what happens when a message is logged while the buffer of the asynchronous logging is
+    full.
+
+    \value DropNewestMessage
+           The new message is discarded.
+    \value DropOldestMessage
+           The oldest message in the buffer is discarded to make room for the new message.
+    \value BlockUntilSpaceAvailable
+           The logging thread waits until the message can be added to the buffer.
+*/
+
+/*!
+    Enables the asynchronous logging.
+
+    Instead of forwarding the messages to the dlt-daemon from the thread which is logging, the
+    messageHandler copies them into a buffer which is able to hold \a bufferSize messages. The
+    buffer is drained by a dedicated thread, which means that a slow dlt-daemon doesn't stall the
+    threads which are logging. Messages longer than 1023 bytes are truncated.
+
+    The \a overflowPolicy defines what happens when a message is logged while the buffer is full.
+    The number of discarded messages is reported by droppedMessages().
+
+    Fatal messages are always forwarded synchronously, after all buffered messages have been
+    forwarded.
+
+    Calling this function while the asynchronous logging is already enabled, restarts it with the
+    new settings.
+
+    \sa disableAsynchronousLogging()
+*/
+void QDltRegistration::enableAsynchronousLogging(int bufferSize, QDltRegistration::OverflowPolicy overflowPolicy)
+{
+    Q_D(QDltRegistration);
+    QMutexLocker locker(&d->m_mutex);
+    disableAsynchronousLogging();
+
+    auto *logger = new QDltAsyncLogger(bufferSize, overflowPolicy, &d->m_droppedMessages);
+    logger->setObjectName(QStringLiteral("QDltAsyncLogger"));
+    d->m_asyncLoggers.append(logger);
+    logger->start();
+    d->m_asyncLogger.storeRelease(logger);
+}
+
+/*!
+    Disables the asynchronous logging.
+
+    All messages which are still buffered are forwarded to the dlt-daemon before this function
+    returns.
+
+    \sa enableAsynchronousLogging()
+*/
+void QDltRegistration::disableAsynchronousLogging()
+{
+    Q_D(QDltRegistration);
+    QMutexLocker locker(&d->m_mutex);
+    QDltAsyncLogger *logger = d->m_asyncLogger.fetchAndStoreOrdered(nullptr);
+    if (logger)
+        logger->stop();
+}
+
+/*!
+    Returns \c true if the asynchronous logging is enabled.
+
+    \sa enableAsynchronousLogging()
+*/
+bool QDltRegistration::isAsynchronousLoggingEnabled() const
+{
+    Q_D(const QDltRegistration);
+    return d->m_asyncLogger.loadAcquire() != nullptr;
+}
+
+/*!
+    Returns the number of messages which have been discarded because the buffer of the
+    asynchronous logging was full.
+
+    \sa enableAsynchronousLogging()
+*/
+quint64 QDltRegistration::droppedMessages() const
+{
+    Q_D(const QDltRegistration);
+    return d->m_droppedMessages.load();
+}
+
 /*!
     Unregisters the application with the dlt-daemon.
     The registered application as well as all registered dlt context will be deleted.
@@ -341,6 +773,7 @@ void QDltRegistration::registerUnregisteredContexts()
 void QDltRegistration::unregisterApplication()
 {
     Q_D(QDltRegistration);
+    QMutexLocker locker(&d->m_mutex);
     if (d->m_dltAppRegistered)
         DLT_UNREGISTER_APP();
 
@@ -356,6 +789,13 @@ void QDltRegistration::unregisterApplication()
     If the category in \a msgCtx hasn't been registered with a dlt context, the fallback logging category
     will be used instead (if one is registered).
 
+    The function can be called from any thread. After the first message of a category, the dlt
+    context is resolved without locking, and messages which are filtered by the log level of the
+    dlt context are discarded before they are formatted.
+
+    If the asynchronous logging is enabled, the messages are forwarded from a dedicated thread.
+    See enableAsynchronousLogging() for more information.
+
     This messageHandler needs to be installed using:
     \badcode
     qInstallMessageHandler(QDltRegistration::messageHandler);
@@ -363,20 +803,28 @@ void QDltRegistration::unregisterApplication()
 */
 void QDltRegistration::messageHandler(QtMsgType msgTypes, const QMessageLogContext &msgCtx, const QString &msg)
 {
-    DltContext *dltCtx = globalDltRegistration()->d_ptr->context(msgCtx.category);
+    QDltRegistrationPrivate *d = globalDltRegistration()->d_ptr;
+    const char *category = msgCtx.category ? msgCtx.category : "default";
+
+    // The lock-free cache is used for all messages except the first of every category
+    DltContext *dltCtx = nullptr;
+    if (!d->cachedContext(category, &dltCtx))
+        dltCtx = d->context(category);
     if (!dltCtx)
         return;
 
-    DltLogLevelType logLevel = DLT_LOG_OFF;
+    const DltLogLevelType logLevel = QDltRegistrationPrivate::severity2dltLevel(msgTypes);
+    if (!QDltRegistrationPrivate::isLogLevelEnabled(dltCtx, logLevel))
+        return;
 
-    switch (msgTypes) {
-    case QtDebugMsg: logLevel = DLT_LOG_DEBUG; break;
-#if QT_VERSION >= 0x050500
-    case QtInfoMsg: logLevel = DLT_LOG_INFO; break;
-#endif
-    case QtWarningMsg: logLevel = DLT_LOG_WARN; break;
-    case QtCriticalMsg: logLevel = DLT_LOG_ERROR; break;
-    case QtFatalMsg: logLevel = DLT_LOG_FATAL; break;
+    QDltAsyncLogger *logger = d->m_asyncLogger.loadAcquire();
+    if (logger) {
+        if (msgTypes != QtFatalMsg) {
+            logger->log(dltCtx, logLevel, qFormatLogMessage(msgTypes, msgCtx, msg).toLocal8Bit());
+            return;
+        }
+        // The application is aborted after a fatal message, make sure it doesn't get lost
+        logger->flush();
     }
 
     DLT_LOG(*dltCtx, logLevel, DLT_STRING(qPrintable(qFormatLogMessage(msgTypes, msgCtx, msg))));
@@ -59,6 +59,13 @@ class Q_GENIVIEXTRAS_EXPORT QDltRegistration : public QObject
     Q_DISABLE_COPY(QDltRegistration)
 
 public:
+    enum OverflowPolicy {
+        DropNewestMessage,
+        DropOldestMessage,
+        BlockUntilSpaceAvailable
+    };
+    Q_ENUM(OverflowPolicy)
+
     QDltRegistration(QObject *parent = nullptr);
     ~QDltRegistration() override;
 
@@ -71,6 +78,11 @@ public:
     void setRegisterContextOnFirstUseEnabled(bool enabled);
     void registerUnregisteredContexts();
 
+    void enableAsynchronousLogging(int bufferSize = 1024, QDltRegistration::OverflowPolicy overflowPolicy = DropNewestMessage);
+    void disableAsynchronousLogging();
+    bool isAsynchronousLoggingEnabled() const;
+    quint64 droppedMessages() const;
+
     static void messageHandler(QtMsgType msgTypes, const QMessageLogContext &msgCtx, const QString &msg);
 
 Q_SIGNALS:
@@ -41,8 +41,17 @@
 ****************************************************************************/
 
 #include <private/qgeniviextrasglobal_p.h>
-#include <QString>
+#include <QAtomicInteger>
+#include <QAtomicPointer>
 #include <QHash>
+#include <QMutex>
+#include <QScopedArrayPointer>
+#include <QString>
+#include <QThread>
+#include <QVector>
+#include <QWaitCondition>
+
+#include "qdltregistration.h"
 
 #include <dlt.h>
 
@@ -61,7 +70,55 @@ QT_BEGIN_NAMESPACE
 
 void qtGeniviLogLevelChangedHandler(char context_id[], uint8_t log_level, uint8_t trace_status);
 
-class QDltRegistration;
+// Forwards the messages to DLT from a dedicated thread. The messages are copied into a
+// preallocated, bounded queue which can be filled from multiple threads without locking and
+// is drained in batches.
+class QDltAsyncLogger : public QThread
+{
+public:
+    enum { MaxPayloadSize = 1024 };
+
+    QDltAsyncLogger(int capacity, QDltRegistration::OverflowPolicy overflowPolicy, QAtomicInteger<quint64> *droppedMessages);
+    ~QDltAsyncLogger() override;
+
+    void log(DltContext *context, DltLogLevelType logLevel, const QByteArray &message);
+    void flush();
+    void stop();
+
+protected:
+    void run() override;
+
+private:
+    struct Slot {
+        QAtomicInteger<quintptr> m_sequence;
+        DltContext *m_context;
+        DltLogLevelType m_logLevel;
+        char m_payload[MaxPayloadSize];
+    };
+
+    bool tryPush(DltContext *context, DltLogLevelType logLevel, const QByteArray &message);
+    template <typename Function> bool tryPop(Function function);
+    int drain();
+    void wakeUp();
+    void waitForProcessed(quintptr target);
+    void notifyProgress();
+
+    const quintptr m_mask;
+    const QDltRegistration::OverflowPolicy m_overflowPolicy;
+    QScopedArrayPointer<Slot> m_slots;
+    QAtomicInteger<quintptr> m_enqueuePos;
+    QAtomicInteger<quintptr> m_dequeuePos;
+    QAtomicInteger<quintptr> m_processed;
+    QAtomicInt m_pending;
+    QAtomicInt m_waiting;
+    QAtomicInt m_progressWaiters;
+    QAtomicInt m_stop;
+    bool m_finished;
+    QAtomicInteger<quint64> *m_droppedMessages;
+    QMutex m_waitMutex;
+    QWaitCondition m_waitCondition;
+    QWaitCondition m_progressCondition;
+};
 
 class QDltRegistrationPrivate
 {
@@ -85,10 +142,13 @@ public:
     void setDefaultCategory(const QString &category);
 
     DltContext *context(const char *categoryName);
+    bool cachedContext(const char *categoryName, DltContext **context) const;
+    void cacheContext(const char *categoryName, DltContext *context);
     void dltLogLevelChanged(char context_id[], uint8_t log_level, uint8_t trace_status);
 
     static DltLogLevelType category2dltLevel(const QLoggingCategory *category);
     static DltLogLevelType severity2dltLevel(QtMsgType type);
+    static bool isLogLevelEnabled(const DltContext *context, DltLogLevelType logLevel);
 
 private:
     QDltRegistration *const q_ptr;
@@ -99,6 +159,26 @@ private:
     QString m_defaultCategory;
     QHash<QString, CategoryInfo> m_categoryInfoHash;
     bool m_registerOnFirstUse;
+
+    // Guards all members above. The messageHandler only takes it if the context cache misses.
+    QMutex m_mutex;
+
+    // Lock-free cache used by the messageHandler, keyed by the address of the category name.
+    // Entries are only added or updated while holding m_mutex and are never removed, which allows
+    // reading them concurrently from any thread.
+    struct ContextCacheEntry {
+        QAtomicPointer<const char> m_category;
+        QAtomicPointer<DltContext> m_context;
+    };
+    static const int ContextCacheSize = 256;
+    ContextCacheEntry m_contextCache[ContextCacheSize];
+    QAtomicPointer<DltContext> m_defaultContext;
+
+    // Loggers are never deleted while the registration exists, as the messageHandler might still
+    // use a logger which has been disabled concurrently.
+    QAtomicPointer<QDltAsyncLogger> m_asyncLogger;
+    QVector<QDltAsyncLogger*> m_asyncLoggers;
+    QAtomicInteger<quint64> m_droppedMessages;
 };
 
 QT_END_NAMESPACE
@@ -52,6 +52,7 @@ HEADERS += \
     qivisearchandbrowsemodelinterface.h \
     qivisearchandbrowsemodelinterface_p.h \
     qivistandarditem.h \
+    qivistandarditembatch.h \
     qivifeatureinterface.h \
     qividefaultpropertyoverrider_p.h \
     qivipendingreply.h \
@@ -59,7 +60,10 @@ HEADERS += \
     qivisimulationengine.h \
     qivisimulationproxy.h \
     qtivicoremodule.h \
-    qivisimulationglobalobject_p.h
+    qivisimulationglobalobject_p.h \
+    qiviupdatethrottle_p.h \
+    qiviqueryevaluator.h \
+    qiviqueryevaluator_p.h
 
 SOURCES += \
     qiviservicemanager.cpp \
@@ -78,6 +82,7 @@ SOURCES += \
     qivisearchandbrowsemodel.cpp \
     qivisearchandbrowsemodelinterface.cpp \
     qivistandarditem.cpp \
+    qivistandarditembatch.cpp \
     qivifeatureinterface.cpp \
     qividefaultpropertyoverrider.cpp \
     qiviqmlconversion_helper.cpp \
@@ -85,7 +90,9 @@ SOURCES += \
     qivisimulationengine.cpp \
     qivisimulationproxy.cpp \
     qtivicoremodule.cpp \
-    qivisimulationglobalobject.cpp
+    qivisimulationglobalobject.cpp \
+    qiviupdatethrottle.cpp \
+    qiviqueryevaluator.cpp
 
 include(queryparser/queryparser.pri)
 
@@ -47,6 +47,7 @@
 #include "qiviservicemanager.h"
 #include "qiviservicemanager_p.h"
 #include "qiviserviceobject.h"
+#include "qiviqmlconversion_helper.h"
 
 #include <QDebug>
 #include <QMetaEnum>
@@ -58,31 +59,76 @@ QIviAbstractFeaturePrivate::QIviAbstractFeaturePrivate(const QString &interface,
     , q_ptr(parent)
     , m_interface(interface)
     , m_serviceObject(nullptr)
+    , m_backend(nullptr)
     , m_discoveryMode(QIviAbstractFeature::AutoDiscovery)
     , m_discoveryResult(QIviAbstractFeature::NoResult)
     , m_error(QIviAbstractFeature::NoError)
     , m_qmlCreation(false)
     , m_isInitialized(false)
     , m_isConnected(false)
+    , m_asynchronousDiscovery(false)
+    , m_discoveryPending(false)
     , m_supportsPropertyOverriding(false)
     , m_propertyOverride(nullptr)
+    , m_updatePolicy(QIviAbstractFeature::ImmediateUpdates)
+    , m_updateRate(60)
+    , m_updateDeadband(0)
 {
     qRegisterMetaType<QIviAbstractFeature::Error>();
     qRegisterMetaType<QIviAbstractFeature::DiscoveryMode>();
     qRegisterMetaType<QIviAbstractFeature::DiscoveryResult>();
+    qRegisterMetaType<QIviAbstractFeature::UpdatePolicy>();
 }
 
 void QIviAbstractFeaturePrivate::initialize()
 {
 }
 
-bool QIviAbstractFeaturePrivate::notify(const QByteArray &propertyName, const QVariant &value)
+bool QIviAbstractFeaturePrivate::notify(int propertyIndex, const QVariant &value)
 {
-    Q_UNUSED(propertyName);
+    Q_UNUSED(propertyIndex);
     Q_UNUSED(value);
     return false;
 }
 
+/*!
+    \internal Applies a property update from the backend which was held back by the
+    QIviUpdateThrottle because of the configured QIviAbstractFeature::UpdatePolicy.
+
+    Features which pass their updates to the throttle need to reimplement this function and
+    store \a value for the property at \a propertyIndex the same way as if it was sent by the
+    backend directly.
+*/
+void QIviAbstractFeaturePrivate::applyUpdate(int propertyIndex, const QVariant &value)
+{
+    Q_UNUSED(propertyIndex);
+    Q_UNUSED(value);
+}
+
+/*!
+    \internal Creates the QIviUpdateThrottle once a policy other than
+    QIviAbstractFeature::ImmediateUpdates is configured and deletes it again, once all updates are
+    immediate again.
+*/
+void QIviAbstractFeaturePrivate::updatePolicyChanged()
+{
+    const bool needed = m_updatePolicy != QIviAbstractFeature::ImmediateUpdates
+            || (m_updateThrottle && m_updateThrottle->hasPropertyPolicies());
+
+    if (!needed) {
+        if (m_updateThrottle) {
+            m_updateThrottle->flush();
+            m_updateThrottle.reset();
+        }
+        return;
+    }
+
+    if (m_updateThrottle)
+        m_updateThrottle->policyChanged();
+    else
+        m_updateThrottle.reset(new QIviUpdateThrottle(this));
+}
+
 /*!
     \internal Returns the backend object retrieved from calling interfaceInstance() with the
     interfaceName of this private class.
@@ -90,12 +136,17 @@ bool QIviAbstractFeaturePrivate::notify(const QByteArray &propertyName, const QV
     This is the is a sane default for most classes and provides a convenient way to get the backend
     interface and also allow manually overwritting it to something else.
 
+    The backend is resolved once when connecting to a service object and cached until the feature
+    disconnects from it.
+
     If the derived class needs to connect to a different interface than defined by interfaceName or
     to an additional interface, it can still manually ask for the needed interfaceInstance using
     the QIviServiceObject directly.
 */
 QIviFeatureInterface *QIviAbstractFeaturePrivate::backend() const
 {
+    if (m_backend)
+        return m_backend;
     Q_Q(const QIviAbstractFeature);
     if (m_serviceObject)
         return m_serviceObject->interfaceInstance(q->interfaceName());
@@ -117,6 +168,105 @@ void QIviAbstractFeaturePrivate::setDiscoveryResult(QIviAbstractFeature::Discove
     emit q->discoveryResultChanged(discoveryResult);
 }
 
+QIviAbstractFeature::DiscoveryResult QIviAbstractFeaturePrivate::discoverServiceObject()
+{
+    Q_Q(QIviAbstractFeature);
+
+    m_discoveryPending = false;
+
+    // No need to discover a new backend when we already have one
+    if (m_serviceObject || m_discoveryMode == QIviAbstractFeature::NoAutoDiscovery) {
+        setDiscoveryResult(QIviAbstractFeature::NoResult);
+        return QIviAbstractFeature::NoResult;
+    }
+
+    QIviServiceManager *serviceManager = QIviServiceManager::instance();
+    QList<QIviServiceObject*> serviceObjects;
+    QIviAbstractFeature::DiscoveryResult result = QIviAbstractFeature::NoResult;
+    if (m_discoveryMode == QIviAbstractFeature::AutoDiscovery || m_discoveryMode == QIviAbstractFeature::LoadOnlyProductionBackends) {
+        serviceObjects = serviceManager->findServiceByInterface(m_interface, QIviServiceManager::IncludeProductionBackends);
+        result = QIviAbstractFeature::ProductionBackendLoaded;
+    }
+
+    //Check whether we can use the found production backends
+    bool serviceObjectSet = false;
+    for (QIviServiceObject *object : qAsConst(serviceObjects)) {
+        qCDebug(qLcIviServiceManagement) << "Trying to use" << object << "Supported Interfaces:" << object->interfaces();
+        if (q->setServiceObject(object)) {
+            serviceObjectSet = true;
+            break;
+        }
+    }
+
+    //If no production backends are found or none of them accepted fall back to the simulation backends
+    if (!serviceObjectSet) {
+
+        if (Q_UNLIKELY(m_discoveryMode == QIviAbstractFeature::AutoDiscovery || m_discoveryMode == QIviAbstractFeature::LoadOnlyProductionBackends))
+            qWarning() << "There is no production backend implementing" << m_interface << ".";
+
+        if (m_discoveryMode == QIviAbstractFeature::AutoDiscovery || m_discoveryMode == QIviAbstractFeature::LoadOnlySimulationBackends) {
+            serviceObjects = serviceManager->findServiceByInterface(m_interface, QIviServiceManager::IncludeSimulationBackends);
+            result = QIviAbstractFeature::SimulationBackendLoaded;
+            if (Q_UNLIKELY(serviceObjects.isEmpty()))
+                qWarning() << "There is no simulation backend implementing" << m_interface << ".";
+
+            for (QIviServiceObject* object : qAsConst(serviceObjects)) {
+                qCDebug(qLcIviServiceManagement) << "Trying to use" << object << "Supported Interfaces:" << object->interfaces();
+                if (q->setServiceObject(object)) {
+                    serviceObjectSet = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (Q_UNLIKELY(serviceObjects.count() > 1))
+        qWarning() << "There is more than one backend implementing" << m_interface << ". Using the first one";
+
+    if (Q_UNLIKELY(!serviceObjectSet)) {
+        qWarning() << "No suitable ServiceObject found.";
+        setDiscoveryResult(QIviAbstractFeature::ErrorWhileLoading);
+        return QIviAbstractFeature::ErrorWhileLoading;
+    }
+
+    setDiscoveryResult(result);
+    return result;
+}
+
+void QIviAbstractFeaturePrivate::startAsynchronousDiscovery()
+{
+    if (m_discoveryPending)
+        return;
+    m_discoveryPending = true;
+
+    // Simulation backends are only loaded if no production backend could be loaded, the same way
+    // the synchronous discovery falls back to them.
+    if (m_discoveryMode == QIviAbstractFeature::LoadOnlySimulationBackends)
+        loadBackendsAsync(QIviServiceManager::IncludeSimulationBackends);
+    else
+        loadBackendsAsync(QIviServiceManager::IncludeProductionBackends);
+}
+
+void QIviAbstractFeaturePrivate::loadBackendsAsync(QIviServiceManager::SearchFlags searchFlags)
+{
+    Q_Q(QIviAbstractFeature);
+    QIviServiceManagerPrivate *manager = QIviServiceManagerPrivate::get(QIviServiceManager::instance());
+    manager->loadBackendsAsync(m_interface, searchFlags, q, [this, manager, searchFlags]() {
+        if (!m_discoveryPending)
+            return;
+
+        if (m_discoveryMode == QIviAbstractFeature::AutoDiscovery
+                && searchFlags == QIviServiceManager::IncludeProductionBackends
+                && !manager->hasLoadedBackend(m_interface, searchFlags)) {
+            loadBackendsAsync(QIviServiceManager::IncludeSimulationBackends);
+            return;
+        }
+
+        // All plugins are loaded now and the discovery doesn't block anymore
+        discoverServiceObject();
+    });
+}
+
 void QIviAbstractFeaturePrivate::onInitializationDone()
 {
     if (m_isInitialized)
@@ -213,6 +363,19 @@ void QIviAbstractFeaturePrivate::onInitializationDone()
           As a result of the auto discovery a simulation backend was loaded
 */
 
+/*!
+    \enum QIviAbstractFeature::UpdatePolicy
+
+    \value ImmediateUpdates
+          Every property update of the backend is applied right away
+    \value CoalescedUpdates
+          All updates of a property within one iteration of the event loop are collapsed into the latest value
+    \value RateLimitedUpdates
+          A property is updated at most \l updateRate times per second, intermediate values are collapsed into the latest value
+    \value DeadbandUpdates
+          Updates of numeric properties are only applied if they differ from the last applied value by at least \l updateDeadband
+*/
+
 /*!
     \qmltype AbstractFeature
     \qmlabstract
@@ -291,6 +454,7 @@ bool QIviAbstractFeature::setServiceObject(QIviServiceObject *so)
     }
 
     d->m_serviceObject = nullptr;
+    d->m_backend = nullptr;
 
     //We only want to call clearServiceObject if we are sure that the serviceObject changes
     if (!so) {
@@ -311,6 +475,7 @@ bool QIviAbstractFeature::setServiceObject(QIviServiceObject *so)
     emit isValidChanged(isValid());
 
     if (so) {
+        d->m_backend = so->interfaceInstance(interfaceName());
         connectToServiceObject(d->m_serviceObject);
         if (!d->m_isConnected) {
             qCritical() << this <<
@@ -361,6 +526,194 @@ void QIviAbstractFeature::setDiscoveryMode(QIviAbstractFeature::DiscoveryMode di
     emit discoveryModeChanged(discoveryMode);
 }
 
+/*!
+    \qmlproperty bool AbstractFeature::asynchronousDiscovery
+    \brief Holds whether the backend plugins are loaded asynchronously during the autoDiscovery
+
+    If set to \c true, startAutoDiscovery() returns immediately and the backend plugin libraries are
+    loaded on a worker thread. Once they are loaded, the plugins are instantiated in the thread of
+    the service manager, the feature connects to the ServiceObject and the discoveryResult and
+    isValid properties are updated. Features which request the same interface at the same time
+    share the plugin loading.
+
+    The default value is \c false.
+*/
+
+/*!
+    \property QIviAbstractFeature::asynchronousDiscovery
+    \brief Holds whether the backend plugins are loaded asynchronously during the autoDiscovery
+
+    If set to \c true, startAutoDiscovery() returns QIviAbstractFeature::NoResult immediately and
+    the backend plugin libraries are loaded on a worker thread. Once they are loaded, the plugins
+    are instantiated in the thread of the QIviServiceManager, the feature connects to the
+    QIviServiceObject and emits discoveryResultChanged() and isValidChanged(). Features which
+    request the same interface at the same time share the plugin loading.
+
+    The default value is \c false.
+*/
+void QIviAbstractFeature::setAsynchronousDiscovery(bool asynchronousDiscovery)
+{
+    Q_D(QIviAbstractFeature);
+    if (d->m_asynchronousDiscovery == asynchronousDiscovery)
+        return;
+
+    d->m_asynchronousDiscovery = asynchronousDiscovery;
+    emit asynchronousDiscoveryChanged(asynchronousDiscovery);
+}
+
+/*!
+    \qmlproperty enumeration AbstractFeature::updatePolicy
+    \brief Holds how the property updates sent by the backend are applied
+
+    Backends can send property updates at a much higher rate than the user interface is able to
+    show them, e.g. the position of a media player or values measured by a sensor. Every update
+    causes all the bindings depending on the property to be evaluated again. The update policy
+    allows to collapse such bursts of updates into the latest value before the change signal is
+    emitted.
+
+    Available values are:
+    \value ImmediateUpdates
+           Every property update of the backend is applied right away.
+    \value CoalescedUpdates
+           All updates of a property within one iteration of the event loop are collapsed into the
+           latest value.
+    \value RateLimitedUpdates
+           A property is updated at most \l updateRate times per second. The first update is applied
+           right away, the following updates within the interval are collapsed into the latest value.
+    \value DeadbandUpdates
+           Updates of numeric properties are only applied if they differ from the last applied value
+           by at least \l updateDeadband.
+
+    The policy is used for all properties of the feature, setPropertyUpdatePolicy() can be used to
+    configure a different policy for a single property. The values sent by the backend before the
+    feature is initialized are always applied right away. For zoned features the policy of the
+    feature connected to the backend is used for all of its zones.
+
+    The default value is \c ImmediateUpdates.
+
+    \sa updateRate, updateDeadband
+*/
+
+/*!
+    \property QIviAbstractFeature::updatePolicy
+    \brief Holds how the property updates sent by the backend are applied
+
+    The policy allows to collapse bursts of property updates sent by the backend into the latest
+    value before the change signal is emitted. It is used for all properties of the feature,
+    setPropertyUpdatePolicy() can be used to configure a different policy for a single property.
+
+    The values sent by the backend before the feature is initialized are always applied right away.
+    For zoned features the policy of the feature connected to the backend is used for all of its
+    zones.
+
+    The default value is QIviAbstractFeature::ImmediateUpdates.
+
+    \sa updateRate, updateDeadband
+*/
+void QIviAbstractFeature::setUpdatePolicy(QIviAbstractFeature::UpdatePolicy updatePolicy)
+{
+    Q_D(QIviAbstractFeature);
+    if (d->m_updatePolicy == updatePolicy)
+        return;
+
+    d->m_updatePolicy = updatePolicy;
+    d->updatePolicyChanged();
+    emit updatePolicyChanged(updatePolicy);
+}
+
+/*!
+    \qmlproperty real AbstractFeature::updateRate
+    \brief Holds the maximum number of updates per second and property
+
+    This value is used if the updatePolicy is set to \c RateLimitedUpdates. A value of \c 0 or
+    less disables the rate limiting.
+
+    The default value is \c 60.
+*/
+
+/*!
+    \property QIviAbstractFeature::updateRate
+    \brief Holds the maximum number of updates per second and property
+
+    This value is used if the updatePolicy is set to QIviAbstractFeature::RateLimitedUpdates. A
+    value of \c 0 or less disables the rate limiting.
+
+    The default value is \c 60.
+*/
+void QIviAbstractFeature::setUpdateRate(qreal updateRate)
+{
+    Q_D(QIviAbstractFeature);
+    if (qFuzzyCompare(d->m_updateRate, updateRate))
+        return;
+
+    d->m_updateRate = updateRate;
+    d->updatePolicyChanged();
+    emit updateRateChanged(updateRate);
+}
+
+/*!
+    \qmlproperty real AbstractFeature::updateDeadband
+    \brief Holds the minimum difference to the last value a numeric property needs to be updated
+
+    This value is used if the updatePolicy is set to \c DeadbandUpdates.
+
+    The default value is \c 0.
+*/
+
+/*!
+    \property QIviAbstractFeature::updateDeadband
+    \brief Holds the minimum difference to the last value a numeric property needs to be updated
+
+    This value is used if the updatePolicy is set to QIviAbstractFeature::DeadbandUpdates.
+
+    The default value is \c 0.
+*/
+void QIviAbstractFeature::setUpdateDeadband(qreal updateDeadband)
+{
+    Q_D(QIviAbstractFeature);
+    if (qFuzzyCompare(d->m_updateDeadband, updateDeadband))
+        return;
+
+    d->m_updateDeadband = updateDeadband;
+    d->updatePolicyChanged();
+    emit updateDeadbandChanged(updateDeadband);
+}
+
+/*!
+    \qmlmethod AbstractFeature::setPropertyUpdatePolicy(string propertyName, enumeration policy, real parameter)
+
+    Sets the update \a policy for the property \a propertyName, overriding the updatePolicy of
+    the feature for this property. The \a parameter is the maximum rate in Hz for
+    \c RateLimitedUpdates and the deadband for \c DeadbandUpdates.
+
+    \sa updatePolicy
+*/
+
+/*!
+    Sets the update \a policy for the property \a propertyName, overriding the updatePolicy of
+    the feature for this property. The \a parameter is the maximum rate in Hz for
+    QIviAbstractFeature::RateLimitedUpdates and the deadband for
+    QIviAbstractFeature::DeadbandUpdates.
+
+    The policy is only used for properties which are forwarded from the backend by the feature
+    implementation, e.g. all the properties of the features created by the ivigenerator.
+
+    \sa updatePolicy
+*/
+void QIviAbstractFeature::setPropertyUpdatePolicy(const QString &propertyName, QIviAbstractFeature::UpdatePolicy policy, qreal parameter)
+{
+    Q_D(QIviAbstractFeature);
+    const int propertyIndex = metaObject()->indexOfProperty(propertyName.toUtf8().constData());
+    if (propertyIndex < 0) {
+        qtivi_qmlOrCppWarning(this, QStringLiteral("The property %1 doesn't exist").arg(propertyName));
+        return;
+    }
+
+    if (!d->m_updateThrottle)
+        d->m_updateThrottle.reset(new QIviUpdateThrottle(d));
+    d->m_updateThrottle->setPropertyPolicy(propertyIndex, policy, parameter);
+}
+
 /*!
     \internal
     \overload
@@ -433,6 +786,30 @@ QIviAbstractFeature::DiscoveryResult QIviAbstractFeature::discoveryResult() cons
     return d->m_discoveryResult;
 }
 
+bool QIviAbstractFeature::asynchronousDiscovery() const
+{
+    Q_D(const QIviAbstractFeature);
+    return d->m_asynchronousDiscovery;
+}
+
+QIviAbstractFeature::UpdatePolicy QIviAbstractFeature::updatePolicy() const
+{
+    Q_D(const QIviAbstractFeature);
+    return d->m_updatePolicy;
+}
+
+qreal QIviAbstractFeature::updateRate() const
+{
+    Q_D(const QIviAbstractFeature);
+    return d->m_updateRate;
+}
+
+qreal QIviAbstractFeature::updateDeadband() const
+{
+    Q_D(const QIviAbstractFeature);
+    return d->m_updateDeadband;
+}
+
 /*!
     Sets \a error with the \a message.
 
@@ -508,6 +885,9 @@ QString QIviAbstractFeature::errorText() const
     If the discoveryMode is set to QIviAbstractFeature::NoAutoDiscovery this function will
     do nothing and return QIviAbstractFeature::NoResult.
 
+    If asynchronousDiscovery is set, this function returns \c NoResult immediately and the result
+    is reported by the discoveryResult property once the backend plugins are loaded.
+
     Return values are:
     \value NoResult
            Indicates that no auto discovery was started because the feature has already assigned a valid ServiceObject.
@@ -534,7 +914,11 @@ QString QIviAbstractFeature::errorText() const
     If the discoveryMode is set to QIviAbstractFeature::NoAutoDiscovery this function will
     do nothing and return QIviAbstractFeature::NoResult.
 
-    \sa discoveryMode() {Dynamic Backend System}
+    If asynchronousDiscovery is set, this function returns QIviAbstractFeature::NoResult
+    immediately and the result is reported by discoveryResultChanged() once the backend plugins
+    are loaded.
+
+    \sa discoveryMode() asynchronousDiscovery {Dynamic Backend System}
 */
 QIviAbstractFeature::DiscoveryResult QIviAbstractFeature::startAutoDiscovery()
 {
@@ -546,57 +930,12 @@ QIviAbstractFeature::DiscoveryResult QIviAbstractFeature::startAutoDiscovery()
         return NoResult;
     }
 
-    QIviServiceManager *serviceManager = QIviServiceManager::instance();
-    QList<QIviServiceObject*> serviceObjects;
-    DiscoveryResult result = NoResult;
-    if (d->m_discoveryMode == AutoDiscovery || d->m_discoveryMode == LoadOnlyProductionBackends) {
-        serviceObjects = serviceManager->findServiceByInterface(d->m_interface, QIviServiceManager::IncludeProductionBackends);
-        result = ProductionBackendLoaded;
-    }
-
-    //Check whether we can use the found production backends
-    bool serviceObjectSet = false;
-    for (QIviServiceObject *object : qAsConst(serviceObjects)) {
-        qCDebug(qLcIviServiceManagement) << "Trying to use" << object << "Supported Interfaces:" << object->interfaces();
-        if (setServiceObject(object)) {
-            serviceObjectSet = true;
-            break;
-        }
-    }
-
-    //If no production backends are found or none of them accepted fall back to the simulation backends
-    if (!serviceObjectSet) {
-
-        if (Q_UNLIKELY(d->m_discoveryMode == AutoDiscovery || d->m_discoveryMode == LoadOnlyProductionBackends))
-            qWarning() << "There is no production backend implementing" << d->m_interface << ".";
-
-        if (d->m_discoveryMode == AutoDiscovery || d->m_discoveryMode == LoadOnlySimulationBackends) {
-            serviceObjects = serviceManager->findServiceByInterface(d->m_interface, QIviServiceManager::IncludeSimulationBackends);
-            result = SimulationBackendLoaded;
-            if (Q_UNLIKELY(serviceObjects.isEmpty()))
-                qWarning() << "There is no simulation backend implementing" << d->m_interface << ".";
-
-            for (QIviServiceObject* object : qAsConst(serviceObjects)) {
-                qCDebug(qLcIviServiceManagement) << "Trying to use" << object << "Supported Interfaces:" << object->interfaces();
-                if (setServiceObject(object)) {
-                    serviceObjectSet = true;
-                    break;
-                }
-            }
-        }
-    }
-
-    if (Q_UNLIKELY(serviceObjects.count() > 1))
-        qWarning() << "There is more than one backend implementing" << d->m_interface << ". Using the first one";
-
-    if (Q_UNLIKELY(!serviceObjectSet)) {
-        qWarning() << "No suitable ServiceObject found.";
-        d->setDiscoveryResult(ErrorWhileLoading);
-        return ErrorWhileLoading;
+    if (d->m_asynchronousDiscovery) {
+        d->startAsynchronousDiscovery();
+        return NoResult;
     }
 
-    d->setDiscoveryResult(result);
-    return result;
+    return d->discoverServiceObject();
 }
 
 QIviAbstractFeature::QIviAbstractFeature(QIviAbstractFeaturePrivate &dd, QObject *parent)
@@ -638,7 +977,10 @@ bool QIviAbstractFeature::acceptServiceObject(QIviServiceObject *serviceObject)
     \l acceptServiceObject method prior to being passed to this method.
 
     The default implementation connects to the signals offered by QIviFeatureInterface and calls
-    QIviFeatureInterface::initialize() afterwards.
+    QIviFeatureInterface::initialize() afterwards. If the backend has already been initialized for
+    another feature and provides a \c replayState() function, it is used instead to send the
+    current state to this instance only, see
+    \l {QIviFeatureInterface#Replaying the State}{Replaying the State}.
 
     When reimplementing please keep in mind to connect all signals before calling this function. e.g.
 
@@ -672,7 +1014,20 @@ void QIviAbstractFeature::connectToServiceObject(QIviServiceObject *serviceObjec
         connect(backend, &QIviFeatureInterface::errorChanged, this, &QIviAbstractFeature::onErrorChanged);
         QObjectPrivate::connect(backend, &QIviFeatureInterface::initializationDone,
                                 d, &QIviAbstractFeaturePrivate::onInitializationDone);
-        backend->initialize();
+        // Only the first feature initializes the backend, all others get the state sent directly.
+        // The replayed state is delivered queued, the initialization is done once it arrived.
+        // The function is looked up by name to keep QIviFeatureInterface binary compatible.
+        bool replayed = false;
+        const QMetaObject *mo = backend->metaObject();
+        const int replayIndex = mo->indexOfMethod("replayState(QIviAbstractFeature*)");
+        if (replayIndex != -1) {
+            mo->method(replayIndex).invoke(backend, Qt::DirectConnection, Q_RETURN_ARG(bool, replayed),
+                                           Q_ARG(QIviAbstractFeature*, this));
+        }
+        if (replayed)
+            QMetaObject::invokeMethod(this, [d]() { d->onInitializationDone(); }, Qt::QueuedConnection);
+        else
+            backend->initialize();
     }
 
     d->m_isConnected = true;
@@ -704,6 +1059,9 @@ void QIviAbstractFeature::disconnectFromServiceObject(QIviServiceObject *service
     if (backend)
         disconnect(backend, nullptr, this, nullptr);
 
+    if (d->m_updateThrottle)
+        d->m_updateThrottle->reset();
+
     d->m_isInitialized = false;
     emit isInitializedChanged(false);
     d->m_isConnected = false;
@@ -779,6 +1137,9 @@ void QIviAbstractFeature::serviceObjectDestroyed()
 {
     Q_D(QIviAbstractFeature);
     d->m_serviceObject = nullptr;
+    d->m_backend = nullptr;
+    if (d->m_updateThrottle)
+        d->m_updateThrottle->reset();
     clearServiceObject();
     emit serviceObjectChanged();
 }
@@ -60,10 +60,14 @@ class Q_QTIVICORE_EXPORT QIviAbstractFeature : public QObject, public QQmlParser
 
     Q_PROPERTY(QIviAbstractFeature::DiscoveryMode discoveryMode READ discoveryMode WRITE setDiscoveryMode NOTIFY discoveryModeChanged)
     Q_PROPERTY(QIviAbstractFeature::DiscoveryResult discoveryResult READ discoveryResult NOTIFY discoveryResultChanged)
+    Q_PROPERTY(bool asynchronousDiscovery READ asynchronousDiscovery WRITE setAsynchronousDiscovery NOTIFY asynchronousDiscoveryChanged)
     Q_PROPERTY(QIviServiceObject *serviceObject READ serviceObject WRITE setServiceObject NOTIFY serviceObjectChanged)
     Q_PROPERTY(bool isValid READ isValid NOTIFY isValidChanged)
     Q_PROPERTY(bool isInitialized READ isInitialized NOTIFY isInitializedChanged)
     Q_PROPERTY(QString error READ errorMessage NOTIFY errorChanged)
+    Q_PROPERTY(QIviAbstractFeature::UpdatePolicy updatePolicy READ updatePolicy WRITE setUpdatePolicy NOTIFY updatePolicyChanged)
+    Q_PROPERTY(qreal updateRate READ updateRate WRITE setUpdateRate NOTIFY updateRateChanged)
+    Q_PROPERTY(qreal updateDeadband READ updateDeadband WRITE setUpdateDeadband NOTIFY updateDeadbandChanged)
 
 public:
 
@@ -93,28 +97,50 @@ public:
     };
     Q_ENUM(DiscoveryResult)
 
+    enum UpdatePolicy {
+        ImmediateUpdates,
+        CoalescedUpdates,
+        RateLimitedUpdates,
+        DeadbandUpdates
+    };
+    Q_ENUM(UpdatePolicy)
+
     explicit QIviAbstractFeature(const QString &interface, QObject *parent = nullptr);
 
     QIviServiceObject *serviceObject() const;
     QIviAbstractFeature::DiscoveryMode discoveryMode() const;
     QIviAbstractFeature::DiscoveryResult discoveryResult() const;
+    bool asynchronousDiscovery() const;
     bool isValid() const;
     bool isInitialized() const;
     QIviAbstractFeature::Error error() const;
     QString errorMessage() const;
+    QIviAbstractFeature::UpdatePolicy updatePolicy() const;
+    qreal updateRate() const;
+    qreal updateDeadband() const;
+
+    Q_INVOKABLE void setPropertyUpdatePolicy(const QString &propertyName, QIviAbstractFeature::UpdatePolicy policy, qreal parameter = 0);
 
 public Q_SLOTS:
     bool setServiceObject(QIviServiceObject *so);
     void setDiscoveryMode(QIviAbstractFeature::DiscoveryMode discoveryMode);
+    void setAsynchronousDiscovery(bool asynchronousDiscovery);
     QIviAbstractFeature::DiscoveryResult startAutoDiscovery();
+    void setUpdatePolicy(QIviAbstractFeature::UpdatePolicy updatePolicy);
+    void setUpdateRate(qreal updateRate);
+    void setUpdateDeadband(qreal updateDeadband);
 
 Q_SIGNALS:
     void serviceObjectChanged();
     void discoveryModeChanged(QIviAbstractFeature::DiscoveryMode discoveryMode);
     void discoveryResultChanged(QIviAbstractFeature::DiscoveryResult discoveryResult);
+    void asynchronousDiscoveryChanged(bool asynchronousDiscovery);
     void isValidChanged(bool arg);
     void isInitializedChanged(bool isInitialized);
     void errorChanged(QIviAbstractFeature::Error error, const QString &message);
+    void updatePolicyChanged(QIviAbstractFeature::UpdatePolicy updatePolicy);
+    void updateRateChanged(qreal updateRate);
+    void updateDeadbandChanged(qreal updateDeadband);
 
 protected:
     QIviAbstractFeature(QIviAbstractFeaturePrivate &dd, QObject *parent = nullptr);
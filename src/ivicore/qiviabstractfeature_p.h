@@ -59,7 +59,11 @@
 
 #include "qiviabstractfeature.h"
 #include "qivifeatureinterface.h"
+#include "qiviservicemanager.h"
 #include "qiviserviceobject.h"
+#include "qiviupdatethrottle_p.h"
+
+#include <QtCore/QScopedPointer>
 
 QT_BEGIN_NAMESPACE
 
@@ -83,11 +87,14 @@ public:
     static QIviAbstractFeaturePrivate *get(QIviAbstractFeature *q);
 
     virtual void initialize();
-    virtual bool notify(const QByteArray &propertyName, const QVariant &value);
+    virtual bool notify(int propertyIndex, const QVariant &value);
+    virtual void applyUpdate(int propertyIndex, const QVariant &value);
 
     QIviFeatureInterface *backend() const;
     template <class T> T backend() const
     {
+        if (m_backend)
+            return qivi_interface_cast<T>(m_backend);
         Q_Q(const QIviAbstractFeature);
         if (m_serviceObject)
             return m_serviceObject->interfaceInstance<T>(q->interfaceName());
@@ -95,7 +102,11 @@ public:
     }
 
     void setDiscoveryResult(QIviAbstractFeature::DiscoveryResult discoveryResult);
+    QIviAbstractFeature::DiscoveryResult discoverServiceObject();
+    void startAsynchronousDiscovery();
+    void loadBackendsAsync(QIviServiceManager::SearchFlags searchFlags);
     void onInitializationDone();
+    void updatePolicyChanged();
 
     QIviAbstractFeature * const q_ptr;
     Q_DECLARE_PUBLIC(QIviAbstractFeature)
@@ -103,6 +114,7 @@ public:
 
     QString m_interface;
     QIviServiceObject *m_serviceObject;
+    QIviFeatureInterface *m_backend;
     QIviAbstractFeature::DiscoveryMode m_discoveryMode;
     QIviAbstractFeature::DiscoveryResult m_discoveryResult;
     QString m_errorMessage;
@@ -110,9 +122,16 @@ public:
     bool m_qmlCreation;
     bool m_isInitialized;
     bool m_isConnected;
+    bool m_asynchronousDiscovery;
+    bool m_discoveryPending;
 
     bool m_supportsPropertyOverriding;
     QIviPropertyOverrider *m_propertyOverride;
+
+    QIviAbstractFeature::UpdatePolicy m_updatePolicy;
+    qreal m_updateRate;
+    qreal m_updateDeadband;
+    QScopedPointer<QIviUpdateThrottle> m_updateThrottle;
 };
 
 QT_END_NAMESPACE
@@ -182,6 +182,7 @@ QIviAbstractFeatureListModel::QIviAbstractFeatureListModel(const QString &interf
     connect(d->m_feature, &QIviAbstractFeature::serviceObjectChanged, this, &QIviAbstractFeatureListModel::serviceObjectChanged);
     connect(d->m_feature, &QIviAbstractFeature::discoveryModeChanged, this, &QIviAbstractFeatureListModel::discoveryModeChanged);
     connect(d->m_feature, &QIviAbstractFeature::discoveryResultChanged, this, &QIviAbstractFeatureListModel::discoveryResultChanged);
+    connect(d->m_feature, &QIviAbstractFeature::asynchronousDiscoveryChanged, this, &QIviAbstractFeatureListModel::asynchronousDiscoveryChanged);
     connect(d->m_feature, &QIviAbstractFeature::isValidChanged, this, &QIviAbstractFeatureListModel::isValidChanged);
     connect(d->m_feature, &QIviAbstractFeature::isInitializedChanged, this, &QIviAbstractFeatureListModel::isInitializedChanged);
     connect(d->m_feature, &QIviAbstractFeature::errorChanged, this, &QIviAbstractFeatureListModel::errorChanged);
@@ -251,6 +252,25 @@ QIviAbstractFeature::DiscoveryMode QIviAbstractFeatureListModel::discoveryMode()
     return d->m_feature->discoveryMode();
 }
 
+/*!
+    \qmlproperty bool AbstractFeatureListModel::asynchronousDiscovery
+    \brief Holds whether the backend plugins are loaded asynchronously during the autoDiscovery
+
+    See AbstractFeature::asynchronousDiscovery for more information.
+*/
+
+/*!
+    \property QIviAbstractFeatureListModel::asynchronousDiscovery
+    \brief Holds whether the backend plugins are loaded asynchronously during the autoDiscovery
+
+    See QIviAbstractFeature::asynchronousDiscovery for more information.
+*/
+bool QIviAbstractFeatureListModel::asynchronousDiscovery() const
+{
+    Q_D(const QIviAbstractFeatureListModel);
+    return d->m_feature->asynchronousDiscovery();
+}
+
 /*!
     \qmlproperty enumeration AbstractFeatureListModel::discoveryResult
     \brief The result of the last autoDiscovery attempt
@@ -373,6 +393,12 @@ void QIviAbstractFeatureListModel::setDiscoveryMode(QIviAbstractFeature::Discove
     d->m_feature->setDiscoveryMode(discoveryMode);
 }
 
+void QIviAbstractFeatureListModel::setAsynchronousDiscovery(bool asynchronousDiscovery)
+{
+    Q_D(QIviAbstractFeatureListModel);
+    d->m_feature->setAsynchronousDiscovery(asynchronousDiscovery);
+}
+
 /*!
     \qmlmethod enumeration AbstractFeatureListModel::startAutoDiscovery()
 
@@ -401,6 +427,7 @@ QIviAbstractFeatureListModel::QIviAbstractFeatureListModel(QIviAbstractFeatureLi
     connect(d->m_feature, &QIviAbstractFeature::serviceObjectChanged, this, &QIviAbstractFeatureListModel::serviceObjectChanged);
     connect(d->m_feature, &QIviAbstractFeature::discoveryModeChanged, this, &QIviAbstractFeatureListModel::discoveryModeChanged);
     connect(d->m_feature, &QIviAbstractFeature::discoveryResultChanged, this, &QIviAbstractFeatureListModel::discoveryResultChanged);
+    connect(d->m_feature, &QIviAbstractFeature::asynchronousDiscoveryChanged, this, &QIviAbstractFeatureListModel::asynchronousDiscoveryChanged);
     connect(d->m_feature, &QIviAbstractFeature::isValidChanged, this, &QIviAbstractFeatureListModel::isValidChanged);
     connect(d->m_feature, &QIviAbstractFeature::isInitializedChanged, this, &QIviAbstractFeatureListModel::isInitializedChanged);
     connect(d->m_feature, &QIviAbstractFeature::errorChanged, this, &QIviAbstractFeatureListModel::errorChanged);
@@ -57,6 +57,7 @@ class Q_QTIVICORE_EXPORT QIviAbstractFeatureListModel : public QAbstractListMode
 
     Q_PROPERTY(QIviAbstractFeature::DiscoveryMode discoveryMode READ discoveryMode WRITE setDiscoveryMode NOTIFY discoveryModeChanged)
     Q_PROPERTY(QIviAbstractFeature::DiscoveryResult discoveryResult READ discoveryResult NOTIFY discoveryResultChanged)
+    Q_PROPERTY(bool asynchronousDiscovery READ asynchronousDiscovery WRITE setAsynchronousDiscovery NOTIFY asynchronousDiscoveryChanged)
     Q_PROPERTY(QIviServiceObject *serviceObject READ serviceObject WRITE setServiceObject NOTIFY serviceObjectChanged)
     Q_PROPERTY(bool isValid READ isValid NOTIFY isValidChanged)
     Q_PROPERTY(bool isInitialized READ isInitialized NOTIFY isInitializedChanged)
@@ -69,6 +70,7 @@ public:
     QIviServiceObject *serviceObject() const;
     QIviAbstractFeature::DiscoveryMode discoveryMode() const;
     QIviAbstractFeature::DiscoveryResult discoveryResult() const;
+    bool asynchronousDiscovery() const;
     bool isValid() const;
     bool isInitialized() const;
     QIviAbstractFeature::Error error() const;
@@ -77,12 +79,14 @@ public:
 public Q_SLOTS:
     bool setServiceObject(QIviServiceObject *so);
     void setDiscoveryMode(QIviAbstractFeature::DiscoveryMode discoveryMode);
+    void setAsynchronousDiscovery(bool asynchronousDiscovery);
     QIviAbstractFeature::DiscoveryResult startAutoDiscovery();
 
 Q_SIGNALS:
     void serviceObjectChanged();
     void discoveryModeChanged(QIviAbstractFeature::DiscoveryMode discoveryMode);
     void discoveryResultChanged(QIviAbstractFeature::DiscoveryResult discoveryResult);
+    void asynchronousDiscoveryChanged(bool asynchronousDiscovery);
     void isValidChanged(bool arg);
     void isInitializedChanged(bool isInitialized);
     void errorChanged(QIviAbstractFeature::Error error, const QString &message);
@@ -125,6 +125,7 @@ void QIviAbstractZonedFeature::clearServiceObject()
     Q_D(QIviAbstractZonedFeature);
     qDeleteAll(d->m_zoneFeatures);
     d->m_zoneFeatures.clear();
+    d->m_zoneIndexes.clear();
     d->m_zoneFeatureList.clear();
     d->m_zoneFeatureMap.clear();
 }
@@ -137,6 +138,11 @@ void QIviAbstractZonedFeature::clearServiceObject()
 */
 QIviZonedFeatureInterface *QIviAbstractZonedFeature::backend(const QString &interface) const
 {
+    Q_D(const QIviAbstractZonedFeature);
+    // Zone features share the cached backend of their parent, see initializeZones()
+    if (d->m_backend && (interface.isEmpty() || interface == interfaceName()))
+        return qobject_cast<QIviZonedFeatureInterface*>(d->m_backend);
+
     QString iface = interface;
     if (iface.isEmpty())
         iface = interfaceName();
@@ -228,7 +234,7 @@ void QIviAbstractZonedFeature::initializeZones()
             else
                 f = createZoneFeature(zone);
             if (f) {
-                f->d_func()->m_serviceObject = d->m_serviceObject;
+                d->m_zoneIndexes.insert(f->zone(), d->m_zoneFeatures.count());
                 d->m_zoneFeatures.append(f);
                 d->m_zoneFeatureList.append(QVariant::fromValue(f));
                 d->m_zoneFeatureMap.insert(f->zone(), QVariant::fromValue(f));
@@ -236,6 +242,10 @@ void QIviAbstractZonedFeature::initializeZones()
                 emit zonesChanged();
             }
         }
+        if (f) {
+            f->d_func()->m_serviceObject = d->m_serviceObject;
+            f->d_func()->m_backend = d->m_backend;
+        }
     }
 }
 
@@ -260,14 +270,15 @@ QStringList QIviAbstractZonedFeature::availableZones() const
 
 /*!
     Returns the given \a zone instance of the feature.
+
+    The lookup doesn't depend on the number of zones, which makes it suitable to dispatch
+    updates from the backend.
 */
 QIviAbstractZonedFeature *QIviAbstractZonedFeature::zoneAt(const QString &zone) const
 {
     Q_D(const QIviAbstractZonedFeature);
-    for (QIviAbstractZonedFeature *f : d->m_zoneFeatures)
-        if (f->zone() == zone)
-            return f;
-    return nullptr;
+    const int index = d->m_zoneIndexes.value(zone, -1);
+    return index < 0 ? nullptr : d->m_zoneFeatures.at(index);
 }
 
 /*!
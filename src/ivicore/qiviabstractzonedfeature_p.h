@@ -58,6 +58,8 @@
 #include "qiviabstractzonedfeature.h"
 #include <private/qtiviglobal_p.h>
 
+#include <QtCore/QHash>
+
 QT_BEGIN_NAMESPACE
 
 class Q_QTIVICORE_EXPORT QIviAbstractZonedFeaturePrivate : public QIviAbstractFeaturePrivate
@@ -67,6 +69,7 @@ public:
 
     QString m_zone;
     QList<QIviAbstractZonedFeature*> m_zoneFeatures;
+    QHash<QString, int> m_zoneIndexes;
     QVariantMap m_zoneFeatureMap;
     QVariantList m_zoneFeatureList;
 };
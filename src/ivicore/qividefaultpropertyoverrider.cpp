@@ -177,7 +177,7 @@ bool QIviDefaultPropertyOverrider::PropertyOverride::setOverridenValue(const QVa
 bool QIviDefaultPropertyOverrider::PropertyOverride::notifyOverridenValue(const QVariant &value, QIviAbstractFeature *carrier)
 {
     QIviAbstractFeaturePrivate *d = QIviAbstractFeaturePrivate::get(carrier);
-    if (d && d->notify(m_metaProperty.name(), value))
+    if (d && d->notify(m_metaProperty.propertyIndex(), value))
         return false;
 
     QMetaMethod notifySignal = m_metaProperty.notifySignal();
@@ -208,6 +208,7 @@ bool QIviDefaultPropertyOverrider::PropertyOverride::operator==(const QByteArray
 QIviDefaultPropertyOverrider::QIviDefaultPropertyOverrider(QIviAbstractFeature *carrier, QObject *parent)
     : QObject(parent)
     , m_serviceObject(nullptr)
+    , m_propertyOffset(0)
 {
     if (carrier) {
         m_serviceObject = carrier->serviceObject();
@@ -230,6 +231,7 @@ void QIviDefaultPropertyOverrider::init(QIviAbstractFeature *carrier)
     const QMetaObject *mo = carrier->metaObject();
     const int propertyOffset = QIviAbstractFeature::staticMetaObject.propertyCount();
     const int propertyCount = mo->propertyCount() - propertyOffset;
+    m_propertyOffset = propertyOffset;
 
     QIviAbstractFeaturePrivate *carrierPrivate = QIviAbstractFeaturePrivate::get(carrier);
     const bool canOveride = carrierPrivate && carrierPrivate->m_supportsPropertyOverriding;
@@ -508,21 +510,16 @@ int QIviDefaultPropertyOverrider::propertyCount() const
 
 const QIviDefaultPropertyOverrider::PropertyOverride &QIviDefaultPropertyOverrider::propertyForIndex(int index) const
 {
-    static QIviDefaultPropertyOverrider::PropertyOverride dummy;
-    for (const auto &p: m_properties) {
-        if (p.propertyIndex() == index)
-            return p;
-    }
-    return dummy;
+    return const_cast<QIviDefaultPropertyOverrider *>(this)->propertyForIndex(index);
 }
 
 QIviDefaultPropertyOverrider::PropertyOverride &QIviDefaultPropertyOverrider::propertyForIndex(int index)
 {
     static QIviDefaultPropertyOverrider::PropertyOverride dummy;
-    for (auto &p: m_properties) {
-        if (p.propertyIndex() == index)
-            return p;
-    }
+    // The properties are stored in the order of the meta object, see init()
+    const size_t i = size_t(index - m_propertyOffset);
+    if (index >= m_propertyOffset && i < m_properties.size() && m_properties[i].propertyIndex() == index)
+        return m_properties[i];
     return dummy;
 }
 
@@ -154,6 +154,7 @@ protected:
     QIviServiceObject *m_serviceObject;
     std::vector<QIviAbstractFeature *> m_carriers;
     std::vector<PropertyOverride> m_properties;
+    int m_propertyOffset;
 };
 
 QT_END_NAMESPACE
@@ -61,6 +61,26 @@ QT_BEGIN_NAMESPACE
     This base class contains the generic error handling, which is common between all interfaces.
 
     See the full example backend implementation from \c {src/plugins/ivivehiclefunctions/climate_simulator}.
+
+    \section1 Replaying the State
+
+    A backend is initialized by the first feature connecting to it. When an additional feature
+    connects to an already initialized backend, calling initialize() again would emit all change
+    signals again, which also reach all other features connected to this backend. A backend can
+    avoid this by providing an invokable function with the following signature:
+
+    \code
+    Q_INVOKABLE bool replayState(QIviAbstractFeature *subscriber);
+    \endcode
+
+    The function is looked up by name and called instead of initialize(). The implementation is
+    expected to send the current state to the \e subscriber only, e.g. by using the replay
+    functions provided by the generated backend interfaces. The state must be delivered queued,
+    as the \e subscriber is still connecting to the backend when the function is called. It
+    returns \c true if the state has been sent, the \e subscriber is initialized once its event
+    loop processed the queued state. It returns \c false if the backend hasn't been initialized
+    yet or doesn't know how to handle the \e subscriber; initialize() is called in this case.
+
     \sa QIviAbstractFeature, QIviServiceInterface
 */
 
@@ -83,7 +103,7 @@ QIviFeatureInterface::QIviFeatureInterface(QObjectPrivate &dd, QObject *parent)
 
     The last signal which needs to be sent is the initializationDone() signal.
 
-    \sa initializationDone()
+    \sa initializationDone(), {Replaying the State}
 */
 
 /*!
@@ -48,14 +48,33 @@
 
 #include <QDebug>
 #include <QMetaObject>
+#include <QTimer>
+#include <QtMath>
 
 QT_BEGIN_NAMESPACE
 
+namespace qtivi_helper {
+    // Time in ms a request is considered in flight at least, before it is assumed to be lost
+    static const int minimumRequestTimeout = 1000;
+}
+
+using namespace qtivi_helper;
+
 QIviPagingModelPrivate::QIviPagingModelPrivate(const QString &interface, QIviPagingModel *model)
     : QIviAbstractFeatureListModelPrivate(interface, model)
     , q_ptr(model)
     , m_capabilities(QtIviCoreModule::NoExtras)
     , m_chunkSize(30)
+    , m_maximumCachedChunks(0)
+    , m_prefetchAhead(0)
+    , m_prefetchBehind(0)
+    , m_prefetchScheduled(false)
+    , m_lastAccessedRow(-1)
+    , m_lastAccessedChunk(-1)
+    , m_lastChunkChangeTime(0)
+    , m_scrollDirection(1)
+    , m_scrollVelocity(0)
+    , m_fetchLatency(0)
     , m_moreAvailable(false)
     , m_identifier(QUuid::createUuid())
     , m_fetchMoreThreshold(10)
@@ -65,12 +84,20 @@ QIviPagingModelPrivate::QIviPagingModelPrivate(const QString &interface, QIviPag
     qRegisterMetaType<QIviPagingModel::LoadingType>();
     qRegisterMetaType<QIviStandardItem>();
     qRegisterMetaType<QIviStandardItem>("QIviSearchAndBrowseModelItem");
+    qRegisterMetaType<QIviStandardItemBatch>();
+
+    m_accessTimer.start();
 }
 
 QIviPagingModelPrivate::~QIviPagingModelPrivate()
 {
 }
 
+QIviPagingModelPrivate *QIviPagingModelPrivate::get(QIviPagingModel *model)
+{
+    return model->d_func();
+}
+
 void QIviPagingModelPrivate::initialize()
 {
     QIviAbstractFeatureListModelPrivate::initialize();
@@ -103,7 +130,42 @@ void QIviPagingModelPrivate::onCapabilitiesChanged(const QUuid &identifier, QtIv
 
 void QIviPagingModelPrivate::onDataFetched(const QUuid &identifier, const QList<QVariant> &items, int start, bool moreAvailable)
 {
-    if (!identifier.isNull() && (!items.count() || identifier != m_identifier))
+    if (!identifier.isNull() && identifier != m_identifier)
+        return;
+
+    QVector<QIviPagingModelRow> rows;
+    rows.reserve(items.count());
+    for (const QVariant &item : items)
+        rows.append(QIviPagingModelRow(item));
+
+    handleDataFetched(identifier, rows, start, moreAvailable);
+}
+
+void QIviPagingModelPrivate::onBatchFetched(const QUuid &identifier, const QIviStandardItemBatch &items, int start, bool moreAvailable)
+{
+    if (!identifier.isNull() && identifier != m_identifier)
+        return;
+
+    QVector<QIviPagingModelRow> rows;
+    rows.reserve(items.count());
+    for (int i = 0; i < items.count(); i++)
+        rows.append(QIviPagingModelRow(items, i));
+
+    handleDataFetched(identifier, rows, start, moreAvailable);
+}
+
+void QIviPagingModelPrivate::handleDataFetched(const QUuid &identifier, const QVector<QIviPagingModelRow> &items, int start, bool moreAvailable)
+{
+    const int chunkIndex = start / m_chunkSize;
+    auto it = m_pendingRequests.find(chunkIndex);
+    if (it != m_pendingRequests.end()) {
+        const qint64 latency = m_accessTimer.elapsed() - it.value();
+        m_fetchLatency = m_fetchLatency > 0 ? 0.8 * m_fetchLatency + 0.2 * latency : latency;
+        m_pendingRequests.erase(it);
+    }
+    m_prefetchInFlight.remove(chunkIndex);
+
+    if (!identifier.isNull() && !items.count())
         return;
 
     Q_ASSERT(items.count() <= m_chunkSize);
@@ -117,6 +179,9 @@ void QIviPagingModelPrivate::onDataFetched(const QUuid &identifier, const QList<
         m_itemList += items;
         m_fetchedDataCount = m_itemList.count();
         q->endInsertRows();
+
+        if (m_prefetchAhead > 0)
+            schedulePrefetch();
     } else {
         const int newSize = start + items.count();
         if (m_itemList.count() <  newSize || m_availableChunks.count() < newSize / m_chunkSize) {
@@ -129,7 +194,12 @@ void QIviPagingModelPrivate::onDataFetched(const QUuid &identifier, const QList<
         for (int i = 0; i < items.count(); i++)
             m_itemList.replace(start + i, items.at(i));
 
-        m_availableChunks.setBit(start / m_chunkSize);
+        m_availableChunks.setBit(chunkIndex);
+        markChunkResident(chunkIndex);
+        evictChunks();
+
+        if (m_prefetchAhead > 0 || m_prefetchBehind > 0)
+            schedulePrefetch();
 
         emit q->dataChanged(q->index(start), q->index(start + items.count() -1));
     }
@@ -143,7 +213,7 @@ void QIviPagingModelPrivate::onCountChanged(const QUuid &identifier, int new_len
     Q_Q(QIviPagingModel);
     q->beginInsertRows(QModelIndex(), m_itemList.count(), m_itemList.count() + new_length -1);
     for (int i = 0; i < new_length; i++)
-        m_itemList.append(QVariant());
+        m_itemList.append(QIviPagingModelRow());
     q->endInsertRows();
 
     m_availableChunks.resize(new_length / m_chunkSize + 1);
@@ -154,6 +224,29 @@ void QIviPagingModelPrivate::onDataChanged(const QUuid &identifier, const QList<
     if (!identifier.isNull() && identifier != m_identifier)
         return;
 
+    QVector<QIviPagingModelRow> rows;
+    rows.reserve(data.count());
+    for (const QVariant &item : data)
+        rows.append(QIviPagingModelRow(item));
+
+    handleDataChanged(rows, start, count);
+}
+
+void QIviPagingModelPrivate::onBatchChanged(const QUuid &identifier, const QIviStandardItemBatch &data, int start, int count)
+{
+    if (!identifier.isNull() && identifier != m_identifier)
+        return;
+
+    QVector<QIviPagingModelRow> rows;
+    rows.reserve(data.count());
+    for (int i = 0; i < data.count(); i++)
+        rows.append(QIviPagingModelRow(data, i));
+
+    handleDataChanged(rows, start, count);
+}
+
+void QIviPagingModelPrivate::handleDataChanged(const QVector<QIviPagingModelRow> &data, int start, int count)
+{
     if (start < 0 || start > m_itemList.count()) {
         qWarning("provided start argument is out of range");
         return;
@@ -176,6 +269,9 @@ void QIviPagingModelPrivate::onDataChanged(const QUuid &identifier, const QList<
     int insertRemoveStart = start + updateCountEnd;
     int insertRemoveCount = qMax(data.count(), count) - updateCount;
 
+    //The tokens handed out by the backend point to the rows as they were before
+    m_continuationTokens.clear();
+
     if (updateCount > 0) {
         for (int i = start, j=0; j < updateCount; i++, j++)
             m_itemList.replace(i, data.at(j));
@@ -186,11 +282,13 @@ void QIviPagingModelPrivate::onDataChanged(const QUuid &identifier, const QList<
         q->beginRemoveRows(QModelIndex(), insertRemoveStart, insertRemoveStart + insertRemoveCount -1);
         for (int i = insertRemoveStart; i < insertRemoveStart + insertRemoveCount; i++)
             m_itemList.removeAt(i);
+        rebaseChunks(insertRemoveStart, delta);
         q->endRemoveRows();
     } else if (delta > 0) { //Insert
         q->beginInsertRows(QModelIndex(), insertRemoveStart, insertRemoveStart + insertRemoveCount -1);
         for (int i = insertRemoveStart, j = updateCountEnd; i < insertRemoveStart + insertRemoveCount; i++, j++)
             m_itemList.insert(i, data.at(j));
+        rebaseChunks(insertRemoveStart, delta);
         q->endInsertRows();
     }
 }
@@ -201,13 +299,30 @@ void QIviPagingModelPrivate::onFetchMoreThresholdReached()
     q->fetchMore(QModelIndex());
 }
 
+void QIviPagingModelPrivate::onContinuationTokenAvailable(const QUuid &identifier, int start, const QByteArray &continuationToken)
+{
+    if (identifier != m_identifier)
+        return;
+
+    m_continuationTokens.insert(start, continuationToken);
+}
+
 void QIviPagingModelPrivate::resetModel()
 {
     Q_Q(QIviPagingModel);
 
     q->beginResetModel();
     m_itemList.clear();
+    m_continuationTokens.clear();
     m_availableChunks.clear();
+    clearResidentChunks();
+    m_prefetchQueue.clear();
+    m_pendingRequests.clear();
+    m_prefetchInFlight.clear();
+    m_lastAccessedRow = -1;
+    m_lastAccessedChunk = -1;
+    m_scrollDirection = 1;
+    m_scrollVelocity = 0;
     m_fetchedDataCount = 0;
     //Setting this to true to let fetchMore do one first fetchcall.
     m_moreAvailable = true;
@@ -226,7 +341,291 @@ void QIviPagingModelPrivate::fetchData(int startIndex)
     const int chunkIndex = start / m_chunkSize;
     if (chunkIndex < m_availableChunks.size())
         m_availableChunks.setBit(chunkIndex);
-    backend()->fetchData(m_identifier, start, m_chunkSize);
+    m_pendingRequests.insert(chunkIndex, m_accessTimer.elapsed());
+    //Only request the rest of the chunk if the model doesn't end at a chunk boundary
+    requestData(start, m_chunkSize - start % m_chunkSize);
+}
+
+/*
+    Requests \a count rows starting at \a start from the backend. If the backend handed out a
+    continuation token for \a start, i.e. the rows are read sequentially, the token is used to
+    let the backend continue where the previous chunk ended instead of skipping \a start rows.
+*/
+void QIviPagingModelPrivate::requestData(int start, int count)
+{
+    QIviPagingModelInterface *pagingBackend = backend();
+    const QByteArray continuationToken = m_continuationTokens.value(start);
+    if (!continuationToken.isEmpty() && m_capabilities.testFlag(QtIviCoreModule::SupportsContinuationTokens)) {
+        //The function is looked up by name to keep QIviPagingModelInterface binary compatible
+        const QMetaObject *mo = pagingBackend->metaObject();
+        const int fetchDataAfterIndex = mo->indexOfMethod("fetchDataAfter(QUuid,QByteArray,int,int)");
+        if (fetchDataAfterIndex != -1) {
+            mo->method(fetchDataAfterIndex).invoke(pagingBackend, Qt::DirectConnection,
+                                                   Q_ARG(QUuid, m_identifier), Q_ARG(QByteArray, continuationToken),
+                                                   Q_ARG(int, start), Q_ARG(int, count));
+            return;
+        }
+    }
+    pagingBackend->fetchData(m_identifier, start, count);
+}
+
+void QIviPagingModelPrivate::markChunkResident(int chunkIndex)
+{
+    //Keep the most recently used chunk at the front, eviction starts at the back
+    auto it = m_residentChunkIndex.find(chunkIndex);
+    if (it != m_residentChunkIndex.end()) {
+        if (it.value() == m_residentChunks.begin())
+            return;
+        m_residentChunks.erase(it.value());
+    }
+    m_residentChunks.prepend(chunkIndex);
+    m_residentChunkIndex.insert(chunkIndex, m_residentChunks.begin());
+}
+
+void QIviPagingModelPrivate::touchChunk(int chunkIndex)
+{
+    //Rows which are not loaded from the backend in chunks, e.g. rows filtered locally, can't be evicted
+    if (m_residentChunkIndex.contains(chunkIndex))
+        markChunkResident(chunkIndex);
+}
+
+void QIviPagingModelPrivate::evictChunks()
+{
+    if (m_loadingType != QIviPagingModel::DataChanged || m_maximumCachedChunks <= 0)
+        return;
+
+    while (m_residentChunks.size() > m_maximumCachedChunks) {
+        const int lruChunk = m_residentChunks.takeLast();
+        m_residentChunkIndex.remove(lruChunk);
+
+        //Drop the items of the chunk. They will be fetched again once data() asks for them
+        const int start = lruChunk * m_chunkSize;
+        const int end = qMin(start + m_chunkSize, m_itemList.count());
+        for (int i = start; i < end; i++)
+            m_itemList[i] = QIviPagingModelRow();
+
+        m_availableChunks.clearBit(lruChunk);
+    }
+}
+
+/*
+    Updates the chunk bookkeeping after \a delta rows have been inserted (delta > 0) or removed
+    (delta < 0) at \a row.
+
+    All chunks from the chunk of \a row onwards hold different rows now. Only the chunks which are
+    still completely loaded stay resident, they take over the position in the LRU order of the
+    chunk their first row belonged to before. The chunks which are only partially loaded now are
+    dropped and fetched again once they are needed.
+*/
+void QIviPagingModelPrivate::rebaseChunks(int row, int delta)
+{
+    if (m_loadingType != QIviPagingModel::DataChanged)
+        return;
+
+    const int firstChunk = row / m_chunkSize;
+    const int chunkCount = m_itemList.count() / m_chunkSize + 1;
+    m_availableChunks.resize(chunkCount);
+
+    QMultiHash<int, int> movedChunks;
+    for (int chunk = firstChunk; chunk < chunkCount; chunk++) {
+        const int start = chunk * m_chunkSize;
+        const int end = qMin(start + m_chunkSize, m_itemList.count());
+
+        bool complete = start < end;
+        for (int i = start; complete && i < end; i++)
+            complete = m_itemList.at(i).isValid();
+
+        if (complete) {
+            //Find the chunk which held the first row of this chunk before
+            int oldRow = start;
+            if (start >= row)
+                oldRow = start < row + qMax(delta, 0) ? row : start - delta;
+            movedChunks.insert(oldRow / m_chunkSize, chunk);
+            m_availableChunks.setBit(chunk);
+            continue;
+        }
+
+        //A chunk which is requested already will be filled by the answer of the backend
+        m_availableChunks.setBit(chunk, m_pendingRequests.contains(chunk));
+        for (int i = start; i < end; i++)
+            m_itemList[i] = QIviPagingModelRow();
+    }
+
+    const QLinkedList<int> oldChunks = m_residentChunks;
+    clearResidentChunks();
+    for (int chunk : oldChunks) {
+        if (chunk < firstChunk) {
+            m_residentChunks.append(chunk);
+            m_residentChunkIndex.insert(chunk, --m_residentChunks.end());
+            continue;
+        }
+        const QList<int> newChunks = movedChunks.values(chunk);
+        for (int newChunk : newChunks) {
+            if (m_residentChunkIndex.contains(newChunk))
+                continue;
+            m_residentChunks.append(newChunk);
+            m_residentChunkIndex.insert(newChunk, --m_residentChunks.end());
+        }
+    }
+    //Chunks which consist of inserted rows only haven't been used so far
+    for (auto it = movedChunks.cbegin(); it != movedChunks.cend(); ++it) {
+        if (m_residentChunkIndex.contains(it.value()))
+            continue;
+        m_residentChunks.append(it.value());
+        m_residentChunkIndex.insert(it.value(), --m_residentChunks.end());
+    }
+
+    evictChunks();
+}
+
+void QIviPagingModelPrivate::clearResidentChunks()
+{
+    m_residentChunks.clear();
+    m_residentChunkIndex.clear();
+}
+
+void QIviPagingModelPrivate::updateAccessPattern(int row) const
+{
+    m_lastAccessedRow = row;
+    if (m_prefetchAhead <= 0 && m_prefetchBehind <= 0)
+        return;
+
+    const int chunkIndex = row / m_chunkSize;
+    if (chunkIndex == m_lastAccessedChunk)
+        return;
+
+    const qint64 now = m_accessTimer.elapsed();
+    if (m_lastAccessedChunk != -1) {
+        const int delta = chunkIndex - m_lastAccessedChunk;
+        const qint64 elapsed = qMax<qint64>(now - m_lastChunkChangeTime, 1);
+        m_scrollDirection = delta > 0 ? 1 : -1;
+        //Smooth the velocity (chunks per ms) to not overreact to a single jump
+        m_scrollVelocity = 0.5 * m_scrollVelocity + 0.5 * qAbs(delta) / qreal(elapsed);
+    }
+    m_lastAccessedChunk = chunkIndex;
+    m_lastChunkChangeTime = now;
+
+    schedulePrefetch();
+}
+
+int QIviPagingModelPrivate::prefetchDistance() const
+{
+    //When scrolling fast, look further ahead to hide the latency of the backend
+    int distance = m_prefetchAhead;
+    if (m_fetchLatency > 0 && m_scrollVelocity > 0)
+        distance = qMax(distance, qCeil(m_scrollVelocity * m_fetchLatency));
+    return qMin(distance, m_prefetchAhead * 4);
+}
+
+/*
+    Defers the prefetching to the event loop, as it is triggered from data() and needs to change
+    the model state.
+*/
+void QIviPagingModelPrivate::schedulePrefetch() const
+{
+    if (m_prefetchScheduled)
+        return;
+
+    m_prefetchScheduled = true;
+    QIviPagingModel *model = q_ptr;
+    QTimer::singleShot(0, model, [model]() {
+        QIviPagingModelPrivate::get(model)->dispatchPrefetch();
+    });
+}
+
+void QIviPagingModelPrivate::updatePrefetchQueue()
+{
+    //Rebuilding the queue drops all requests which are not sent yet and scrolled out of range
+    m_prefetchQueue.clear();
+    if (m_lastAccessedChunk == -1)
+        return;
+
+    auto enqueue = [this](int chunk) {
+        if (chunk < 0 || chunk >= m_availableChunks.size() || chunk * m_chunkSize >= m_itemList.count())
+            return;
+        if (!m_availableChunks.at(chunk))
+            m_prefetchQueue.append(chunk);
+    };
+
+    const int ahead = prefetchDistance();
+    for (int i = 1; i <= qMax(ahead, m_prefetchBehind); i++) {
+        if (i <= ahead)
+            enqueue(m_lastAccessedChunk + i * m_scrollDirection);
+        if (i <= m_prefetchBehind)
+            enqueue(m_lastAccessedChunk - i * m_scrollDirection);
+    }
+}
+
+void QIviPagingModelPrivate::dispatchPrefetch()
+{
+    Q_Q(QIviPagingModel);
+    m_prefetchScheduled = false;
+
+    if (!backend())
+        return;
+
+    if (m_loadingType == QIviPagingModel::FetchMore) {
+        const int threshold = qMax(m_fetchMoreThreshold, prefetchDistance() * m_chunkSize);
+        if (m_prefetchAhead > 0 && m_lastAccessedRow >= m_fetchedDataCount - threshold && q->canFetchMore(QModelIndex()))
+            emit q->fetchMoreThresholdReached();
+        return;
+    }
+
+    expirePendingRequests();
+    updatePrefetchQueue();
+
+    //At most one request per chunk of the prefetch window is outstanding, the others stay queued
+    //and can still be cancelled
+    const int maximumInFlight = qMax(1, prefetchDistance() + m_prefetchBehind);
+    bool requested = false;
+    while (!m_prefetchQueue.isEmpty() && m_prefetchInFlight.count() < maximumInFlight) {
+        const int chunk = m_prefetchQueue.takeFirst();
+        if (chunk >= m_availableChunks.size() || m_availableChunks.at(chunk))
+            continue;
+
+        m_prefetchInFlight.insert(chunk);
+        fetchData(chunk * m_chunkSize);
+        requested = true;
+    }
+
+    //Don't let requests which the backend never answers block the prefetching forever
+    if (requested && !m_prefetchInFlight.isEmpty()) {
+        QTimer::singleShot(requestTimeout(), q, [this]() {
+            const int inFlight = m_prefetchInFlight.count();
+            expirePendingRequests();
+            if (m_prefetchInFlight.count() < inFlight)
+                schedulePrefetch();
+        });
+    }
+}
+
+qint64 QIviPagingModelPrivate::requestTimeout() const
+{
+    return qMax<qint64>(minimumRequestTimeout, qCeil(m_fetchLatency * 4));
+}
+
+/*
+    Forgets the requests which the backend didn't answer within requestTimeout(), e.g. because
+    it dropped them. Their chunks are requested again once they are needed.
+*/
+void QIviPagingModelPrivate::expirePendingRequests()
+{
+    const qint64 now = m_accessTimer.elapsed();
+    const qint64 timeout = requestTimeout();
+    for (auto it = m_pendingRequests.begin(); it != m_pendingRequests.end();) {
+        if (now - it.value() < timeout) {
+            ++it;
+            continue;
+        }
+
+        const int chunk = it.key();
+        if (m_loadingType == QIviPagingModel::DataChanged && chunk < m_availableChunks.size()
+                && !m_residentChunkIndex.contains(chunk)) {
+            m_availableChunks.clearBit(chunk);
+        }
+        m_prefetchInFlight.remove(chunk);
+        it = m_pendingRequests.erase(it);
+    }
 }
 
 void QIviPagingModelPrivate::clearToDefaults()
@@ -235,19 +634,52 @@ void QIviPagingModelPrivate::clearToDefaults()
     m_moreAvailable = false;
     m_identifier = QUuid::createUuid();
     m_fetchMoreThreshold = 10;
+    m_maximumCachedChunks = 0;
+    m_prefetchAhead = 0;
+    m_prefetchBehind = 0;
+    m_fetchLatency = 0;
     m_fetchedDataCount = 0;
     m_loadingType = QIviPagingModel::FetchMore;
     m_capabilities = QtIviCoreModule::NoExtras;
     m_itemList.clear();
+    m_continuationTokens.clear();
+    m_availableChunks.clear();
+    clearResidentChunks();
+    m_prefetchQueue.clear();
+    m_pendingRequests.clear();
+    m_prefetchInFlight.clear();
+    m_lastAccessedRow = -1;
+    m_lastAccessedChunk = -1;
+    m_scrollDirection = 1;
+    m_scrollVelocity = 0;
 }
 
 const QIviStandardItem *QIviPagingModelPrivate::itemAt(int i) const
 {
-    const QVariant &var = m_itemList.at(i);
-    if (!var.isValid())
+    return itemOf(m_itemList.at(i));
+}
+
+const QIviStandardItem *QIviPagingModelPrivate::itemOf(const QIviPagingModelRow &row) const
+{
+    //The type of a batch is already checked once when it is created
+    if (row.isBatchItem())
+        return row.batch.itemAt(row.variant.toInt());
+
+    if (!row.variant.isValid())
         return nullptr;
 
-    return qtivi_gadgetFromVariant<QIviStandardItem>(q_ptr, var);
+    return qtivi_gadgetFromVariant<QIviStandardItem>(q_ptr, row.variant);
+}
+
+QVariant QIviPagingModelPrivate::variantAt(int i)
+{
+    //Box an item of a batch only once, all following reads just copy the QVariant
+    QIviPagingModelRow &row = m_itemList[i];
+    if (row.isBatchItem()) {
+        row.variant = row.batch.variantAt(row.variant.toInt());
+        row.batch = QIviStandardItemBatch();
+    }
+    return row.variant;
 }
 
 QIviPagingModelInterface *QIviPagingModelPrivate::backend() const
@@ -292,6 +724,11 @@ QIviPagingModelInterface *QIviPagingModelPrivate::backend() const
     and the actual data for a specific row is fetched the first time the data() function is called. Once the data is available,
     the dataChanged() signal will be triggered for this row and the view will start to render the new data.
 
+    If the backend supports QtIviCoreModule::SupportsContinuationTokens, a chunk which directly follows
+    the previously fetched one is requested with the continuation token the backend handed out for it,
+    see \l {QIviPagingModelInterface#Continuation Tokens}{Continuation Tokens}. This keeps reading
+    through a large result fast, while jumping to a different position still uses the index of the row.
+
     Please see the documentation of \l{QIviPagingModel::}{LoadingType} for more details on how the modes work and
     when they are suitable to use.
 
@@ -437,6 +874,9 @@ QIviPagingModel::QIviPagingModel(QObject *parent)
            The backend supports moving items within the model.
     \value SupportsRemove
            The backend supports removing items from the model.
+    \value SupportsContinuationTokens
+           The backend hands out a continuation token with every chunk of data and accepts it to fetch the following chunk.
+           \sa {QIviPagingModelInterface#Continuation Tokens}{Continuation Tokens}
 */
 
 /*!
@@ -528,6 +968,139 @@ void QIviPagingModel::setFetchMoreThreshold(int fetchMoreThreshold)
     emit fetchMoreThresholdChanged(fetchMoreThreshold);
 }
 
+/*!
+    \qmlproperty int PagingModel::maximumCachedChunks
+    \brief Holds the maximum number of chunks which are kept in memory.
+
+    This property can be used to limit the memory used by the model for very large lists.
+    Once more chunks than allowed have been fetched, the chunk which was accessed least recently
+    is dropped from memory and will be fetched again from the backend once it is needed.
+
+    The value should be bigger than the number of chunks which are visible at the same time.
+    The default value of \c 0 keeps all fetched chunks in memory.
+
+    \note This property is only used when loadingType is set to DataChanged.
+*/
+
+/*!
+    \property QIviPagingModel::maximumCachedChunks
+    \brief Holds the maximum number of chunks which are kept in memory.
+
+    This property can be used to limit the memory used by the model for very large lists.
+    Once more chunks than allowed have been fetched, the chunk which was accessed least recently
+    is dropped from memory and will be fetched again from the backend once it is needed.
+
+    The value should be bigger than the number of chunks which are visible at the same time.
+    The default value of \c 0 keeps all fetched chunks in memory.
+
+    \note This property is only used when loadingType is set to DataChanged.
+*/
+int QIviPagingModel::maximumCachedChunks() const
+{
+    Q_D(const QIviPagingModel);
+    return d->m_maximumCachedChunks;
+}
+
+void QIviPagingModel::setMaximumCachedChunks(int maximumCachedChunks)
+{
+    Q_D(QIviPagingModel);
+    if (d->m_maximumCachedChunks == maximumCachedChunks)
+        return;
+
+    d->m_maximumCachedChunks = maximumCachedChunks;
+    emit maximumCachedChunksChanged(maximumCachedChunks);
+
+    d->evictChunks();
+}
+
+/*!
+    \qmlproperty int PagingModel::prefetchAhead
+    \brief Holds the number of chunks which are fetched ahead of the currently viewed rows.
+
+    The model tracks the direction and the speed in which the rows are accessed and requests the
+    next chunks in that direction before the view needs them. When scrolling fast, up to four times
+    this number of chunks are fetched in advance, depending on how long the backend takes to answer.
+
+    Only one of these requests is sent to the backend at a time. Requests which are still queued
+    and scroll out of range are dropped before they reach the backend.
+
+    In the FetchMore loading type, this property extends the fetchMoreThreshold to the given number
+    of chunks.
+
+    The default value of \c 0 disables prefetching.
+*/
+
+/*!
+    \property QIviPagingModel::prefetchAhead
+    \brief Holds the number of chunks which are fetched ahead of the currently viewed rows.
+
+    The model tracks the direction and the speed in which the rows are accessed and requests the
+    next chunks in that direction before the view needs them. When scrolling fast, up to four times
+    this number of chunks are fetched in advance, depending on how long the backend takes to answer.
+
+    Only one of these requests is sent to the backend at a time. Requests which are still queued
+    and scroll out of range are dropped before they reach the backend.
+
+    In the FetchMore loading type, this property extends the fetchMoreThreshold to the given number
+    of chunks.
+
+    The default value of \c 0 disables prefetching.
+*/
+int QIviPagingModel::prefetchAhead() const
+{
+    Q_D(const QIviPagingModel);
+    return d->m_prefetchAhead;
+}
+
+void QIviPagingModel::setPrefetchAhead(int prefetchAhead)
+{
+    Q_D(QIviPagingModel);
+    if (d->m_prefetchAhead == prefetchAhead)
+        return;
+
+    d->m_prefetchAhead = prefetchAhead;
+    emit prefetchAheadChanged(prefetchAhead);
+}
+
+/*!
+    \qmlproperty int PagingModel::prefetchBehind
+    \brief Holds the number of chunks which are fetched behind the currently viewed rows.
+
+    This is the counterpart to prefetchAhead and makes sure the chunks in the opposite direction
+    of the scrolling are available as well.
+
+    The default value of \c 0 disables prefetching behind the current rows.
+
+    \note This property is only used when loadingType is set to DataChanged.
+*/
+
+/*!
+    \property QIviPagingModel::prefetchBehind
+    \brief Holds the number of chunks which are fetched behind the currently viewed rows.
+
+    This is the counterpart to prefetchAhead and makes sure the chunks in the opposite direction
+    of the scrolling are available as well.
+
+    The default value of \c 0 disables prefetching behind the current rows.
+
+    \note This property is only used when loadingType is set to DataChanged.
+*/
+int QIviPagingModel::prefetchBehind() const
+{
+    Q_D(const QIviPagingModel);
+    return d->m_prefetchBehind;
+}
+
+void QIviPagingModel::setPrefetchBehind(int prefetchBehind)
+{
+    Q_D(QIviPagingModel);
+    if (d->m_prefetchBehind == prefetchBehind)
+        return;
+
+    d->m_prefetchBehind = prefetchBehind;
+    emit prefetchBehindChanged(prefetchBehind);
+}
+
 /*!
     \qmlproperty enumeration PagingModel::loadingType
     \brief Holds the currently used loading type used for loading the data.
@@ -611,6 +1184,8 @@ QVariant QIviPagingModel::data(const QModelIndex &index, int role) const
     if (row >= d->m_itemList.count() || row < 0)
         return QVariant();
 
+    d->updateAccessPattern(row);
+
     const int chunkIndex = row / d->m_chunkSize;
     if (d->m_loadingType == DataChanged && !d->m_availableChunks.at(chunkIndex)) {
         //qWarning() << "Cache miss: Fetching Data for index " << row << "and following";
@@ -618,6 +1193,9 @@ QVariant QIviPagingModel::data(const QModelIndex &index, int role) const
         return QVariant();
     }
 
+    if (d->m_loadingType == DataChanged && d->m_maximumCachedChunks > 0)
+        const_cast<QIviPagingModelPrivate*>(d)->touchChunk(chunkIndex);
+
     if (row >= d->m_fetchedDataCount - d->m_fetchMoreThreshold && canFetchMore(QModelIndex()))
         emit fetchMoreThresholdReached();
 
@@ -630,7 +1208,7 @@ QVariant QIviPagingModel::data(const QModelIndex &index, int role) const
     switch (role) {
     case NameRole: return item->name();
     case TypeRole: return item->type();
-    case ItemRole: return d->m_itemList.at(row);
+    case ItemRole: return const_cast<QIviPagingModelPrivate*>(d)->variantAt(row);
     }
 
     return QVariant();
@@ -749,6 +1327,12 @@ void QIviPagingModel::connectToServiceObject(QIviServiceObject *serviceObject)
                             d, &QIviPagingModelPrivate::onCountChanged);
     QObjectPrivate::connect(backend, &QIviPagingModelInterface::dataChanged,
                             d, &QIviPagingModelPrivate::onDataChanged);
+    QObjectPrivate::connect(backend, &QIviPagingModelInterface::batchFetched,
+                            d, &QIviPagingModelPrivate::onBatchFetched);
+    QObjectPrivate::connect(backend, &QIviPagingModelInterface::batchChanged,
+                            d, &QIviPagingModelPrivate::onBatchChanged);
+    QObjectPrivate::connect(backend, &QIviPagingModelInterface::continuationTokenAvailable,
+                            d, &QIviPagingModelPrivate::onContinuationTokenAvailable);
 
     QIviAbstractFeatureListModel::connectToServiceObject(serviceObject);
     //Register this instance with the backend. The backend can initialize the internal structure now
@@ -58,6 +58,9 @@ class Q_QTIVICORE_EXPORT QIviPagingModel : public QIviAbstractFeatureListModel
     Q_PROPERTY(QtIviCoreModule::ModelCapabilities capabilities READ capabilities NOTIFY capabilitiesChanged)
     Q_PROPERTY(int chunkSize READ chunkSize WRITE setChunkSize NOTIFY chunkSizeChanged)
     Q_PROPERTY(int fetchMoreThreshold READ fetchMoreThreshold WRITE setFetchMoreThreshold NOTIFY fetchMoreThresholdChanged)
+    Q_PROPERTY(int maximumCachedChunks READ maximumCachedChunks WRITE setMaximumCachedChunks NOTIFY maximumCachedChunksChanged)
+    Q_PROPERTY(int prefetchAhead READ prefetchAhead WRITE setPrefetchAhead NOTIFY prefetchAheadChanged)
+    Q_PROPERTY(int prefetchBehind READ prefetchBehind WRITE setPrefetchBehind NOTIFY prefetchBehindChanged)
     Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
 
     //TODO fix naming
@@ -89,6 +92,15 @@ public:
     int fetchMoreThreshold() const;
     void setFetchMoreThreshold(int fetchMoreThreshold);
 
+    int maximumCachedChunks() const;
+    void setMaximumCachedChunks(int maximumCachedChunks);
+
+    int prefetchAhead() const;
+    void setPrefetchAhead(int prefetchAhead);
+
+    int prefetchBehind() const;
+    void setPrefetchBehind(int prefetchBehind);
+
     QIviPagingModel::LoadingType loadingType() const;
     void setLoadingType(QIviPagingModel::LoadingType loadingType);
 
@@ -113,6 +125,9 @@ Q_SIGNALS:
     void countChanged();
     void fetchMoreThresholdChanged(int fetchMoreThreshold);
     void fetchMoreThresholdReached() const;
+    void maximumCachedChunksChanged(int maximumCachedChunks);
+    void prefetchAheadChanged(int prefetchAhead);
+    void prefetchBehindChanged(int prefetchBehind);
     void loadingTypeChanged(QIviPagingModel::LoadingType loadingType);
 
 protected:
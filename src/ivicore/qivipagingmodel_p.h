@@ -60,28 +60,79 @@
 #include "qivipagingmodel.h"
 #include "qivipagingmodelinterface.h"
 #include "qivistandarditem.h"
+#include "qivistandarditembatch.h"
 
 #include <QBitArray>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QLinkedList>
+#include <QSet>
 #include <QUuid>
+#include <QVector>
 
 QT_BEGIN_NAMESPACE
 
+// A row holds the QVariant passed by the backend. Rows of a batch hold the index of the item
+// inside the batch instead, until the item is boxed into a QVariant by QIviPagingModelPrivate::variantAt()
+struct QIviPagingModelRow
+{
+    QIviPagingModelRow() = default;
+    QIviPagingModelRow(const QVariant &variant)
+        : variant(variant)
+    {}
+    QIviPagingModelRow(const QIviStandardItemBatch &batch, int index)
+        : variant(index)
+        , batch(batch)
+    {}
+
+    bool isValid() const { return variant.isValid(); }
+    bool isBatchItem() const { return !batch.isEmpty(); }
+    QVariant toVariant() const { return isBatchItem() ? batch.variantAt(variant.toInt()) : variant; }
+
+    QVariant variant;
+    QIviStandardItemBatch batch;
+};
+
+Q_DECLARE_TYPEINFO(QIviPagingModelRow, Q_MOVABLE_TYPE);
+
 class Q_QTIVICORE_EXPORT QIviPagingModelPrivate : public QIviAbstractFeatureListModelPrivate
 {
 public:
     QIviPagingModelPrivate(const QString &interface, QIviPagingModel *model);
     ~QIviPagingModelPrivate() override;
 
+    static QIviPagingModelPrivate *get(QIviPagingModel *model);
+
     void initialize() override;
     void onCapabilitiesChanged(const QUuid &identifier, QtIviCoreModule::ModelCapabilities capabilities);
     void onDataFetched(const QUuid &identifier, const QList<QVariant> &items, int start, bool moreAvailable);
-    void onCountChanged(const QUuid &identifier, int new_length);
+    void onBatchFetched(const QUuid &identifier, const QIviStandardItemBatch &items, int start, bool moreAvailable);
+    virtual void handleDataFetched(const QUuid &identifier, const QVector<QIviPagingModelRow> &items, int start, bool moreAvailable);
+    virtual void onCountChanged(const QUuid &identifier, int new_length);
     void onDataChanged(const QUuid &identifier, const QList<QVariant> &data, int start, int count);
+    void onBatchChanged(const QUuid &identifier, const QIviStandardItemBatch &data, int start, int count);
+    virtual void handleDataChanged(const QVector<QIviPagingModelRow> &data, int start, int count);
     void onFetchMoreThresholdReached();
+    void onContinuationTokenAvailable(const QUuid &identifier, int start, const QByteArray &continuationToken);
     virtual void resetModel();
     virtual void clearToDefaults();
     const QIviStandardItem *itemAt(int i) const;
-    void fetchData(int startIndex);
+    const QIviStandardItem *itemOf(const QIviPagingModelRow &row) const;
+    QVariant variantAt(int i);
+    virtual void fetchData(int startIndex);
+    void requestData(int start, int count);
+    void markChunkResident(int chunkIndex);
+    void touchChunk(int chunkIndex);
+    void evictChunks();
+    void rebaseChunks(int row, int delta);
+    void clearResidentChunks();
+    void updateAccessPattern(int row) const;
+    int prefetchDistance() const;
+    void schedulePrefetch() const;
+    void updatePrefetchQueue();
+    void dispatchPrefetch();
+    qint64 requestTimeout() const;
+    void expirePendingRequests();
 
     QIviPagingModelInterface *backend() const;
 
@@ -91,9 +142,29 @@ public:
     QtIviCoreModule::ModelCapabilities m_capabilities;
     int m_chunkSize;
 
-    QList<QVariant> m_itemList;
+    QVector<QIviPagingModelRow> m_itemList;
     QBitArray m_availableChunks;
+    //The chunks which hold data, the most recently used one first
+    QLinkedList<int> m_residentChunks;
+    QHash<int, QLinkedList<int>::iterator> m_residentChunkIndex;
+    int m_maximumCachedChunks;
+
+    int m_prefetchAhead;
+    int m_prefetchBehind;
+    QList<int> m_prefetchQueue;
+    QHash<int, qint64> m_pendingRequests;
+    QSet<int> m_prefetchInFlight;
+    //The access pattern is recorded by data(), the prefetching itself is done outside of it
+    mutable bool m_prefetchScheduled;
+    QElapsedTimer m_accessTimer;
+    mutable int m_lastAccessedRow;
+    mutable int m_lastAccessedChunk;
+    mutable qint64 m_lastChunkChangeTime;
+    mutable int m_scrollDirection;
+    mutable qreal m_scrollVelocity;
+    qreal m_fetchLatency;
     bool m_moreAvailable;
+    QHash<int, QByteArray> m_continuationTokens;
 
     QUuid m_identifier;
     int m_fetchMoreThreshold;
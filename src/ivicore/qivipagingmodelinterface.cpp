@@ -60,6 +60,25 @@ QT_BEGIN_NAMESPACE
     Every QIviPagingModel generates its own QUuid which is passed to the backend interface and can
     be used to identify a model instance.
 
+    \section1 Continuation Tokens
+
+    Backends which can continue a request directly after the last row of the previous chunk, e.g.
+    by using the sort key of that row in a SQL \c WHERE clause instead of skipping all rows before
+    it, report the QtIviCoreModule::SupportsContinuationTokens capability and provide an invokable
+    function with the following signature:
+
+    \code
+    Q_INVOKABLE void fetchDataAfter(const QUuid &identifier, const QByteArray &continuationToken, int start, int count);
+    \endcode
+
+    The backend passes a token for the row following a chunk with the continuationTokenAvailable()
+    signal. When the model continues reading at that row, the function is looked up by name and
+    called instead of fetchData(). The \e start and \e count arguments have the same meaning as
+    for fetchData() and the result is returned by emitting the dataFetched() signal as well.
+
+    The token is opaque to the model. A backend needs to check that a token still matches the
+    current query and content type, and should fall back to \e start if it doesn't.
+
     \sa QIviPagingModel
 
     //TODO explain how the interface works on a example
@@ -111,7 +130,7 @@ QIviPagingModelInterface::QIviPagingModelInterface(QObjectPrivate &dd, QObject *
     The parameters \a start and \a count define the range of data which should be fetched. This method is expected to emit the dataFetched() signal once
     the new data is ready.
 
-    \sa dataFetched()
+    \sa dataFetched(), {QIviPagingModelInterface#Continuation Tokens}{Continuation Tokens}
 */
 
 /*!
@@ -173,4 +192,51 @@ QIviPagingModelInterface::QIviPagingModelInterface(QObjectPrivate &dd, QObject *
     \note If a null QQuuid is used as a identifier, all model instances will be informed.
 */
 
+/*!
+    \fn void QIviPagingModelInterface::batchFetched(const QUuid &identifier, const QIviStandardItemBatch &data, int start, bool moreAvailable)
+
+    This signal can be emitted instead of dataFetched() and returns the requested data as a single
+    QIviStandardItemBatch in the argument \a data to the QIviPagingModel instance identified by \a identifier.
+
+    As all items of a batch share the same type and are stored in one block of memory, the model
+    doesn't need to copy or check every single item. The arguments \a start and \a moreAvailable have
+    the same meaning as in dataFetched().
+
+    \code
+    QVector<ExampleItem> items = ...;
+    emit batchFetched(identifier, QIviStandardItemBatch::fromVector(items), start, moreAvailable);
+    \endcode
+
+    \note If a null QQuuid is used as a identifier, all model instances will be informed.
+
+    \sa fetchData() dataFetched()
+*/
+
+/*!
+    \fn void QIviPagingModelInterface::batchChanged(const QUuid &identifier, const QIviStandardItemBatch &data, int start, int count)
+
+    This signal can be emitted instead of dataChanged() and passes the new data as a single
+    QIviStandardItemBatch in \a data to the QIviPagingModel instance identified by \a identifier.
+    The arguments \a start and \a count have the same meaning as in dataChanged().
+
+    \note If a null QQuuid is used as a identifier, all model instances will be informed.
+
+    \sa dataChanged()
+*/
+
+/*!
+    \fn void QIviPagingModelInterface::continuationTokenAvailable(const QUuid &identifier, int start, const QByteArray &continuationToken)
+
+    This signal can be emitted by backends supporting QtIviCoreModule::SupportsContinuationTokens
+    before the dataFetched() or batchFetched() signal, to pass the \a continuationToken to the
+    QIviPagingModel instance identified by \a identifier. The token can be used to fetch the data
+    starting at the index \a start, which is the index following the last item of the chunk.
+
+    The model passes the token to the fetchDataAfter() function of the backend when it requests the
+    data at \a start. Requests which don't continue a previous chunk, e.g. when jumping to a
+    different position in the QIviPagingModel::DataChanged mode, still use fetchData().
+
+    \sa {QIviPagingModelInterface#Continuation Tokens}{Continuation Tokens}
+*/
+
 QT_END_NAMESPACE
@@ -46,6 +46,7 @@
 #include <QUuid>
 #include <QtIviCore/QIviFeatureInterface>
 #include <QtIviCore/QIviPagingModel>
+#include <QtIviCore/QIviStandardItemBatch>
 #include <QtIviCore/QtIviCoreModule>
 
 QT_BEGIN_NAMESPACE
@@ -72,6 +73,9 @@ Q_SIGNALS:
     void countChanged(const QUuid &identifier, int newLength);
     void dataFetched(const QUuid &identifier, const QList<QVariant> &data, int start, bool moreAvailable);
     void dataChanged(const QUuid &identifier, const QList<QVariant> &data, int start, int count);
+    void batchFetched(const QUuid &identifier, const QIviStandardItemBatch &data, int start, bool moreAvailable);
+    void batchChanged(const QUuid &identifier, const QIviStandardItemBatch &data, int start, int count);
+    void continuationTokenAvailable(const QUuid &identifier, int start, const QByteArray &continuationToken);
 };
 
 #define QIviPagingModel_iid "org.qt-project.qtivi.PagingModel/1.0"
@@ -49,6 +49,7 @@
 
 #include <QDebug>
 #include <QJSEngine>
+#include <QSharedPointer>
 #include <QtQml>
 
 QT_BEGIN_NAMESPACE
@@ -72,41 +73,126 @@ struct QIviPendingReplyRegistrator {
 };
 static QIviPendingReplyRegistrator _registrator;
 
-// TODO make it reentrant
+/*!
+    \internal
+    \class QIviPendingReplyBasePrivate
+
+    The state shared by all copies of a QIviPendingReply. The result is published using an atomic
+    status, so it can be set from any thread. The QIviPendingReplyWatcher is only created once it
+    is requested, e.g. when the reply is used from QML or a signal connection is needed, as most
+    replies are only used from C++ and the QObject would be the biggest part of their cost.
+*/
+QIviPendingReplyBasePrivate::QIviPendingReplyBasePrivate(int userType)
+    : m_type(userType)
+    , m_status(Pending)
+    , m_watcher(nullptr)
+{
+}
+
+QIviPendingReplyBasePrivate::~QIviPendingReplyBasePrivate()
+{
+    delete m_watcher;
+}
+
+QIviPendingReplyWatcher *QIviPendingReplyBasePrivate::watcher()
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_watcher)
+        m_watcher = new QIviPendingReplyWatcher(this);
+    return m_watcher;
+}
+
+/*!
+    \internal
+    Calls \a continuation once the result is set, or right away if it is already available. The
+    continuation is called in the thread which sets the result.
+*/
+void QIviPendingReplyBasePrivate::addContinuation(const std::function<void()> &continuation)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        if (!isResultAvailable()) {
+            m_continuations.append(continuation);
+            return;
+        }
+    }
+    continuation();
+}
+
+bool QIviPendingReplyBasePrivate::isResultAvailable() const
+{
+    return m_status.loadAcquire() >= Succeeded;
+}
+
+bool QIviPendingReplyBasePrivate::isSuccessful() const
+{
+    return m_status.loadAcquire() == Succeeded;
+}
+
+QVariant QIviPendingReplyBasePrivate::value() const
+{
+    if (isSuccessful())
+        return m_data;
+    return QVariant();
+}
+
+/*!
+    \internal
+    Sets the result to \a value and marks the reply as succeeded or failed depending on
+    \a success. Returns \c false if a result has already been set.
+*/
+bool QIviPendingReplyBasePrivate::resolve(const QVariant &value, bool success)
+{
+    if (!m_status.testAndSetAcquire(Pending, Resolving))
+        return false;
+
+    if (success)
+        m_data = value;
+    m_status.storeRelease(success ? Succeeded : Failed);
+
+    QIviPendingReplyWatcher *watcher;
+    QVector<std::function<void()>> continuations;
+    {
+        QMutexLocker locker(&m_mutex);
+        watcher = m_watcher;
+        continuations.swap(m_continuations);
+    }
 
-QIviPendingReplyWatcherPrivate::QIviPendingReplyWatcherPrivate(int userType, QIviPendingReplyWatcher *parent)
+    if (watcher)
+        watcher->d_func()->notifyResult();
+    for (const auto &continuation : qAsConst(continuations))
+        continuation();
+    return true;
+}
+
+QIviPendingReplyWatcherPrivate::QIviPendingReplyWatcherPrivate(QIviPendingReplyBasePrivate *reply, QIviPendingReplyWatcher *parent)
     : QObjectPrivate()
     , q_ptr(parent)
-    , m_type(userType)
-    , m_resultAvailable(false)
-    , m_success(false)
+    , m_reply(reply)
     , m_callbackEngine(nullptr)
 {
-
 }
 
-void QIviPendingReplyWatcherPrivate::setSuccess(const QVariant &value)
+void QIviPendingReplyWatcherPrivate::notifyResult()
 {
     Q_Q(QIviPendingReplyWatcher);
 
-    if (m_resultAvailable) {
-        qWarning("Result is already set. Ignoring request");
-        return;
+    //emitting valueChanged is intended for failed replies as well, as it makes it easier to react
+    //to successful and failed replies in the same slot.
+    emit q->valueChanged(m_reply->value());
+    if (m_reply->isSuccessful()) {
+        emit q->replySuccess();
+        callSuccessCallback();
+    } else {
+        emit q->replyFailed();
+        callFailedCallback();
     }
-
-    m_resultAvailable = true;
-    m_data = value;
-    m_success = true;
-    emit q->valueChanged(value);
-    emit q->replySuccess();
-
-    callSuccessCallback();
 }
 
 void QIviPendingReplyWatcherPrivate::callSuccessCallback()
 {
     if (!m_successFunctor.isUndefined() && m_callbackEngine) {
-        QJSValueList list = { m_callbackEngine->toScriptValue(m_data) };
+        QJSValueList list = { m_callbackEngine->toScriptValue(m_reply->value()) };
         m_successFunctor.call(list);
     }
 }
@@ -126,12 +212,13 @@ void QIviPendingReplyWatcherPrivate::callFailedCallback()
     \inmodule QtIviCore
     \brief The QIviPendingReplyWatcher provides signals for QIviPendingReply.
 
-    The QIviPendingReplyWatcher holds all data of a QIviPendingReply and is implicitly shared
+    The QIviPendingReplyWatcher provides access to the data of a QIviPendingReply and is shared
     between copies of the same QIviPendingReply instance. At the same time the watcher provides
     signals for when a result is ready or an error happened.
 
-    A QIviPendingReplyWatcher cannot be instantiated on its own. It is always created from a
-    QIviPendingReply internally.
+    A QIviPendingReplyWatcher cannot be instantiated on its own. It is created by the
+    QIviPendingReply the first time it is requested, replies which are only used from C++
+    without signals never create a watcher.
 */
 
 /*!
@@ -144,6 +231,11 @@ void QIviPendingReplyWatcherPrivate::callFailedCallback()
 
     Usually you don't have to use this class, but instead always use the typesafe QIviPendingReply
     template class.
+
+    \note All copies of a reply share their state, the QIviPendingReplyWatcher is only created
+    once it is requested. Earlier versions kept a shared pointer to the watcher in every copy,
+    which was accessible as a protected member. The size and the layout of the class changed
+    accordingly, code using QIviPendingReply needs to be recompiled.
 */
 
 /*!
@@ -378,11 +470,26 @@ void QIviPendingReplyWatcherPrivate::callFailedCallback()
     copies. If all copies of the QIviPendingReply get deleted its QIviPendingReplyWatcher gets
     deleted as well.
 
+    \section2 Continuations
+
+    Without any signal connection, a callable can be chained to a reply using then(). It is called
+    with the result once the reply succeeded and returns a new QIviPendingReply for the value the
+    callable returns. If the result is already available, the callable is called right away.
+
+    \code
+    displayName(uuid).then([this](const QString &name) {
+        useDisplayName(name);
+    });
+    \endcode
+
+    To wait for many replies at once, use qIviWhenAll() or qIviWhenAny(). With a compiler
+    supporting C++20 coroutines, a reply can also be awaited using \c co_await.
+
     For usage in QML see the QML documentation.
 */
 
-QIviPendingReplyWatcher::QIviPendingReplyWatcher(int userType)
-    : QObject(*new QIviPendingReplyWatcherPrivate(userType, this))
+QIviPendingReplyWatcher::QIviPendingReplyWatcher(QIviPendingReplyBasePrivate *reply)
+    : QObject(*new QIviPendingReplyWatcherPrivate(reply, this))
 {
 }
 
@@ -396,7 +503,7 @@ QIviPendingReplyWatcher::QIviPendingReplyWatcher(int userType)
 QVariant QIviPendingReplyWatcher::value() const
 {
     Q_D(const QIviPendingReplyWatcher);
-    return d->m_data;
+    return d->m_reply->value();
 }
 
 /*!
@@ -409,7 +516,7 @@ QVariant QIviPendingReplyWatcher::value() const
 bool QIviPendingReplyWatcher::isValid() const
 {
     Q_D(const QIviPendingReplyWatcher);
-    return d->m_type != -1;
+    return d->m_reply->m_type != -1;
 }
 
 /*!
@@ -421,7 +528,7 @@ bool QIviPendingReplyWatcher::isValid() const
 bool QIviPendingReplyWatcher::isResultAvailable() const
 {
     Q_D(const QIviPendingReplyWatcher);
-    return d->m_resultAvailable;
+    return d->m_reply->isResultAvailable();
 }
 
 /*!
@@ -433,7 +540,7 @@ bool QIviPendingReplyWatcher::isResultAvailable() const
 bool QIviPendingReplyWatcher::isSuccessful() const
 {
     Q_D(const QIviPendingReplyWatcher);
-    return d->m_success;
+    return d->m_reply->isSuccessful();
 }
 
 /*!
@@ -448,49 +555,25 @@ bool QIviPendingReplyWatcher::isSuccessful() const
 void QIviPendingReplyWatcher::setSuccess(const QVariant &value)
 {
     Q_D(QIviPendingReplyWatcher);
+    const int type = d->m_reply->m_type;
 
-    if (d->m_resultAvailable) {
+    if (d->m_reply->isResultAvailable()) {
         qtivi_qmlOrCppWarning(this, "Result is already set. Ignoring request");
         return;
     }
 
-    //no type checking needed when we expect a QVariant or void
-    if (d->m_type == qMetaTypeId<QVariant>() || d->m_type == qMetaTypeId<void>()) {
-        d->setSuccess(value);
-        return;
-    }
-
     QVariant var = value;
-
-    //Try to convert the value, if successfully, use the converted value
-    QVariant temp(var);
-    if (temp.convert(d->m_type))
-        var = temp;
-
-    //We need a special conversion for enums from QML as they are saved as int
-    QMetaType metaType(d->m_type);
-    bool isEnumOrFlag = false;
-
-    const QMetaObject *mo = metaType.metaObject();
-    const QString enumName = QString::fromLocal8Bit(QMetaType::typeName(d->m_type)).split(QStringLiteral("::")).last();
-    if (mo) {
-        QMetaEnum mEnum = mo->enumerator(mo->indexOfEnumerator(enumName.toLocal8Bit().constData()));
-        if (mEnum.isValid()) {
-            isEnumOrFlag = true;
-            if (!mEnum.isFlag() && !mEnum.valueToKey(var.toInt())) {
-                qtivi_qmlOrCppWarning(this, "Enum value out of range");
-                return;
-            }
+    //no type checking needed when we expect a QVariant or void
+    if (type != qMetaTypeId<QVariant>() && type != qMetaTypeId<void>()) {
+        QString error;
+        if (!qtivi_convertToType(var, type, qtivi_metaEnumForType(type), &error)) {
+            qtivi_qmlOrCppWarning(this, error);
+            return;
         }
     }
 
-    //Check that the type names match only if it's not a enum, as it will be converted automatically in this case.
-    if (!isEnumOrFlag && var.typeName() != QVariant::typeToName(d->m_type)) {
-        qtivi_qmlOrCppWarning(this, QString(QStringLiteral("Expected: %1 but got %2")).arg(QLatin1String(QVariant::typeToName(d->m_type)), QLatin1String(QVariant::typeToName(value.userType()))));
-        return;
-    }
-
-    d->setSuccess(var);
+    if (!d->m_reply->resolve(var, true))
+        qtivi_qmlOrCppWarning(this, "Result is already set. Ignoring request");
 }
 
 /*!
@@ -503,18 +586,8 @@ void QIviPendingReplyWatcher::setSuccess(const QVariant &value)
 void QIviPendingReplyWatcher::setFailed()
 {
     Q_D(QIviPendingReplyWatcher);
-    if (d->m_resultAvailable) {
+    if (!d->m_reply->resolve(QVariant(), false))
         qWarning("Result is already set. Ignoring request");
-        return;
-    }
-
-    d->m_resultAvailable = true;
-    //emitting valueChanged is intended here as it makes it easier to react to successful and failed
-    //replies in the same slot.
-    emit valueChanged(d->m_data);
-    emit replyFailed();
-
-    d->callFailedCallback();
 }
 
 /*!
@@ -550,8 +623,8 @@ void QIviPendingReplyWatcher::then(const QJSValue &success, const QJSValue &fail
     if (!d->m_callbackEngine)
         qtivi_qmlOrCppWarning(this, "Couldn't access the current QJSEngine. The given callbacks will not be called without a valid QJSEngine");
 
-    if (d->m_resultAvailable) {
-        if (d->m_success)
+    if (d->m_reply->isResultAvailable()) {
+        if (d->m_reply->isSuccessful())
             d->callSuccessCallback();
         else
             d->callFailedCallback();
@@ -559,13 +632,27 @@ void QIviPendingReplyWatcher::then(const QJSValue &success, const QJSValue &fail
 }
 
 QIviPendingReplyBase::QIviPendingReplyBase(int userType)
-    : m_watcher(new QIviPendingReplyWatcher(userType))
+    : d(new QIviPendingReplyBasePrivate(userType))
+{
+}
+
+QIviPendingReplyBase::QIviPendingReplyBase()
 {
 }
 
 QIviPendingReplyBase::QIviPendingReplyBase(const QIviPendingReplyBase &other)
+    : d(other.d)
+{
+}
+
+QIviPendingReplyBase::~QIviPendingReplyBase()
 {
-    this->m_watcher = other.m_watcher;
+}
+
+QIviPendingReplyBase &QIviPendingReplyBase::operator=(const QIviPendingReplyBase &other)
+{
+    d = other.d;
+    return *this;
 }
 
 /*!
@@ -579,13 +666,16 @@ QIviPendingReplyBase::QIviPendingReplyBase(const QIviPendingReplyBase &other)
     \property QIviPendingReplyBase::watcher
     \brief Holds the watcher for the QIviPendingReply
 
+    The watcher is created the first time this property is read. It lives in the thread it was
+    created in.
+
     \note The QIviPendingReplyWatcher returned is owned by the QIviPendingReply and all its
     copies. If all copies of the QIviPendingReply get deleted its QIviPendingReplyWatcher gets
     deleted as well.
  */
 QIviPendingReplyWatcher *QIviPendingReplyBase::watcher() const
 {
-    return m_watcher.data();
+    return d ? d->watcher() : nullptr;
 }
 
 /*!
@@ -604,8 +694,8 @@ QIviPendingReplyWatcher *QIviPendingReplyBase::watcher() const
 */
 QVariant QIviPendingReplyBase::value() const
 {
-    if (m_watcher)
-        return m_watcher->value();
+    if (d)
+        return d->value();
     return QVariant();
 }
 
@@ -625,8 +715,8 @@ QVariant QIviPendingReplyBase::value() const
 */
 bool QIviPendingReplyBase::isValid() const
 {
-    if (m_watcher)
-        return m_watcher->isValid();
+    if (d)
+        return d->m_type != -1;
     return false;
 }
 
@@ -644,8 +734,8 @@ bool QIviPendingReplyBase::isValid() const
 */
 bool QIviPendingReplyBase::isResultAvailable() const
 {
-    if (m_watcher)
-        return m_watcher->isResultAvailable();
+    if (d)
+        return d->isResultAvailable();
     return false;
 }
 
@@ -663,8 +753,8 @@ bool QIviPendingReplyBase::isResultAvailable() const
 */
 bool QIviPendingReplyBase::isSuccessful() const
 {
-    if (m_watcher)
-        return m_watcher->isSuccessful();
+    if (d)
+        return d->isSuccessful();
     return false;
 }
 
@@ -693,8 +783,8 @@ bool QIviPendingReplyBase::isSuccessful() const
 */
 void QIviPendingReplyBase::then(const QJSValue &success, const QJSValue &failed)
 {
-    if (m_watcher)
-        m_watcher->then(success, failed);
+    if (d)
+        d->watcher()->then(success, failed);
 }
 
 /*!
@@ -719,8 +809,9 @@ void QIviPendingReplyBase::then(const QJSValue &success, const QJSValue &failed)
 */
 void QIviPendingReplyBase::setSuccess(const QVariant &value)
 {
-    if (m_watcher)
-        m_watcher->setSuccess(value);
+    //The watcher is needed to report type errors to QML
+    if (d)
+        d->watcher()->setSuccess(value);
 }
 
 /*!
@@ -741,8 +832,8 @@ void QIviPendingReplyBase::setSuccess(const QVariant &value)
 */
 void QIviPendingReplyBase::setFailed()
 {
-    if (m_watcher)
-        m_watcher->setFailed();
+    if (d && !d->resolve(QVariant(), false))
+        qWarning("Result is already set. Ignoring request");
 }
 
 /*!
@@ -754,8 +845,27 @@ void QIviPendingReplyBase::setFailed()
 */
 void QIviPendingReplyBase::setSuccessNoCheck(const QVariant &value)
 {
-    if (m_watcher)
-        m_watcher->d_func()->setSuccess(value);
+    if (d && !d->resolve(value, true))
+        qWarning("Result is already set. Ignoring request");
+}
+
+/*!
+    \internal
+
+    Calls \a continuation with the success state and the value once the result is set, or right
+    away if it is already available. This is the hook used by the C++ then() functions and the
+    co_await support, which don't need a QIviPendingReplyWatcher.
+*/
+void QIviPendingReplyBase::addContinuation(const std::function<void(bool, const QVariant &)> &continuation) const
+{
+    if (!d)
+        return;
+
+    // The continuation is owned by the private, so it is still alive when the continuation runs
+    QIviPendingReplyBasePrivate *reply = d.data();
+    d->addContinuation([reply, continuation]() {
+        continuation(reply->isSuccessful(), reply->value());
+    });
 }
 
 /*!
@@ -824,6 +934,131 @@ void QIviPendingReplyBase::setSuccessNoCheck(const QVariant &value)
     \sa setFailed
 */
 
+/*!
+    \fn template <class T> template <typename Func> QIviPendingReply<T>::then(Func func) const
+
+    Calls \a func with the result once the reply succeeded and returns a new reply for the
+    value returned by \a func. If this reply fails, the returned reply fails as well and \a func
+    is not called. For a QIviPendingReply<void>, \a func doesn't take any argument.
+
+    If the result is already available, \a func is called right away, otherwise it is called
+    from the thread which sets the result. In contrast to the QIviPendingReplyWatcher, no
+    QObject or signal connection is needed, which makes this the cheapest way to chain
+    operations in C++:
+
+    \code
+    QIviPendingReply<int> reply = backend->volume();
+    QIviPendingReply<QString> text = reply.then([](int volume) {
+        return QString::number(volume) + QLatin1Char('%');
+    });
+    \endcode
+
+    \sa qIviWhenAll(), qIviWhenAny()
+*/
+
+/*!
+    \fn QIviPendingReply<void> qIviWhenAll(const QVector<QIviPendingReplyBase> &replies)
+    \relates QIviPendingReply
+
+    Returns a reply which succeeds once all \a replies have succeeded. The returned reply fails
+    as soon as one of the \a replies fails or if one of them is not valid. If \a replies is empty,
+    the returned reply succeeds right away.
+
+    The results can be read from the original replies afterwards:
+
+    \code
+    QIviPendingReply<int> volume = backend->volume();
+    QIviPendingReply<QString> station = backend->station();
+    qIviWhenAll({ volume, station }).then([volume, station]() {
+        updateDisplay(volume.reply(), station.reply());
+    });
+    \endcode
+
+    \sa qIviWhenAny()
+*/
+QIviPendingReply<void> qIviWhenAll(const QVector<QIviPendingReplyBase> &replies)
+{
+    QIviPendingReply<void> result;
+    QExplicitlySharedDataPointer<QIviPendingReplyBasePrivate> state(QIviPendingReplyBasePrivate::get(result));
+    if (replies.isEmpty()) {
+        result.setSuccess();
+        return result;
+    }
+
+    QSharedPointer<QAtomicInt> remaining(new QAtomicInt(replies.count()));
+    for (const QIviPendingReplyBase &reply : replies) {
+        if (!reply.isValid()) {
+            state->resolve(QVariant(), false);
+            break;
+        }
+        QIviPendingReplyBasePrivate *d = QIviPendingReplyBasePrivate::get(reply);
+        d->addContinuation([state, remaining, d]() {
+            if (!d->isSuccessful())
+                state->resolve(QVariant(), false);
+            else if (!remaining->deref())
+                state->resolve(QVariant(), true);
+        });
+    }
+    return result;
+}
+
+/*!
+    \fn QIviPendingReply<int> qIviWhenAny(const QVector<QIviPendingReplyBase> &replies)
+    \relates QIviPendingReply
+
+    Returns a reply which succeeds as soon as one of the \a replies has succeeded. The value of
+    the returned reply is the index of this reply within \a replies. The returned reply fails if
+    all \a replies failed or if \a replies is empty. Invalid replies count as failed.
+
+    \sa qIviWhenAll()
+*/
+QIviPendingReply<int> qIviWhenAny(const QVector<QIviPendingReplyBase> &replies)
+{
+    QIviPendingReply<int> result;
+    QExplicitlySharedDataPointer<QIviPendingReplyBasePrivate> state(QIviPendingReplyBasePrivate::get(result));
+    if (replies.isEmpty()) {
+        result.setFailed();
+        return result;
+    }
+
+    QSharedPointer<QAtomicInt> remaining(new QAtomicInt(replies.count()));
+    for (int i = 0; i < replies.count(); ++i) {
+        const QIviPendingReplyBase &reply = replies.at(i);
+        if (!reply.isValid()) {
+            if (!remaining->deref())
+                state->resolve(QVariant(), false);
+            continue;
+        }
+        QIviPendingReplyBasePrivate *d = QIviPendingReplyBasePrivate::get(reply);
+        d->addContinuation([state, remaining, d, i]() {
+            if (d->isSuccessful())
+                state->resolve(QVariant::fromValue(i), true);
+            else if (!remaining->deref())
+                state->resolve(QVariant(), false);
+        });
+    }
+    return result;
+}
+
+/*!
+    \fn template <typename T> QIviPendingReplyAwaiter<T> operator co_await(const QIviPendingReply<T> &reply)
+    \relates QIviPendingReply
+
+    Allows to suspend a C++20 coroutine until \a reply has a result. The co_await expression
+    evaluates to the finished reply, which needs to be checked for success:
+
+    \code
+    QIviPendingReply<QString> result = co_await backend->displayName(id);
+    if (result.isSuccessful())
+        useDisplayName(result.reply());
+    \endcode
+
+    The coroutine is resumed in the thread which sets the result. If the result is already
+    available or the reply is not valid, the coroutine is not suspended at all.
+
+    \note This operator is only available if the compiler supports C++20 coroutines.
+*/
+
 /*!
     \fn qIviRegisterPendingReplyType(const char *name)
     \relates QIviPendingReply
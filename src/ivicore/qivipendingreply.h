@@ -45,14 +45,26 @@
 
 #include <QJSValue>
 #include <QObject>
-#include <QSharedPointer>
+#include <QExplicitlySharedDataPointer>
 #include <QVariant>
+#include <QVector>
 
 #include <QtIviCore/qtiviglobal.h>
 
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+#include <coroutine>
+#endif
+
 QT_BEGIN_NAMESPACE
 
 class QIviPendingReplyWatcherPrivate;
+class QIviPendingReplyBasePrivate;
+template <typename T> class QIviPendingReply;
+template <typename T> class QIviPendingReplyAwaiter;
 
 class Q_QTIVICORE_EXPORT QIviPendingReplyWatcher : public QObject
 {
@@ -78,9 +90,9 @@ Q_SIGNALS:
     void valueChanged(const QVariant &value);
 
 private:
-    explicit QIviPendingReplyWatcher(int userType);
+    explicit QIviPendingReplyWatcher(QIviPendingReplyBasePrivate *reply);
     Q_DECLARE_PRIVATE(QIviPendingReplyWatcher)
-    friend class QIviPendingReplyBase;
+    friend class QIviPendingReplyBasePrivate;
 };
 
 class Q_QTIVICORE_EXPORT QIviPendingReplyBase
@@ -94,9 +106,10 @@ class Q_QTIVICORE_EXPORT QIviPendingReplyBase
 
 public:
     explicit QIviPendingReplyBase(int userType);
-    QIviPendingReplyBase() = default;
+    QIviPendingReplyBase();
     QIviPendingReplyBase(const QIviPendingReplyBase & other);
-    ~QIviPendingReplyBase() = default;
+    ~QIviPendingReplyBase();
+    QIviPendingReplyBase &operator=(const QIviPendingReplyBase &other);
 
     QIviPendingReplyWatcher* watcher() const;
     QVariant value() const;
@@ -110,10 +123,29 @@ public:
 
 protected:
     void setSuccessNoCheck(const QVariant & value);
+    void addContinuation(const std::function<void(bool, const QVariant &)> &continuation) const;
+
+    QExplicitlySharedDataPointer<QIviPendingReplyBasePrivate> d;
 
-    QSharedPointer<QIviPendingReplyWatcher> m_watcher;
+    friend class QIviPendingReplyBasePrivate;
+    template <typename T> friend class QIviPendingReplyAwaiter;
 };
 
+namespace QtIviPrivate {
+    template <typename R, typename Func, typename... Args>
+    void resolveReply(QIviPendingReply<R> &reply, Func &func, Args &&... args)
+    {
+        reply.setSuccess(func(std::forward<Args>(args)...));
+    }
+
+    template <typename Func, typename... Args>
+    void resolveReply(QIviPendingReply<void> &reply, Func &func, Args &&... args)
+    {
+        func(std::forward<Args>(args)...);
+        reply.setSuccess();
+    }
+}
+
 template <typename T> class QIviPendingReply : public QIviPendingReplyBase
 {
 public:
@@ -126,7 +158,22 @@ public:
         setSuccessNoCheck(QVariant::fromValue(value));
     }
 
-    T reply() const { return m_watcher->value().template value<T>(); }
+    T reply() const { return value().template value<T>(); }
+
+    using QIviPendingReplyBase::then;
+
+    template <typename Func>
+    auto then(Func func) const -> QIviPendingReply<typename std::decay<decltype(func(std::declval<T>()))>::type>
+    {
+        QIviPendingReply<typename std::decay<decltype(func(std::declval<T>()))>::type> next;
+        addContinuation([next, func](bool success, const QVariant &value) mutable {
+            if (success)
+                QtIviPrivate::resolveReply(next, func, qvariant_cast<T>(value));
+            else
+                next.setFailed();
+        });
+        return next;
+    }
 
     static QIviPendingReply createFailedReply()
     {
@@ -148,7 +195,22 @@ public:
         setSuccessNoCheck(value);
     }
 
-    QVariant reply() const { return m_watcher->value(); }
+    QVariant reply() const { return value(); }
+
+    using QIviPendingReplyBase::then;
+
+    template <typename Func>
+    auto then(Func func) const -> QIviPendingReply<typename std::decay<decltype(func(std::declval<QVariant>()))>::type>
+    {
+        QIviPendingReply<typename std::decay<decltype(func(std::declval<QVariant>()))>::type> next;
+        addContinuation([next, func](bool success, const QVariant &value) mutable {
+            if (success)
+                QtIviPrivate::resolveReply(next, func, value);
+            else
+                next.setFailed();
+        });
+        return next;
+    }
 
     static QIviPendingReply createFailedReply()
     {
@@ -172,6 +234,21 @@ public:
 
     void reply() const { return; }
 
+    using QIviPendingReplyBase::then;
+
+    template <typename Func>
+    auto then(Func func) const -> QIviPendingReply<typename std::decay<decltype(func())>::type>
+    {
+        QIviPendingReply<typename std::decay<decltype(func())>::type> next;
+        addContinuation([next, func](bool success, const QVariant &) mutable {
+            if (success)
+                QtIviPrivate::resolveReply(next, func);
+            else
+                next.setFailed();
+        });
+        return next;
+    }
+
     static QIviPendingReply createFailedReply()
     {
         QIviPendingReply<void> reply;
@@ -180,6 +257,39 @@ public:
     }
 };
 
+Q_QTIVICORE_EXPORT QIviPendingReply<void> qIviWhenAll(const QVector<QIviPendingReplyBase> &replies);
+Q_QTIVICORE_EXPORT QIviPendingReply<int> qIviWhenAny(const QVector<QIviPendingReplyBase> &replies);
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+template <typename T> class QIviPendingReplyAwaiter
+{
+public:
+    explicit QIviPendingReplyAwaiter(const QIviPendingReply<T> &reply)
+        : m_reply(reply)
+    {}
+
+    bool await_ready() const noexcept
+    {
+        return !m_reply.isValid() || m_reply.isResultAvailable();
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) const
+    {
+        m_reply.addContinuation([handle](bool, const QVariant &) { handle.resume(); });
+    }
+
+    QIviPendingReply<T> await_resume() const noexcept { return m_reply; }
+
+private:
+    QIviPendingReply<T> m_reply;
+};
+
+template <typename T> QIviPendingReplyAwaiter<T> operator co_await(const QIviPendingReply<T> &reply)
+{
+    return QIviPendingReplyAwaiter<T>(reply);
+}
+#endif
+
 template <typename T> void qIviRegisterPendingReplyType(const char *name = nullptr)
 {
     qRegisterMetaType<T>();
@@ -57,16 +57,59 @@
 #include <private/qobject_p.h>
 #include <private/qtiviglobal_p.h>
 
+#include <QtCore/QAtomicInt>
+#include <QtCore/QMutex>
+#include <QtCore/QSharedData>
+#include <QtCore/QVector>
+
+#include <functional>
+
 #include "qivipendingreply.h"
 
 QT_BEGIN_NAMESPACE
 
+class Q_QTIVICORE_EXPORT QIviPendingReplyBasePrivate : public QSharedData
+{
+public:
+    enum Status {
+        Pending,
+        Resolving,
+        Succeeded,
+        Failed
+    };
+
+    explicit QIviPendingReplyBasePrivate(int userType);
+    ~QIviPendingReplyBasePrivate();
+
+    static QIviPendingReplyBasePrivate *get(const QIviPendingReplyBase &reply) { return reply.d.data(); }
+
+    QIviPendingReplyWatcher *watcher();
+    void addContinuation(const std::function<void()> &continuation);
+
+    bool isResultAvailable() const;
+    bool isSuccessful() const;
+    QVariant value() const;
+    bool resolve(const QVariant &value, bool success);
+
+    const int m_type;
+    QAtomicInt m_status;
+    QVariant m_data;
+
+    // Guards the lazily created watcher and the continuations
+    QMutex m_mutex;
+    QIviPendingReplyWatcher *m_watcher;
+    QVector<std::function<void()>> m_continuations;
+
+private:
+    Q_DISABLE_COPY(QIviPendingReplyBasePrivate)
+};
+
 class Q_QTIVICORE_EXPORT QIviPendingReplyWatcherPrivate : public QObjectPrivate
 {
 public:
-    QIviPendingReplyWatcherPrivate(int userType, QIviPendingReplyWatcher *parent);
+    QIviPendingReplyWatcherPrivate(QIviPendingReplyBasePrivate *reply, QIviPendingReplyWatcher *parent);
 
-    void setSuccess(const QVariant &value);
+    void notifyResult();
     void callSuccessCallback();
     void callFailedCallback();
 
@@ -74,10 +117,7 @@ public:
     Q_DECLARE_PUBLIC(QIviPendingReplyWatcher)
     Q_DISABLE_COPY(QIviPendingReplyWatcherPrivate)
 
-    int m_type;
-    bool m_resultAvailable;
-    bool m_success;
-    QVariant m_data;
+    QIviPendingReplyBasePrivate * const m_reply;
     QJSValue m_successFunctor;
     QJSValue m_failedFunctor;
     QJSEngine *m_callbackEngine;
@@ -42,6 +42,7 @@
 
 #include "qiviproperty.h"
 #include "qiviproperty_p.h"
+#include "qiviqmlconversion_helper.h"
 
 #include <QMetaEnum>
 #include <QQmlEngine>
@@ -57,6 +58,7 @@ QIviPropertyPrivate::QIviPropertyPrivate(int userType, QtPrivate::QSlotObjectBas
     , m_attributeGetter(attributeGetter)
     , m_valueGetter(valueGetter)
     , m_valueSetter(nullptr)
+    , m_metaEnum(qtivi_metaEnumForType(userType))
 {}
 
 void QIviPropertyPrivate::throwError(QObject *object, const QString &error)
@@ -88,8 +90,10 @@ void QIviPropertyPrivate::throwError(QObject *object, const QString &error)
     Although the QIviProperty only contains QVariant properties, it still stores
     the real type of the value and checks that only values of the correct type can be
     stored in it.
-    The QIviProperty doesn't store a copy of the values, instead it just acts as a
-    forwarder which calls the respective getters and forwards the notification signals.
+    The QIviProperty calls the respective getters only for the first read. Afterwards it
+    keeps a snapshot of the value and the attribute, which is refreshed whenever the
+    notification signals are emitted. The notification signals need to be emitted for every
+    change for this to work.
 
     By default a QIviProperty is also able to write a value change back to its origin,
     but it also supports read-only properties which don't provide a setter for the value.
@@ -141,31 +145,9 @@ void QIviProperty::setValue(const QVariant &value)
         return;
     }
 
-    //Try to convert the value, if successfully, use the converted value
-    QVariant temp(var);
-    if (temp.convert(d->m_type))
-        var = temp;
-
-    //We need a special conversion for enums from QML as they are saved as int
-    QMetaType metaType(d->m_type);
-    bool isEnumOrFlag = false;
-
-    const QMetaObject *mo = metaType.metaObject();
-    QString enumName = QString::fromLocal8Bit(QMetaType::typeName(d->m_type)).split(QStringLiteral("::")).last();
-    if (mo) {
-        QMetaEnum mEnum = mo->enumerator(mo->indexOfEnumerator(enumName.toLocal8Bit().constData()));
-        if (mEnum.isValid()) {
-            isEnumOrFlag = true;
-            if (!mEnum.isFlag() && !mEnum.valueToKey(var.toInt())) {
-                d->throwError(this, QLatin1String("Enum value out of range"));
-                return;
-            }
-        }
-    }
-
-    //Check that the type names match only if it's not a enum, as it will be converted automatically in this case.
-    if (!isEnumOrFlag && var.typeName() != QVariant::typeToName(d->m_type)) {
-        d->throwError(this, QStringLiteral("Expected: %1 but got %2").arg(QLatin1String(QVariant::typeToName(d->m_type)), QLatin1String(QVariant::typeToName(value.userType()))));
+    QString error;
+    if (!qtivi_convertToType(var, d->m_type, d->m_metaEnum, &error)) {
+        d->throwError(this, error);
         return;
     }
 
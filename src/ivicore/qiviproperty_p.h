@@ -54,6 +54,7 @@
 // We mean it.
 //
 
+#include <QtCore/QMetaEnum>
 #include <QtCore/QObject>
 #include <QtIviCore/QIviProperty>
 #include <private/qtiviglobal_p.h>
@@ -75,6 +76,8 @@ public:
     QtPrivate::QSlotObjectBase *m_attributeGetter;
     QtPrivate::QSlotObjectBase *m_valueGetter;
     QtPrivate::QSlotObjectBase *m_valueSetter;
+    // Resolved once, as every write from QML needs it
+    QMetaEnum m_metaEnum;
 };
 
 QT_END_NAMESPACE
@@ -64,6 +64,11 @@ QT_BEGIN_NAMESPACE
     \endcode
 
     This Factory provides two functions, one for creating a read-write property and one for a read-only property.
+
+    The getters are only called for the first read of the value and the attribute. Afterwards the
+    property returns a cached copy, which is updated by the value and attribute signals. The
+    \e sender needs to emit these signals for every change of the value or the attribute,
+    otherwise the property keeps returning the old value.
 */
 
 /*!
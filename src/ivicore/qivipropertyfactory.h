@@ -125,45 +125,82 @@ public:
                                                       new QtPrivate::QSlotObject<attributeGetterFunc, typename AttributeGetterType::Arguments, typename AttributeGetterType::ReturnType>(attributeGetter),
                                                       new QtPrivate::QSlotObject<valueGetterFunc, typename ValueGetterType::Arguments, typename ValueGetterType::ReturnType>(valueGetter));
 
-        connect(sender, attributeSignal, prop, [prop](const QIviPropertyAttribute<T> &attribute) {prop->updateAttribute(attribute);});
-        connect(sender, valueSignal, prop, [prop](const T &value) {prop->valueChanged(QVariant::fromValue(value));});
+        //Without a working change signal the snapshots could go stale, the getters are used instead
+        prop->m_attributesCacheable = bool(connect(sender, attributeSignal, prop, [prop](const QIviPropertyAttribute<T> &attribute) {prop->updateAttribute(attribute);}));
+        prop->m_valueCacheable = bool(connect(sender, valueSignal, prop, [prop](const T &value) {prop->updateValue(value);}));
 
         return prop;
     }
 
     bool isAvailable() const override
     {
-        return callAttributeGetter().isAvailable();
+        return attributes().available;
     }
 
     QVariant minimumValue() const override
     {
-        return QVariant::fromValue<T>(callAttributeGetter().minimumValue());
+        return attributes().minimumValue;
     }
     QVariant maximumValue() const override
     {
-        return QVariant::fromValue<T>(callAttributeGetter().maximumValue());
+        return attributes().maximumValue;
     }
     QVariantList availableValues() const override
     {
-        return qtivi_convertAvailableValues(callAttributeGetter().availableValues());
+        return attributes().availableValues;
     }
 
     QVariant value() const override
     {
-        T val;
-        void *args[] = { reinterpret_cast<void*>(&val), QVariant().data() };
-        valueGetter()->call(parent(), args);
-        return qtivi_convertValue(val);
+        if (!m_valueCached) {
+            T val;
+            void *args[] = { reinterpret_cast<void*>(&val), QVariant().data() };
+            valueGetter()->call(parent(), args);
+            m_value = qtivi_convertValue(val);
+            m_valueCached = m_valueCacheable;
+        }
+        return m_value;
     }
 
 private:
+    //The attribute in the form it is exposed by the QIviProperty. All members are implicitly
+    //shared, reading them is just a copy of a pointer.
+    struct AttributeSnapshot {
+        bool available = false;
+        QVariant minimumValue;
+        QVariant maximumValue;
+        QVariantList availableValues;
+    };
+
     QIviPropertyFactory(int userType, const QObject *receiver, QtPrivate::QSlotObjectBase *attGetter, QtPrivate::QSlotObjectBase *valGetter)
         : QIviProperty(userType, receiver, attGetter, valGetter)
+        , m_attributesCacheable(false)
+        , m_attributesCached(false)
+        , m_valueCacheable(false)
+        , m_valueCached(false)
     {
         registerConverters();
     }
 
+    //The getters are only called for the first read, afterwards the snapshots are kept up to date
+    //by the change signals of the sender. This relies on the sender emitting the change signals
+    //for every change, see the QIviPropertyFactory documentation.
+    const AttributeSnapshot &attributes() const
+    {
+        if (!m_attributesCached)
+            storeAttribute(callAttributeGetter());
+        return m_attributes;
+    }
+
+    void storeAttribute(const QIviPropertyAttribute<T> &attribute) const
+    {
+        m_attributes.available = attribute.isAvailable();
+        m_attributes.minimumValue = QVariant::fromValue<T>(attribute.minimumValue());
+        m_attributes.maximumValue = QVariant::fromValue<T>(attribute.maximumValue());
+        m_attributes.availableValues = qtivi_convertAvailableValues(attribute.availableValues());
+        m_attributesCached = m_attributesCacheable;
+    }
+
     //We need to know the exact type here to allocate it before calling the getter.
     //The call function will just use the operator=() function to assign it to our local instance,
     //but will not create a new one.
@@ -176,10 +213,18 @@ private:
 
     void updateAttribute(const QIviPropertyAttribute<T> &attribute)
     {
-        Q_EMIT availableChanged(attribute.isAvailable());
-        Q_EMIT minimumValueChanged(QVariant::fromValue<T>(attribute.minimumValue()));
-        Q_EMIT maximumValueChanged(QVariant::fromValue<T>(attribute.maximumValue()));
-        Q_EMIT availableValuesChanged(qtivi_convertAvailableValues(attribute.availableValues()));
+        storeAttribute(attribute);
+        Q_EMIT availableChanged(m_attributes.available);
+        Q_EMIT minimumValueChanged(m_attributes.minimumValue);
+        Q_EMIT maximumValueChanged(m_attributes.maximumValue);
+        Q_EMIT availableValuesChanged(m_attributes.availableValues);
+    }
+
+    void updateValue(const T &value)
+    {
+        m_value = qtivi_convertValue(value);
+        m_valueCached = true;
+        Q_EMIT valueChanged(QVariant::fromValue(value));
     }
 
     //Just needed as we can't call the protected function directly in the create() functions
@@ -200,6 +245,13 @@ private:
             QMetaType::registerConverter<F, int>([](const F & f){return int(f);});
     }
 
+    mutable AttributeSnapshot m_attributes;
+    mutable QVariant m_value;
+    bool m_attributesCacheable;
+    mutable bool m_attributesCached;
+    bool m_valueCacheable;
+    mutable bool m_valueCached;
+
     friend struct PropertyTestData;
 };
 
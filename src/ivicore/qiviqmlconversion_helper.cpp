@@ -43,6 +43,7 @@
 #include <qiviqmlconversion_helper.h>
 
 #include <QtQml>
+#include <QReadWriteLock>
 #include <private/qv4engine_p.h>
 #include <private/qv4errorobject_p.h>
 #include <private/qv4scopedvalue_p.h>
@@ -53,6 +54,18 @@ QT_BEGIN_NAMESPACE
 namespace qtivi_helper {
     static const QString valueLiteral = QStringLiteral("value");
     static const QString typeLiteral = QStringLiteral("type");
+
+    struct GadgetInfo {
+        bool isGadget;
+        bool isDerived;
+    };
+
+    struct TypeCache {
+        QReadWriteLock lock;
+        QHash<int, QMetaEnum> enums;
+        QHash<QPair<int, const QMetaObject*>, GadgetInfo> gadgets;
+    };
+    Q_GLOBAL_STATIC(TypeCache, typeCache)
 }
 
 using namespace qtivi_helper;
@@ -92,6 +105,123 @@ void qtivi_qmlOrCppWarning(const QObject *obj, const QString &errorString)
     v4->throwError(errorString);
 }
 
+/*!
+    \internal
+
+    Returns the QMetaEnum for the enum type \a userType or an invalid QMetaEnum if the type
+    is not an enum registered with Q_ENUM or Q_FLAG.
+
+    The result is cached, as this is called for every property value which is passed to QML.
+*/
+QMetaEnum qtivi_metaEnumForType(int userType)
+{
+    TypeCache *cache = typeCache();
+    {
+        QReadLocker locker(&cache->lock);
+        auto it = cache->enums.constFind(userType);
+        if (it != cache->enums.constEnd())
+            return it.value();
+    }
+
+    QMetaEnum mEnum;
+    const QMetaObject *mo = QMetaType::metaObjectForType(userType);
+    if (mo) {
+        QByteArray enumName = QMetaType::typeName(userType);
+        const int index = enumName.lastIndexOf("::");
+        if (index != -1)
+            enumName = enumName.mid(index + 2);
+        mEnum = mo->enumerator(mo->indexOfEnumerator(enumName.constData()));
+    }
+
+    QWriteLocker locker(&cache->lock);
+    cache->enums.insert(userType, mEnum);
+    return mEnum;
+}
+
+/*!
+    \internal
+
+    Converts \a value to the type \a userType, as needed for values which are passed from QML.
+    The \a metaEnum needs to be the result of qtivi_metaEnumForType() for \a userType, callers
+    which check many values of the same type are expected to resolve it only once.
+
+    Returns \c false and sets \a errorString if \a value can't be converted or is not a valid
+    value of the enum.
+*/
+bool qtivi_convertToType(QVariant &value, int userType, const QMetaEnum &metaEnum, QString *errorString)
+{
+    const int originalType = value.userType();
+
+    //Try to convert the value, if successfully, use the converted value
+    if (originalType != userType) {
+        QVariant temp(value);
+        if (temp.convert(userType))
+            value = temp;
+    }
+
+    //We need a special conversion for enums from QML as they are saved as int
+    if (metaEnum.isValid()) {
+        if (!metaEnum.isFlag() && !metaEnum.valueToKey(value.toInt())) {
+            *errorString = QStringLiteral("Enum value out of range");
+            return false;
+        }
+        return true;
+    }
+
+    //Check that the types match only if it's not a enum, as it will be converted automatically in this case.
+    if (value.userType() != userType) {
+        *errorString = QStringLiteral("Expected: %1 but got %2").arg(QLatin1String(QMetaType::typeName(userType)),
+                                                                     QLatin1String(QMetaType::typeName(originalType)));
+        return false;
+    }
+    return true;
+}
+
+/*!
+    \internal
+
+    Returns \c true if the type \a userType is a gadget which is derived from \a metaObject.
+    If \a isGadget is provided, it is set to whether \a userType is a gadget at all.
+
+    The result is cached, to not walk the hierarchy of meta objects for every row of a model.
+*/
+bool qtivi_isGadgetDerivedFrom(int userType, const QMetaObject *metaObject, bool *isGadget)
+{
+    TypeCache *cache = typeCache();
+    const auto key = qMakePair(userType, metaObject);
+    GadgetInfo info = { false, false };
+    bool found = false;
+    {
+        QReadLocker locker(&cache->lock);
+        auto it = cache->gadgets.constFind(key);
+        if (it != cache->gadgets.constEnd()) {
+            info = it.value();
+            found = true;
+        }
+    }
+
+    if (!found) {
+        QMetaType type(userType);
+        info.isGadget = type.flags().testFlag(QMetaType::IsGadget);
+        info.isDerived = false;
+        const QMetaObject *mo = info.isGadget ? type.metaObject() : nullptr;
+        while (mo) {
+            if (mo == metaObject || qstrcmp(mo->className(), metaObject->className()) == 0) {
+                info.isDerived = true;
+                break;
+            }
+            mo = mo->superClass();
+        }
+
+        QWriteLocker locker(&cache->lock);
+        cache->gadgets.insert(key, info);
+    }
+
+    if (isGadget)
+        *isGadget = info.isGadget;
+    return info.isDerived;
+}
+
 /*!
     \relates QIviSimulationEngine
 
@@ -45,6 +45,7 @@
 
 #include <QtIviCore/qtiviglobal.h>
 
+#include <QtCore/QAtomicInt>
 #include <QtCore/QMetaEnum>
 #include <QtCore/QVariant>
 #include <QtCore/QVector>
@@ -57,23 +58,18 @@ Q_QTIVICORE_EXPORT void qtivi_qmlOrCppWarning(const QObject *obj, const QString&
 
 Q_QTIVICORE_EXPORT QVariant qtivi_convertFromJSON(const QVariant &val);
 
+Q_QTIVICORE_EXPORT QMetaEnum qtivi_metaEnumForType(int userType);
+Q_QTIVICORE_EXPORT bool qtivi_convertToType(QVariant &value, int userType, const QMetaEnum &metaEnum, QString *errorString);
+Q_QTIVICORE_EXPORT bool qtivi_isGadgetDerivedFrom(int userType, const QMetaObject *metaObject, bool *isGadget = nullptr);
+
 template <typename T>  QVariant qtivi_convertValue(const T &val)
 {
-    QVariant var;
-    int userType = qMetaTypeId<T>();
-    QMetaType metaType(userType);
-    const QMetaObject *mo = metaType.metaObject();
-    QString enumName = QString::fromLocal8Bit(QMetaType::typeName(userType)).split(QStringLiteral("::")).last();
-    if (mo) {
-        QMetaEnum mEnum = mo->enumerator(mo->indexOfEnumerator(enumName.toLocal8Bit().constData()));
-        if (mEnum.isValid())
-            var = QVariant::fromValue<T>(val).toInt();
-    }
+    //The meta type information doesn't change at runtime, resolve it only once per type
+    static const bool isEnum = qtivi_metaEnumForType(qMetaTypeId<T>()).isValid();
+    if (isEnum)
+        return QVariant::fromValue<T>(val).toInt();
 
-    if (!var.isValid())
-        var = QVariant::fromValue<T>(val);
-
-    return var;
+    return QVariant::fromValue<T>(val);
 }
 
 template <typename T> QVariantList qtivi_convertAvailableValues(const QVector<T> &aValues)
@@ -95,18 +91,22 @@ template <class T> const T *qtivi_gadgetFromVariant(const QObject *obj, const QV
     }
 
     const void *data = var.constData();
+    const int userType = var.userType();
 
-    QMetaType type(var.userType());
-    if (Q_UNLIKELY(!type.flags().testFlag(QMetaType::IsGadget))) {
-        qtivi_qmlOrCppWarning(obj, "The passed QVariant needs to use the Q_GADGET macro");
-        return nullptr;
+    //Most models only contain items of a single type, remember the last matching one
+    static QBasicAtomicInt lastMatchingType = Q_BASIC_ATOMIC_INITIALIZER(int(QMetaType::UnknownType));
+    if (Q_LIKELY(userType == lastMatchingType.loadAcquire()))
+        return reinterpret_cast<const T*>(data);
+
+    bool isGadget = false;
+    if (qtivi_isGadgetDerivedFrom(userType, &T::staticMetaObject, &isGadget)) {
+        lastMatchingType.storeRelease(userType);
+        return reinterpret_cast<const T*>(data);
     }
 
-    const QMetaObject *mo = type.metaObject();
-    while (mo) {
-        if (mo->className() == T::staticMetaObject.className())
-            return reinterpret_cast<const T*>(data);
-        mo = mo->superClass();
+    if (Q_UNLIKELY(!isGadget)) {
+        qtivi_qmlOrCppWarning(obj, "The passed QVariant needs to use the Q_GADGET macro");
+        return nullptr;
     }
 
     qtivi_qmlOrCppWarning(obj, QLatin1String("The passed QVariant is not derived from ") + QLatin1String(T::staticMetaObject.className()));
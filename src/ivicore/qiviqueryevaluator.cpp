@@ -0,0 +1,616 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 Luxoft Sweden AB
+** Copyright (C) 2018 Pelagicore AG
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtIvi module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL-QTAS$
+** Commercial License Usage
+** Licensees holding valid commercial Qt Automotive Suite licenses may use
+** this file in accordance with the commercial license agreement provided
+** with the Software or, alternatively, in accordance with the terms
+** contained in a written agreement between you and The Qt Company.  For
+** licensing terms and conditions see https://www.qt.io/terms-conditions.
+** For further information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+** SPDX-License-Identifier: LGPL-3.0
+**
+****************************************************************************/
+
+#include "qiviqueryevaluator.h"
+#include "qiviqueryevaluator_p.h"
+#include "qiviqmlconversion_helper.h"
+
+#include <QtCore/QRunnable>
+#include <QtCore/QSemaphore>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+#include <QtCore/QVarLengthArray>
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
+QT_BEGIN_NAMESPACE
+
+namespace qtivi_helper {
+    class QueryEvaluatorTask : public QRunnable
+    {
+    public:
+        QueryEvaluatorTask(const std::function<void()> &function, QSemaphore *done)
+            : m_function(function)
+            , m_done(done)
+        {}
+
+        void run() override
+        {
+            m_function();
+            m_done->release();
+        }
+
+    private:
+        std::function<void()> m_function;
+        QSemaphore *m_done;
+    };
+
+    int chunkCount(int count, int threshold)
+    {
+        if (threshold <= 0 || count < threshold)
+            return 1;
+        return qBound(1, QThread::idealThreadCount(), count);
+    }
+
+    int chunkBegin(int chunk, int chunks, int count)
+    {
+        return int(qint64(count) * chunk / chunks);
+    }
+
+    // Calls function for every chunk of [0, count). The first chunk is processed by the calling
+    // thread, all others by the global thread pool. If the pool has no free thread, the chunk is
+    // processed by the calling thread as well, as waiting for a busy pool could dead-lock.
+    void runChunks(int chunks, int count, const std::function<void(int, int, int)> &function)
+    {
+        if (chunks <= 1) {
+            function(0, 0, count);
+            return;
+        }
+
+        QSemaphore done;
+        for (int chunk = 1; chunk < chunks; ++chunk) {
+            auto task = new QueryEvaluatorTask([&function, chunk, chunks, count]() {
+                function(chunk, chunkBegin(chunk, chunks, count), chunkBegin(chunk + 1, chunks, count));
+            }, &done);
+            if (!QThreadPool::globalInstance()->tryStart(task)) {
+                task->run();
+                delete task;
+            }
+        }
+        function(0, 0, chunkBegin(1, chunks, count));
+        done.acquire(chunks - 1);
+    }
+
+    bool isNumber(int userType)
+    {
+        switch (userType) {
+        case QMetaType::Bool:
+        case QMetaType::Int:
+        case QMetaType::UInt:
+        case QMetaType::LongLong:
+        case QMetaType::ULongLong:
+        case QMetaType::Double:
+        case QMetaType::Float:
+        case QMetaType::Long:
+        case QMetaType::ULong:
+        case QMetaType::Short:
+        case QMetaType::UShort:
+        case QMetaType::Char:
+        case QMetaType::SChar:
+        case QMetaType::UChar:
+            return true;
+        default:
+            return QMetaType::typeFlags(userType).testFlag(QMetaType::IsEnumeration);
+        }
+    }
+
+    // Only the '*' wildcard is supported by the query language, everything else is matched literally
+    QRegularExpression wildcardPattern(const QString &value, Qt::CaseSensitivity cs)
+    {
+        const QStringList parts = value.split(QLatin1Char('*'));
+        QStringList escaped;
+        escaped.reserve(parts.count());
+        for (const QString &part : parts)
+            escaped.append(QRegularExpression::escape(part));
+
+        QRegularExpression::PatternOptions options = QRegularExpression::DontCaptureOption;
+        if (cs == Qt::CaseInsensitive)
+            options |= QRegularExpression::CaseInsensitiveOption;
+        QRegularExpression pattern(QStringLiteral("\\A(?:%1)\\z").arg(escaped.join(QStringLiteral(".*"))), options);
+        pattern.optimize();
+        return pattern;
+    }
+}
+
+using namespace qtivi_helper;
+
+QIviQueryEvaluatorPrivate::QIviQueryEvaluatorPrivate()
+    : m_metaObject(nullptr)
+    , m_parallelThreshold(10000)
+{
+}
+
+QMetaProperty QIviQueryEvaluatorPrivate::resolveProperty(const QString &name)
+{
+    const int index = m_metaObject->indexOfProperty(name.toUtf8().constData());
+    if (index == -1 || !m_metaObject->property(index).isReadable()) {
+        m_errorString = QStringLiteral("Unknown property: %1").arg(name);
+        return QMetaProperty();
+    }
+    return m_metaObject->property(index);
+}
+
+bool QIviQueryEvaluatorPrivate::compile(const QIviAbstractQueryTerm *term)
+{
+    switch (term->type()) {
+    case QIviAbstractQueryTerm::ScopeTerm: {
+        auto *scope = static_cast<const QIviScopeTerm*>(term);
+        if (!compile(scope->term()))
+            return false;
+        if (scope->isNegated()) {
+            Instruction instruction;
+            instruction.code = Instruction::Not;
+            m_program.append(instruction);
+        }
+        return true;
+    }
+    case QIviAbstractQueryTerm::ConjunctionTerm: {
+        auto *conjunction = static_cast<const QIviConjunctionTerm*>(term);
+        const QList<QIviAbstractQueryTerm*> terms = conjunction->terms();
+        for (const QIviAbstractQueryTerm *child : terms) {
+            if (!compile(child))
+                return false;
+        }
+        Instruction instruction;
+        instruction.code = conjunction->conjunction() == QIviConjunctionTerm::Or ? Instruction::Or : Instruction::And;
+        instruction.operandCount = terms.count();
+        m_program.append(instruction);
+        return true;
+    }
+    case QIviAbstractQueryTerm::FilterTerm: {
+        auto *filter = static_cast<const QIviFilterTerm*>(term);
+        Instruction instruction;
+        instruction.property = resolveProperty(filter->propertyName());
+        if (!instruction.property.isValid())
+            return false;
+        instruction.op = filter->operatorType();
+        instruction.negated = filter->isNegated();
+        instruction.value = filter->value();
+
+        const int propertyType = instruction.property.userType();
+        const int valueType = instruction.value.userType();
+        const bool isEquality = instruction.op == QIviFilterTerm::Equals
+                || instruction.op == QIviFilterTerm::EqualsCaseInsensitive
+                || instruction.op == QIviFilterTerm::Unequals;
+
+        if (isEquality && valueType == QMetaType::QString && instruction.value.toString().contains(QLatin1Char('*'))) {
+            const Qt::CaseSensitivity cs = instruction.op == QIviFilterTerm::EqualsCaseInsensitive ? Qt::CaseInsensitive : Qt::CaseSensitive;
+            instruction.pattern = wildcardPattern(instruction.value.toString(), cs);
+        } else if (valueType != propertyType && !(isNumber(valueType) && isNumber(propertyType))) {
+            //Convert the value only once instead of for every item
+            QVariant converted = instruction.value;
+            if (converted.convert(propertyType))
+                instruction.value = converted;
+        }
+
+        m_program.append(instruction);
+        return true;
+    }
+    }
+
+    return false;
+}
+
+bool QIviQueryEvaluatorPrivate::compileOrder(const QList<QIviOrderTerm> &orderTerms)
+{
+    m_order.reserve(orderTerms.count());
+    for (const QIviOrderTerm &term : orderTerms) {
+        const QMetaProperty property = resolveProperty(term.propertyName());
+        if (!property.isValid())
+            return false;
+        m_order.append({ property, term.isAscending() });
+    }
+    return true;
+}
+
+bool QIviQueryEvaluatorPrivate::isCompatible(int userType) const
+{
+    return qtivi_isGadgetDerivedFrom(userType, m_metaObject);
+}
+
+bool QIviQueryEvaluatorPrivate::matches(const void *gadget) const
+{
+    if (m_program.isEmpty())
+        return true;
+
+    QVarLengthArray<bool, 32> stack;
+    for (const Instruction &instruction : m_program) {
+        switch (instruction.code) {
+        case Instruction::Filter:
+            stack.append(filterMatches(instruction, gadget));
+            break;
+        case Instruction::Not:
+            stack.last() = !stack.last();
+            break;
+        case Instruction::And:
+        case Instruction::Or: {
+            const int first = stack.size() - instruction.operandCount;
+            const bool isAnd = instruction.code == Instruction::And;
+            bool result = isAnd;
+            for (int i = first; i < stack.size(); ++i)
+                result = isAnd ? (result && stack.at(i)) : (result || stack.at(i));
+            stack.resize(first);
+            stack.append(result);
+            break;
+        }
+        }
+    }
+    return stack.last();
+}
+
+bool QIviQueryEvaluatorPrivate::filterMatches(const Instruction &instruction, const void *gadget) const
+{
+    const QVariant value = instruction.property.readOnGadget(gadget);
+
+    bool result = false;
+    switch (instruction.op) {
+    case QIviFilterTerm::Equals:
+    case QIviFilterTerm::EqualsCaseInsensitive:
+    case QIviFilterTerm::Unequals: {
+        if (instruction.pattern.isValid() && !instruction.pattern.pattern().isEmpty()) {
+            result = instruction.pattern.match(value.toString()).hasMatch();
+        } else {
+            const Qt::CaseSensitivity cs = instruction.op == QIviFilterTerm::EqualsCaseInsensitive ? Qt::CaseInsensitive : Qt::CaseSensitive;
+            result = compareValues(value, instruction.value, cs) == 0;
+        }
+        if (instruction.op == QIviFilterTerm::Unequals)
+            result = !result;
+        break;
+    }
+    case QIviFilterTerm::GreaterThan:
+        result = compareValues(value, instruction.value, Qt::CaseSensitive) > 0;
+        break;
+    case QIviFilterTerm::GreaterEquals:
+        result = compareValues(value, instruction.value, Qt::CaseSensitive) >= 0;
+        break;
+    case QIviFilterTerm::LowerThan:
+        result = compareValues(value, instruction.value, Qt::CaseSensitive) < 0;
+        break;
+    case QIviFilterTerm::LowerEquals:
+        result = compareValues(value, instruction.value, Qt::CaseSensitive) <= 0;
+        break;
+    }
+
+    return instruction.negated ? !result : result;
+}
+
+void QIviQueryEvaluatorPrivate::readKeys(const void *gadget, QVariant *keys) const
+{
+    for (int i = 0; i < m_order.count(); ++i)
+        keys[i] = m_order.at(i).property.readOnGadget(gadget);
+}
+
+int QIviQueryEvaluatorPrivate::compareKeys(const QVariant *left, const QVariant *right) const
+{
+    for (int i = 0; i < m_order.count(); ++i) {
+        const int result = compareValues(left[i], right[i], Qt::CaseSensitive);
+        if (result != 0)
+            return m_order.at(i).ascending ? result : -result;
+    }
+    return 0;
+}
+
+int QIviQueryEvaluatorPrivate::compareValues(const QVariant &left, const QVariant &right, Qt::CaseSensitivity cs)
+{
+    const int leftType = left.userType();
+    const int rightType = right.userType();
+
+    if (isNumber(leftType) && isNumber(rightType)) {
+        if (leftType == rightType && leftType != QMetaType::Double && leftType != QMetaType::Float) {
+            const qlonglong l = left.toLongLong();
+            const qlonglong r = right.toLongLong();
+            return l < r ? -1 : (l > r ? 1 : 0);
+        }
+        const double l = left.toDouble();
+        const double r = right.toDouble();
+        return l < r ? -1 : (l > r ? 1 : 0);
+    }
+
+    if (leftType == QMetaType::QString || rightType == QMetaType::QString) {
+        const int result = QString::compare(left.toString(), right.toString(), cs);
+        return result < 0 ? -1 : (result > 0 ? 1 : 0);
+    }
+
+    if (left == right)
+        return 0;
+    return left < right ? -1 : 1;
+}
+
+/*!
+    \class QIviQueryEvaluator
+    \inmodule QtIviCore
+    \brief The QIviQueryEvaluator class filters and sorts items in memory according to a query.
+
+    Backends which hold their data in memory can use a QIviQueryEvaluator to support the
+    \l{Qt IVI Query Language} without translating the query terms themselves.
+
+    The evaluator is created for a QIviQuery and the QMetaObject of the gadget which is used for
+    the items, e.g. in the setupQuery() function of a backend. The query is compiled
+    into a flat program once: all identifiers are resolved to properties of the gadget, the
+    values are converted to the type of the property and wildcard patterns are prepared. The
+    program is then evaluated for every item, which only needs to read the properties.
+
+    \code
+    void MyBackend::setupQuery(const QUuid &identifier, const QIviQuery &query)
+    {
+        m_evaluators.insert(identifier, QIviQueryEvaluator(query, &MyItem::staticMetaObject));
+    }
+
+    void MyBackend::fetchData(const QUuid &identifier, int start, int count)
+    {
+        const QVariantList items = m_evaluators.value(identifier).apply(m_items);
+        emit countChanged(identifier, items.count());
+        emit dataFetched(identifier, items.mid(start, count), start, start + count < items.count());
+    }
+    \endcode
+
+    Strings are compared case-sensitive, besides for the \c{~=} operator. A \c{*} inside a string
+    value matches any number of characters.
+
+    Lists with at least parallelThreshold() items are evaluated by multiple threads of the global
+    QThreadPool.
+
+    A QIviQueryEvaluator is implicitly shared and all const functions can be called from any
+    thread.
+*/
+
+/*!
+    Constructs an invalid evaluator.
+*/
+QIviQueryEvaluator::QIviQueryEvaluator()
+    : d(new QIviQueryEvaluatorPrivate)
+{
+}
+
+/*!
+    Constructs an evaluator for the \a query and the items described by \a metaObject.
+
+    If the query uses an identifier which is not a readable property of \a metaObject, the
+    evaluator is invalid and errorString() describes the problem.
+*/
+QIviQueryEvaluator::QIviQueryEvaluator(const QIviQuery &query, const QMetaObject *metaObject)
+    : d(new QIviQueryEvaluatorPrivate)
+{
+    d->m_metaObject = metaObject;
+    if (!metaObject) {
+        d->m_errorString = QStringLiteral("No meta object provided");
+        return;
+    }
+
+    if ((query.term() && !d->compile(query.term())) || !d->compileOrder(query.orderTerms())) {
+        d->m_program.clear();
+        d->m_order.clear();
+    }
+}
+
+QIviQueryEvaluator::QIviQueryEvaluator(const QIviQueryEvaluator &other)
+    : d(other.d)
+{
+}
+
+QIviQueryEvaluator::~QIviQueryEvaluator()
+{
+}
+
+QIviQueryEvaluator &QIviQueryEvaluator::operator=(const QIviQueryEvaluator &other)
+{
+    d = other.d;
+    return *this;
+}
+
+/*!
+    Returns \c true if the query could be compiled for the meta object.
+*/
+bool QIviQueryEvaluator::isValid() const
+{
+    return d->m_metaObject && d->m_errorString.isEmpty();
+}
+
+/*!
+    Returns the reason why the query couldn't be compiled.
+*/
+QString QIviQueryEvaluator::errorString() const
+{
+    return d->m_errorString;
+}
+
+/*!
+    Returns \c true if the query filters the items.
+*/
+bool QIviQueryEvaluator::hasFilter() const
+{
+    return !d->m_program.isEmpty();
+}
+
+/*!
+    Returns \c true if the query defines the order of the items.
+*/
+bool QIviQueryEvaluator::hasOrder() const
+{
+    return !d->m_order.isEmpty();
+}
+
+/*!
+    Returns the number of items from which on evaluate() and apply() use multiple threads.
+
+    The default is 10000.
+*/
+int QIviQueryEvaluator::parallelThreshold() const
+{
+    return d->m_parallelThreshold;
+}
+
+/*!
+    Sets the number of items from which on evaluate() and apply() use multiple threads to
+    \a threshold. A value of \c 0 or less disables the usage of multiple threads.
+*/
+void QIviQueryEvaluator::setParallelThreshold(int threshold)
+{
+    d->m_parallelThreshold = threshold;
+}
+
+/*!
+    Returns \c true if \a item matches the filter of the query.
+
+    \a item needs to hold a gadget of the type the evaluator was created for, or a type derived
+    from it. Other items never match, and neither do items of an invalid evaluator.
+*/
+bool QIviQueryEvaluator::matches(const QVariant &item) const
+{
+    if (!isValid() || !d->isCompatible(item.userType()))
+        return false;
+    return d->matches(item.constData());
+}
+
+/*!
+    Returns \c true if \a left needs to be sorted before \a right according to the order terms
+    of the query.
+*/
+bool QIviQueryEvaluator::lessThan(const QVariant &left, const QVariant &right) const
+{
+    if (!hasOrder() || !d->isCompatible(left.userType()) || !d->isCompatible(right.userType()))
+        return false;
+
+    QVarLengthArray<QVariant, 8> keys(d->m_order.count() * 2);
+    d->readKeys(left.constData(), keys.data());
+    d->readKeys(right.constData(), keys.data() + d->m_order.count());
+    return d->compareKeys(keys.constData(), keys.constData() + d->m_order.count()) < 0;
+}
+
+/*!
+    Returns the indexes of all \a items which match the filter, in the order defined by the
+    query. Items with the same sort keys keep their relative order.
+
+    \sa apply()
+*/
+QVector<int> QIviQueryEvaluator::evaluate(const QVariantList &items) const
+{
+    if (!isValid())
+        return QVector<int>();
+
+    const int count = items.count();
+    const int chunks = chunkCount(count, d->m_parallelThreshold);
+    const QIviQueryEvaluatorPrivate *dd = d.constData();
+
+    //1. Filter: every chunk collects the matching indexes on its own
+    QVector<QVector<int>> chunkResults(chunks);
+    QVector<int> *results = chunkResults.data();
+    runChunks(chunks, count, [dd, &items, results](int chunk, int begin, int end) {
+        QVector<int> &result = results[chunk];
+        result.reserve(end - begin);
+        int lastType = QMetaType::UnknownType;
+        bool lastCompatible = false;
+        for (int i = begin; i < end; ++i) {
+            const QVariant &item = items.at(i);
+            if (item.userType() != lastType) {
+                lastType = item.userType();
+                lastCompatible = dd->isCompatible(lastType);
+            }
+            if (lastCompatible && dd->matches(item.constData()))
+                result.append(i);
+        }
+    });
+
+    QVector<int> indexes;
+    if (chunks == 1) {
+        indexes = chunkResults.at(0);
+    } else {
+        for (const QVector<int> &result : qAsConst(chunkResults))
+            indexes += result;
+    }
+
+    if (d->m_order.isEmpty() || indexes.count() < 2)
+        return indexes;
+
+    //2. Sort: the keys are read only once per item, every chunk is sorted on its own and merged afterwards
+    const int matched = indexes.count();
+    const int keyCount = d->m_order.count();
+    QVector<QVariant> keys(matched * keyCount);
+    QVector<int> positions(matched);
+    std::iota(positions.begin(), positions.end(), 0);
+
+    QVariant *keyData = keys.data();
+    int *positionData = positions.data();
+    const int *indexData = indexes.constData();
+    auto keyLessThan = [dd, keyData, keyCount](int left, int right) {
+        return dd->compareKeys(keyData + left * keyCount, keyData + right * keyCount) < 0;
+    };
+
+    const int sortChunks = chunkCount(matched, d->m_parallelThreshold);
+    runChunks(sortChunks, matched, [&](int, int begin, int end) {
+        for (int i = begin; i < end; ++i)
+            dd->readKeys(items.at(indexData[i]).constData(), keyData + i * keyCount);
+        std::stable_sort(positionData + begin, positionData + end, keyLessThan);
+    });
+    for (int chunk = 1; chunk < sortChunks; ++chunk) {
+        std::inplace_merge(positionData, positionData + chunkBegin(chunk, sortChunks, matched),
+                           positionData + chunkBegin(chunk + 1, sortChunks, matched), keyLessThan);
+    }
+
+    QVector<int> sorted;
+    sorted.reserve(matched);
+    for (int position : qAsConst(positions))
+        sorted.append(indexData[position]);
+    return sorted;
+}
+
+/*!
+    Returns all \a items which match the filter, in the order defined by the query.
+
+    \sa evaluate()
+*/
+QVariantList QIviQueryEvaluator::apply(const QVariantList &items) const
+{
+    const QVector<int> indexes = evaluate(items);
+    if (indexes.count() == items.count() && !hasOrder())
+        return items;
+
+    QVariantList result;
+    result.reserve(indexes.count());
+    for (int index : indexes)
+        result.append(items.at(index));
+    return result;
+}
+
+QT_END_NAMESPACE
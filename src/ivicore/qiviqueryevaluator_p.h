@@ -0,0 +1,117 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 Luxoft Sweden AB
+** Copyright (C) 2018 Pelagicore AG
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtIvi module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL-QTAS$
+** Commercial License Usage
+** Licensees holding valid commercial Qt Automotive Suite licenses may use
+** this file in accordance with the commercial license agreement provided
+** with the Software or, alternatively, in accordance with the terms
+** contained in a written agreement between you and The Qt Company.  For
+** licensing terms and conditions see https://www.qt.io/terms-conditions.
+** For further information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+** SPDX-License-Identifier: LGPL-3.0
+**
+****************************************************************************/
+
+#ifndef QIVIQUERYEVALUATOR_P_H
+#define QIVIQUERYEVALUATOR_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/QMetaProperty>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QSharedData>
+#include <QtCore/QVector>
+#include <private/qtiviglobal_p.h>
+
+#include "qiviqueryevaluator.h"
+
+QT_BEGIN_NAMESPACE
+
+class Q_QTIVICORE_EXPORT QIviQueryEvaluatorPrivate : public QSharedData
+{
+public:
+    // A single step of the filter program. The program is stored in postfix order, the
+    // conjunctions combine the results of the previous operandCount steps.
+    struct Instruction {
+        enum Code {
+            Filter,
+            And,
+            Or,
+            Not
+        };
+
+        Code code = Filter;
+        int operandCount = 0;
+        QMetaProperty property;
+        QIviFilterTerm::Operator op = QIviFilterTerm::Equals;
+        QVariant value;
+        QRegularExpression pattern;
+        bool negated = false;
+    };
+
+    struct OrderKey {
+        QMetaProperty property;
+        bool ascending;
+    };
+
+    QIviQueryEvaluatorPrivate();
+
+    bool compile(const QIviAbstractQueryTerm *term);
+    bool compileOrder(const QList<QIviOrderTerm> &orderTerms);
+    QMetaProperty resolveProperty(const QString &name);
+
+    bool isCompatible(int userType) const;
+    bool matches(const void *gadget) const;
+    bool filterMatches(const Instruction &instruction, const void *gadget) const;
+    void readKeys(const void *gadget, QVariant *keys) const;
+    int compareKeys(const QVariant *left, const QVariant *right) const;
+
+    static int compareValues(const QVariant &left, const QVariant &right, Qt::CaseSensitivity cs);
+
+    const QMetaObject *m_metaObject;
+    QVector<Instruction> m_program;
+    QVector<OrderKey> m_order;
+    QString m_errorString;
+    int m_parallelThreshold;
+};
+
+QT_END_NAMESPACE
+
+#endif // QIVIQUERYEVALUATOR_P_H
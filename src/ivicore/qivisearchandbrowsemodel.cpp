@@ -44,25 +44,253 @@
 #include "qivisearchandbrowsemodel_p.h"
 
 #include "qiviqmlconversion_helper.h"
+#include "qiviqueryevaluator.h"
 #include "qivisearchandbrowsemodelinterface.h"
 #include "queryparser/qiviqueryparser_p.h"
 
+#include <QCache>
 #include <QDebug>
 #include <QMetaObject>
+#include <QMutex>
+#include <QPointer>
+#include <QRunnable>
+#include <QThreadPool>
+
+#include <algorithm>
 
 QT_BEGIN_NAMESPACE
 
+namespace qtivi_helper {
+    // Number of rows requested at once while loading all rows for the local query
+    static const int localQueryChunkSize = 1000;
+
+    struct ParsedQuery {
+        QIviQuery query;
+        QString errorString;
+    };
+
+    // Parsed queries are immutable and can be shared by all models, e.g. while typing the same
+    // search string again or when several views show the same content.
+    struct QueryCache {
+        QMutex mutex;
+        QCache<QString, ParsedQuery> queries;
+    };
+    Q_GLOBAL_STATIC(QueryCache, queryCache)
+
+    static bool isNumber(const QVariant &value)
+    {
+        switch (value.userType()) {
+        case QMetaType::Int:
+        case QMetaType::UInt:
+        case QMetaType::LongLong:
+        case QMetaType::ULongLong:
+        case QMetaType::Double:
+        case QMetaType::Float:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Returns the part of a string value which every match needs to start with
+    static QString literalPrefix(const QString &value)
+    {
+        const int index = value.indexOf(QLatin1Char('*'));
+        return index == -1 ? value : value.left(index);
+    }
+
+    static bool filterImplies(const QIviFilterTerm *filter, const QIviFilterTerm *other)
+    {
+        if (filter->propertyName() != other->propertyName() || filter->isNegated() || other->isNegated())
+            return false;
+
+        const QVariant value = filter->value();
+        const QVariant otherValue = other->value();
+        const QIviFilterTerm::Operator op = filter->operatorType();
+
+        switch (other->operatorType()) {
+        case QIviFilterTerm::Equals:
+        case QIviFilterTerm::EqualsCaseInsensitive: {
+            //Only a pattern like 'Ab*' can be narrowed, by anything which starts with 'Ab'
+            const QString otherString = otherValue.toString();
+            if (otherValue.userType() != QMetaType::QString || value.userType() != QMetaType::QString
+                    || otherString.indexOf(QLatin1Char('*')) != otherString.length() - 1) {
+                return false;
+            }
+            const bool caseInsensitive = other->operatorType() == QIviFilterTerm::EqualsCaseInsensitive;
+            if (op != QIviFilterTerm::Equals && !(caseInsensitive && op == QIviFilterTerm::EqualsCaseInsensitive))
+                return false;
+            return literalPrefix(value.toString()).startsWith(otherString.left(otherString.length() - 1),
+                                                              caseInsensitive ? Qt::CaseInsensitive : Qt::CaseSensitive);
+        }
+        case QIviFilterTerm::GreaterThan:
+        case QIviFilterTerm::GreaterEquals:
+            if (!isNumber(value) || !isNumber(otherValue))
+                return false;
+            if (op == QIviFilterTerm::GreaterThan)
+                return value.toDouble() >= otherValue.toDouble();
+            if (op == QIviFilterTerm::GreaterEquals && other->operatorType() == QIviFilterTerm::GreaterThan)
+                return value.toDouble() > otherValue.toDouble();
+            return op == QIviFilterTerm::GreaterEquals && value.toDouble() >= otherValue.toDouble();
+        case QIviFilterTerm::LowerThan:
+        case QIviFilterTerm::LowerEquals:
+            if (!isNumber(value) || !isNumber(otherValue))
+                return false;
+            if (op == QIviFilterTerm::LowerThan)
+                return value.toDouble() <= otherValue.toDouble();
+            if (op == QIviFilterTerm::LowerEquals && other->operatorType() == QIviFilterTerm::LowerThan)
+                return value.toDouble() < otherValue.toDouble();
+            return op == QIviFilterTerm::LowerEquals && value.toDouble() <= otherValue.toDouble();
+        default:
+            return false;
+        }
+    }
+
+    // Returns true if every item matching \a term also matches \a other. The check is
+    // conservative, false is returned whenever this can't be decided from the terms alone.
+    static bool termImplies(const QIviAbstractQueryTerm *term, const QIviAbstractQueryTerm *other)
+    {
+        if (!other)
+            return true;
+        if (!term)
+            return false;
+        if (term->toString() == other->toString())
+            return true;
+
+        //Scopes which are not negated don't change the meaning of a term
+        if (other->type() == QIviAbstractQueryTerm::ScopeTerm) {
+            auto *scope = static_cast<const QIviScopeTerm*>(other);
+            return !scope->isNegated() && termImplies(term, scope->term());
+        }
+        if (term->type() == QIviAbstractQueryTerm::ScopeTerm) {
+            auto *scope = static_cast<const QIviScopeTerm*>(term);
+            return !scope->isNegated() && termImplies(scope->term(), other);
+        }
+
+        if (other->type() == QIviAbstractQueryTerm::ConjunctionTerm) {
+            auto *conjunction = static_cast<const QIviConjunctionTerm*>(other);
+            const auto terms = conjunction->terms();
+            if (conjunction->conjunction() == QIviConjunctionTerm::And) {
+                return std::all_of(terms.cbegin(), terms.cend(), [term](const QIviAbstractQueryTerm *t) {
+                    return termImplies(term, t);
+                });
+            }
+            if (std::any_of(terms.cbegin(), terms.cend(), [term](const QIviAbstractQueryTerm *t) { return termImplies(term, t); }))
+                return true;
+        }
+
+        if (term->type() == QIviAbstractQueryTerm::ConjunctionTerm) {
+            auto *conjunction = static_cast<const QIviConjunctionTerm*>(term);
+            const auto terms = conjunction->terms();
+            const auto implies = [other](const QIviAbstractQueryTerm *t) { return termImplies(t, other); };
+            if (conjunction->conjunction() == QIviConjunctionTerm::And)
+                return std::any_of(terms.cbegin(), terms.cend(), implies);
+            return std::all_of(terms.cbegin(), terms.cend(), implies);
+        }
+
+        if (term->type() == QIviAbstractQueryTerm::FilterTerm && other->type() == QIviAbstractQueryTerm::FilterTerm)
+            return filterImplies(static_cast<const QIviFilterTerm*>(term), static_cast<const QIviFilterTerm*>(other));
+
+        return false;
+    }
+
+    // Returns true if \a query only keeps items of \a previous, in the same order
+    static bool queryNarrows(const QIviQuery &query, const QIviQuery &previous)
+    {
+        const QList<QIviOrderTerm> orderTerms = query.orderTerms();
+        const QList<QIviOrderTerm> previousOrderTerms = previous.orderTerms();
+        if (orderTerms.count() != previousOrderTerms.count())
+            return false;
+        for (int i = 0; i < orderTerms.count(); i++) {
+            if (orderTerms.at(i).propertyName() != previousOrderTerms.at(i).propertyName()
+                    || orderTerms.at(i).isAscending() != previousOrderTerms.at(i).isAscending()) {
+                return false;
+            }
+        }
+
+        return termImplies(query.term(), previous.term());
+    }
+}
+
+using namespace qtivi_helper;
+
+namespace {
+// Applies the query of a model to all rows fetched from its backend on a thread of the global
+// thread pool. The resulting permutation is handed back to the model in the thread of the
+// application, unless the model was destroyed in the meantime.
+class QIviLocalQueryRunner : public QRunnable
+{
+public:
+    QIviLocalQueryRunner(QIviSearchAndBrowseModel *model, quint32 generation, const QIviQuery &query, const QVector<QIviPagingModelRow> &rows)
+        : m_model(model)
+        , m_generation(generation)
+        , m_query(query)
+        , m_rows(rows)
+    {}
+
+    void run() override
+    {
+        QVariantList items;
+        items.reserve(m_rows.count());
+        for (const QIviPagingModelRow &row : qAsConst(m_rows))
+            items.append(row.toVariant());
+
+        QVector<int> permutation;
+        QString errorString;
+        if (!items.isEmpty()) {
+            //All rows of a content type share the same type, the first one defines the usable properties
+            const QMetaObject *metaObject = QMetaType::metaObjectForType(items.first().userType());
+            QIviQueryEvaluator evaluator;
+            if (metaObject)
+                evaluator = QIviQueryEvaluator(m_query, metaObject);
+
+            if (evaluator.isValid()) {
+                permutation = evaluator.evaluate(items);
+            } else {
+                errorString = metaObject ? evaluator.errorString()
+                                         : QStringLiteral("The query can't be applied locally, as the items are not gadgets");
+                //Show the content unfiltered instead of an empty model
+                permutation.reserve(items.count());
+                for (int i = 0; i < items.count(); i++)
+                    permutation.append(i);
+            }
+        }
+
+        //The invocation is dropped if the model is destroyed before it is delivered
+        QIviSearchAndBrowseModel *model = m_model.data();
+        if (!model)
+            return;
+        const quint32 generation = m_generation;
+        QMetaObject::invokeMethod(model, [model, generation, permutation, errorString]() {
+            auto *d = static_cast<QIviSearchAndBrowseModelPrivate *>(QObjectPrivate::get(model));
+            d->onLocalQueryEvaluated(generation, permutation, errorString);
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    QPointer<QIviSearchAndBrowseModel> m_model;
+    quint32 m_generation;
+    QIviQuery m_query;
+    QVector<QIviPagingModelRow> m_rows;
+};
+} // unnamed namespace
+
 QIviSearchAndBrowseModelPrivate::QIviSearchAndBrowseModelPrivate(const QString &interface, QIviSearchAndBrowseModel *model)
     : QIviPagingModelPrivate(interface, model)
     , q_ptr(model)
-    , m_queryTerm(nullptr)
+    , m_localQueryFallback(false)
+    , m_localQueryActive(false)
+    , m_sourceRowsComplete(false)
+    , m_localQueryEvaluating(false)
+    , m_localQueryGeneration(0)
+    , m_incrementalQuery(false)
+    , m_pendingRefines(0)
     , m_canGoBack(false)
 {
 }
 
 QIviSearchAndBrowseModelPrivate::~QIviSearchAndBrowseModelPrivate()
 {
-    delete m_queryTerm;
 }
 
 void QIviSearchAndBrowseModelPrivate::resetModel()
@@ -76,6 +304,14 @@ void QIviSearchAndBrowseModelPrivate::resetModel()
     if (backend)
         backend->setContentType(m_identifier, m_contentType);
 
+    //Results of a local query which is still evaluated are outdated now
+    m_localQueryGeneration++;
+    m_sourceRows.clear();
+    m_permutation.clear();
+    m_sourceRowsComplete = false;
+    m_localQueryEvaluating = false;
+    m_pendingRefines = 0;
+
     parseQuery();
 
     QIviPagingModelPrivate::resetModel();
@@ -83,49 +319,403 @@ void QIviSearchAndBrowseModelPrivate::resetModel()
 
 void QIviSearchAndBrowseModelPrivate::parseQuery()
 {
+    m_localQueryActive = false;
+    m_localQuery = QIviQuery();
+
     if (!searchBackend())
         return;
 
     if (m_query.isEmpty()) {
-        //The new query is empty, tell it to the backend and delete the old term
-        setupFilter(nullptr, {});
+        //The new query is empty, tell it to the backend and release the old one
+        setupQuery(QIviQuery());
         return;
     }
 
-    if (!m_capabilities.testFlag(QtIviCoreModule::SupportsFiltering) && !m_capabilities.testFlag(QtIviCoreModule::SupportsSorting)) {
+    if (!m_capabilities.testFlag(QtIviCoreModule::SupportsFiltering) && !m_capabilities.testFlag(QtIviCoreModule::SupportsSorting)
+            && !m_localQueryFallback) {
         qtivi_qmlOrCppWarning(q_ptr, QStringLiteral("The backend doesn't support filtering or sorting. Changing the query will have no effect"));
         return;
     }
 
+    QString errorString;
+    const QIviQuery query = cachedQuery(m_query, &errorString);
+    if (query.isEmpty()) {
+        qtivi_qmlOrCppWarning(q_ptr, errorString);
+        return;
+    }
+
+    //The backend only delivers all rows, the query is applied by the model itself
+    if (needsLocalQuery(query)) {
+        m_localQueryActive = true;
+        m_localQuery = query;
+        setupQuery(QIviQuery());
+        return;
+    }
+
+    setupQuery(query);
+}
+
+/*
+    Returns the parsed \a query for the current content type, or an empty query and the parser
+    error in \a errorString. The result is cached for the query and the identifiers the backend
+    supports, as the query changes with every key stroke while searching.
+*/
+QIviQuery QIviSearchAndBrowseModelPrivate::cachedQuery(const QString &query, QString *errorString) const
+{
+    const QSet<QString> identifiers = searchBackend()->supportedIdentifiers(m_contentType);
+    QStringList sortedIdentifiers = identifiers.toList();
+    std::sort(sortedIdentifiers.begin(), sortedIdentifiers.end());
+    const QString key = sortedIdentifiers.join(QLatin1Char(',')) + QLatin1Char('\n') + query;
+
+    QueryCache *cache = queryCache();
+    QMutexLocker locker(&cache->mutex);
+    if (ParsedQuery *parsed = cache->queries.object(key)) {
+        *errorString = parsed->errorString;
+        return parsed->query;
+    }
+
     QIviQueryParser parser;
-    parser.setQuery(m_query);
-    parser.setAllowedIdentifiers(searchBackend()->supportedIdentifiers(m_contentType));
+    parser.setQuery(query);
+    parser.setAllowedIdentifiers(identifiers);
+
+    auto *parsed = new ParsedQuery;
+    QIviAbstractQueryTerm *queryTerm = parser.parse();
+    if (queryTerm)
+        parsed->query = QIviQuery(queryTerm, parser.orderTerms());
+    else
+        parsed->errorString = parser.lastError();
+
+    *errorString = parsed->errorString;
+    const QIviQuery result = parsed->query;
+    cache->queries.insert(key, parsed);
+    return result;
+}
+
+bool QIviSearchAndBrowseModelPrivate::needsLocalQuery(const QIviQuery &query) const
+{
+    if (!m_localQueryFallback)
+        return false;
+
+    return (query.term() && !m_capabilities.testFlag(QtIviCoreModule::SupportsFiltering))
+            || (!query.orderTerms().isEmpty() && !m_capabilities.testFlag(QtIviCoreModule::SupportsSorting));
+}
+
+void QIviSearchAndBrowseModelPrivate::setupQuery(const QIviQuery &query)
+{
+    //1. Tell the backend about the new query (or none), it can keep a copy as long as it needs it
+    //The function is looked up by name to keep QIviSearchAndBrowseModelInterface binary compatible
+    QIviSearchAndBrowseModelInterface* backend = searchBackend();
+    if (backend) {
+        const QMetaObject *mo = backend->metaObject();
+        const int setupQueryIndex = mo->indexOfMethod("setupQuery(QUuid,QIviQuery)");
+        if (setupQueryIndex != -1) {
+            mo->method(setupQueryIndex).invoke(backend, Qt::DirectConnection,
+                                               Q_ARG(QUuid, m_identifier), Q_ARG(QIviQuery, query));
+        } else {
+            //The terms are immutable, the non-const pointer is only kept for compatibility
+            backend->setupFilter(m_identifier, const_cast<QIviAbstractQueryTerm*>(query.term()), query.orderTerms());
+        }
+    }
+
+    //The continuation tokens of the backend refer to the rows of the previous query
+    m_continuationTokens.clear();
+
+    //2. Release the old query, it is only deleted if no backend holds a copy anymore
+    m_parsedQuery = query;
+}
+
+/*
+    Applies the changed query to the rows which are already loaded, if it only keeps rows of the
+    previous query in the same order. The rows which don't match anymore are removed from the
+    model instead of resetting it.
+
+    As the remaining rows are the beginning of the new result, the backend doesn't need to run
+    the query from scratch: all remaining rows, but at least one chunk, are fetched again in the
+    background to verify them and further rows are fetched from where the model ends.
+
+    Returns false if the model needs to be reset instead.
+*/
+bool QIviSearchAndBrowseModelPrivate::refineQuery()
+{
+    QIviSearchAndBrowseModelInterface *backend = searchBackend();
+    expirePendingRequests();
+    if (!backend || m_query.isEmpty() || m_loadingType != QIviPagingModel::FetchMore || !m_pendingRequests.isEmpty())
+        return false;
+
+    QString errorString;
+    const QIviQuery query = cachedQuery(m_query, &errorString);
+    if (query.isEmpty())
+        return false;
+
+    const bool local = needsLocalQuery(query);
+    if (local != m_localQueryActive)
+        return false;
+
+    if (local) {
+        if (!m_sourceRowsComplete || m_localQueryEvaluating || !queryNarrows(query, m_localQuery))
+            return false;
+    } else if (!m_capabilities.testFlag(QtIviCoreModule::SupportsFiltering) || !queryNarrows(query, m_parsedQuery)) {
+        return false;
+    }
+
+    QIviQueryEvaluator evaluator;
+    if (!m_itemList.isEmpty()) {
+        const QMetaObject *metaObject = QMetaType::metaObjectForType(m_itemList.first().toVariant().userType());
+        if (!metaObject)
+            return false;
+        evaluator = QIviQueryEvaluator(query, metaObject);
+        if (!evaluator.isValid())
+            return false;
+    }
+
+    Q_Q(QIviSearchAndBrowseModel);
+    //Remove the rows which don't match anymore from the back, to keep the indexes valid
+    int end = m_itemList.count();
+    while (end > 0) {
+        if (evaluator.matches(m_itemList.at(end - 1).toVariant())) {
+            end--;
+            continue;
+        }
+        int begin = end - 1;
+        while (begin > 0 && !evaluator.matches(m_itemList.at(begin - 1).toVariant()))
+            begin--;
+
+        q->beginRemoveRows(QModelIndex(), begin, end - 1);
+        m_itemList.remove(begin, end - begin);
+        if (local)
+            m_permutation.remove(begin, end - begin);
+        q->endRemoveRows();
+        end = begin;
+    }
 
-    QIviAbstractQueryTerm* queryTerm = parser.parse();
+    m_fetchedDataCount = m_itemList.count();
 
-    if (!queryTerm) {
-        qtivi_qmlOrCppWarning(q_ptr, parser.lastError());
+    if (local) {
+        //All rows are known already, the backend is not involved at all
+        m_localQuery = query;
+        return true;
+    }
+
+    setupQuery(query);
+    m_moreAvailable = false;
+    m_pendingRefines++;
+    backend->fetchData(m_identifier, 0, qMax(m_chunkSize, m_itemList.count()));
+    return true;
+}
+
+/*
+    Compares the rows of the refined query, as delivered by the backend, with the rows which were
+    filtered locally. The model is reset if the backend disagrees or didn't deliver all of them.
+*/
+void QIviSearchAndBrowseModelPrivate::verifyRefinedRows(const QVector<QIviPagingModelRow> &items, bool moreAvailable)
+{
+    const int localCount = m_itemList.count();
+    bool consistent = items.count() >= localCount;
+    for (int i = 0; consistent && i < localCount; i++) {
+        const QIviStandardItem *item = itemOf(items.at(i));
+        const QIviStandardItem *localItem = itemAt(i);
+        consistent = item && localItem && item->id() == localItem->id();
+    }
+
+    if (!consistent) {
+        resetModel();
         return;
     }
-    QList<QIviOrderTerm> orderTerms = parser.orderTerms();
 
-    setupFilter(queryTerm, orderTerms);
+    Q_Q(QIviSearchAndBrowseModel);
+    if (items.count() > localCount) {
+        q->beginInsertRows(QModelIndex(), localCount, items.count() - 1);
+        m_itemList += items.mid(localCount);
+        q->endInsertRows();
+    }
+    m_fetchedDataCount = m_itemList.count();
+    m_moreAvailable = moreAvailable;
 }
 
-void QIviSearchAndBrowseModelPrivate::setupFilter(QIviAbstractQueryTerm* queryTerm, const QList<QIviOrderTerm> &orderTerms)
+void QIviSearchAndBrowseModelPrivate::fetchData(int startIndex)
 {
-    //1. Tell the backend about the new filter (or none)
-    QIviSearchAndBrowseModelInterface* backend = searchBackend();
-    if (backend)
-        backend->setupFilter(m_identifier, queryTerm, orderTerms);
+    if (!m_localQueryActive) {
+        QIviPagingModelPrivate::fetchData(startIndex);
+        return;
+    }
+
+    //The rows are published once all of them are known, the view never requests rows on its own
+    m_moreAvailable = false;
+    if (!backend() || m_sourceRowsComplete)
+        return;
+
+    requestData(m_sourceRows.count(), qMax(m_chunkSize, localQueryChunkSize));
+}
+
+void QIviSearchAndBrowseModelPrivate::handleDataFetched(const QUuid &identifier, const QVector<QIviPagingModelRow> &items, int start, bool moreAvailable)
+{
+    //Only the answer for the latest refined query is checked, the ones before are outdated already
+    if (m_pendingRefines > 0 && start == 0) {
+        if (--m_pendingRefines == 0)
+            verifyRefinedRows(items, moreAvailable);
+        return;
+    }
+
+    if (!m_localQueryActive) {
+        QIviPagingModelPrivate::handleDataFetched(identifier, items, start, moreAvailable);
+        return;
+    }
+
+    //Drop chunks which have been requested before the model was reset
+    if (m_sourceRowsComplete || start != m_sourceRows.count())
+        return;
+
+    m_sourceRows += items;
+    if (moreAvailable && !items.isEmpty()) {
+        fetchData(-1);
+        return;
+    }
+
+    m_sourceRowsComplete = true;
+    evaluateLocalQuery();
+}
+
+void QIviSearchAndBrowseModelPrivate::onCountChanged(const QUuid &identifier, int new_length)
+{
+    //The count of the backend doesn't match the filtered content, which is only known after evaluating the query
+    if (m_localQueryActive)
+        return;
+
+    QIviPagingModelPrivate::onCountChanged(identifier, new_length);
+}
+
+void QIviSearchAndBrowseModelPrivate::handleDataChanged(const QVector<QIviPagingModelRow> &data, int start, int count)
+{
+    if (!m_localQueryActive) {
+        QIviPagingModelPrivate::handleDataChanged(data, start, count);
+        return;
+    }
+
+    if (start < 0 || start > m_sourceRows.count()) {
+        qWarning("provided start argument is out of range");
+        return;
+    }
+
+    if (count < 0 || count > m_sourceRows.count() - start) {
+        qWarning("provided count argument is out of range");
+        return;
+    }
+
+    //The indexes of the backend refer to the unfiltered rows, the query needs to be applied again.
+    //The replaced rows vanish right away, the new rows are inserted once the query was applied.
+    Q_Q(QIviSearchAndBrowseModel);
+    const auto replaced = [start, count](int index) { return index >= start && index < start + count; };
+    int row = m_permutation.count() - 1;
+    while (row >= 0) {
+        if (!replaced(m_permutation.at(row))) {
+            row--;
+            continue;
+        }
+        const int last = row;
+        while (row > 0 && replaced(m_permutation.at(row - 1)))
+            row--;
+
+        q->beginRemoveRows(QModelIndex(), row, last);
+        m_itemList.remove(row, last - row + 1);
+        m_permutation.remove(row, last - row + 1);
+        q->endRemoveRows();
+        row--;
+    }
+    const int delta = data.count() - count;
+    for (int &index : m_permutation) {
+        if (index >= start + count)
+            index += delta;
+    }
+    m_fetchedDataCount = m_itemList.count();
+
+    m_continuationTokens.clear();
+    m_sourceRows = m_sourceRows.mid(0, start) + data + m_sourceRows.mid(start + count);
+    if (m_sourceRowsComplete)
+        evaluateLocalQuery();
+}
+
+void QIviSearchAndBrowseModelPrivate::evaluateLocalQuery()
+{
+    Q_Q(QIviSearchAndBrowseModel);
+    m_localQueryEvaluating = true;
+    QThreadPool::globalInstance()->start(new QIviLocalQueryRunner(q, ++m_localQueryGeneration, m_localQuery, m_sourceRows));
+}
+
+void QIviSearchAndBrowseModelPrivate::onLocalQueryEvaluated(quint32 generation, const QVector<int> &permutation, const QString &errorString)
+{
+    if (generation != m_localQueryGeneration || !m_localQueryActive)
+        return;
+
+    m_localQueryEvaluating = false;
+
+    if (!errorString.isEmpty())
+        qtivi_qmlOrCppWarning(q_ptr, errorString);
+
+    //The rows which are shown already keep their order, as they are sorted by the same query.
+    //In this case only the new rows need to be inserted, otherwise the model is reset.
+    int shown = 0;
+    for (int i = 0; i < permutation.count() && shown < m_permutation.count(); i++) {
+        if (permutation.at(i) == m_permutation.at(shown))
+            shown++;
+    }
+
+    Q_Q(QIviSearchAndBrowseModel);
+    if (shown == m_permutation.count()) {
+        int row = 0;
+        while (row < permutation.count()) {
+            if (row < m_permutation.count() && m_permutation.at(row) == permutation.at(row)) {
+                row++;
+                continue;
+            }
+
+            int end = row + 1;
+            while (end < permutation.count() && (row >= m_permutation.count() || permutation.at(end) != m_permutation.at(row)))
+                end++;
+
+            QVector<QIviPagingModelRow> rows;
+            rows.reserve(end - row);
+            for (int i = row; i < end; i++)
+                rows.append(m_sourceRows.at(permutation.at(i)));
+
+            q->beginInsertRows(QModelIndex(), row, end - 1);
+            m_itemList = m_itemList.mid(0, row) + rows + m_itemList.mid(row);
+            m_permutation = m_permutation.mid(0, row) + permutation.mid(row, end - row) + m_permutation.mid(row);
+            m_fetchedDataCount = m_itemList.count();
+            //All rows are in memory, data() must not request any chunk from the backend
+            m_availableChunks.fill(true, m_itemList.count() / m_chunkSize + 1);
+            q->endInsertRows();
+            row = end;
+        }
+        m_moreAvailable = false;
+        clearResidentChunks();
+        return;
+    }
+
+    QVector<QIviPagingModelRow> rows;
+    rows.reserve(permutation.count());
+    for (int index : permutation)
+        rows.append(m_sourceRows.at(index));
+
+    q->beginResetModel();
+    m_permutation = permutation;
+    m_itemList = rows;
+    m_fetchedDataCount = m_itemList.count();
+    m_moreAvailable = false;
+    m_availableChunks.fill(true, m_itemList.count() / m_chunkSize + 1);
+    clearResidentChunks();
+    q->endResetModel();
+}
 
-    //2. Now it's safe to delete the old filter
-    delete m_queryTerm;
-    m_queryTerm = nullptr;
+/*
+    Maps the \a row of the model to the index of the item in the backend, which differs if the
+    query is applied locally. Rows past the end are mapped past the end of the backend's rows.
+*/
+int QIviSearchAndBrowseModelPrivate::sourceIndex(int row) const
+{
+    if (!m_localQueryActive || row < 0)
+        return row;
 
-    //3. Save the new filter
-    m_queryTerm = queryTerm;
-    m_orderTerms = orderTerms;
+    return row < m_permutation.count() ? m_permutation.at(row) : m_sourceRows.count();
 }
 
 void QIviSearchAndBrowseModelPrivate::checkType()
@@ -145,8 +735,15 @@ void QIviSearchAndBrowseModelPrivate::clearToDefaults()
 {
     QIviPagingModelPrivate::clearToDefaults();
 
-    delete m_queryTerm;
-    m_queryTerm = nullptr;
+    m_parsedQuery = QIviQuery();
+    m_localQueryActive = false;
+    m_localQuery = QIviQuery();
+    m_sourceRows.clear();
+    m_permutation.clear();
+    m_sourceRowsComplete = false;
+    m_localQueryEvaluating = false;
+    m_localQueryGeneration++;
+    m_pendingRefines = 0;
     m_contentType = QString();
     m_canGoBack = false;
     m_availableContentTypes.clear();
@@ -240,6 +837,9 @@ void QIviSearchAndBrowseModelPrivate::updateContentType(const QString &contentTy
     Filtering and sorting can also be combined in one string and the filter part can also be more complex. More on that
     can be found in the detailed \l {Qt IVI Query Language} Documentation.
 
+    If the backend doesn't support filtering or sorting, the \l {QIviSearchAndBrowseModel::}{localQueryFallback}
+    property can be used to let the model fetch all rows and apply the query on its own.
+
     \section1 Browsing
     \target Browsing
 
@@ -388,6 +988,9 @@ void QIviSearchAndBrowseModelPrivate::updateContentType(const QString &contentTy
     Filtering and sorting can also be combined in one string and the filter part can also be more complex. More on that
     can be found in the detailed \l {Qt IVI Query Language} Documentation.
 
+    If the backend doesn't support filtering or sorting, the \l {SearchAndBrowseModel::}{localQueryFallback}
+    property can be used to let the model fetch all rows and apply the query on its own.
+
     \section1 Browsing
     \target Browsing
 
@@ -468,7 +1071,8 @@ QIviSearchAndBrowseModel::QIviSearchAndBrowseModel(QObject *parent)
     \qmlproperty string SearchAndBrowseModel::query
     \brief Holds the current query used for filtering and sorting the current content of the model.
 
-    \note When changing this property the content will be reset.
+    \note When changing this property the content will be reset, unless incrementalQuery is enabled
+    and the new query only narrows the previous one.
 
     See \l {Qt IVI Query Language} for more information.
     \sa FilteringAndSorting
@@ -478,7 +1082,8 @@ QIviSearchAndBrowseModel::QIviSearchAndBrowseModel(QObject *parent)
     \property QIviSearchAndBrowseModel::query
     \brief Holds the current query used for filtering and sorting the current content of the model.
 
-    \note When changing this property the content will be reset.
+    \note When changing this property the content will be reset, unless incrementalQuery is enabled
+    and the new query only narrows the previous one.
 
     See \l {Qt IVI Query Language} for more information.
     \sa FilteringAndSorting
@@ -500,6 +1105,9 @@ void QIviSearchAndBrowseModel::setQuery(const QString &query)
     d->m_query = query;
     emit queryChanged(d->m_query);
 
+    if (d->m_incrementalQuery && d->refineQuery())
+        return;
+
     //The query is checked in resetModel
     d->resetModel();
 }
@@ -574,6 +1182,101 @@ bool QIviSearchAndBrowseModel::canGoBack() const
     return d->m_canGoBack;
 }
 
+/*!
+    \qmlproperty bool SearchAndBrowseModel::localQueryFallback
+    \brief Holds whether the query is applied by the model if the backend doesn't support it.
+
+    By default this property is \c false and a query which needs filtering or sorting the backend
+    doesn't support has no effect. If set to \c true, the model fetches all rows of the content
+    type from the backend instead and filters and sorts them on its own. The rows are shown once
+    the query has been applied to all of them. The indexes used by insert(), remove(), move() and
+    indexOf() still refer to the rows of the model.
+
+    \note This needs to keep all rows in memory and should only be used if the backend doesn't
+    support the query.
+
+    \sa FilteringAndSorting
+*/
+
+/*!
+    \property QIviSearchAndBrowseModel::localQueryFallback
+    \brief Holds whether the query is applied by the model if the backend doesn't support it.
+
+    By default this property is \c false and a query which needs filtering or sorting the backend
+    doesn't support has no effect. If set to \c true, the model fetches all rows of the content
+    type from the backend instead and filters and sorts them on its own using QIviQueryEvaluator.
+    The rows are shown once the query has been applied to all of them. The indexes used by
+    insert(), remove(), move() and indexOf() still refer to the rows of the model.
+
+    \note This needs to keep all rows in memory and should only be used if the backend doesn't
+    support the query.
+
+    \sa FilteringAndSorting
+*/
+bool QIviSearchAndBrowseModel::localQueryFallback() const
+{
+    Q_D(const QIviSearchAndBrowseModel);
+    return d->m_localQueryFallback;
+}
+
+void QIviSearchAndBrowseModel::setLocalQueryFallback(bool localQueryFallback)
+{
+    Q_D(QIviSearchAndBrowseModel);
+    if (d->m_localQueryFallback == localQueryFallback)
+        return;
+
+    d->m_localQueryFallback = localQueryFallback;
+    emit localQueryFallbackChanged(localQueryFallback);
+
+    if (!d->m_query.isEmpty())
+        d->resetModel();
+}
+
+/*!
+    \qmlproperty bool SearchAndBrowseModel::incrementalQuery
+    \brief Holds whether a changed query is applied to the already loaded rows first.
+
+    This is meant for search fields, which change the query with every key stroke. If the new
+    query only narrows the previous one, e.g. \c{name='Ab*'} is changed to \c{name='Abc*'}, the
+    rows which don't match anymore are removed from the model instead of resetting it. The backend
+    continues with the new query from where the model ends and the rows already shown are
+    verified in the background. In all other cases the model is reset, as without this property.
+
+    This only has an effect if the loadingType is \c FetchMore.
+
+    By default this property is \c false.
+*/
+
+/*!
+    \property QIviSearchAndBrowseModel::incrementalQuery
+    \brief Holds whether a changed query is applied to the already loaded rows first.
+
+    This is meant for search fields, which change the query with every key stroke. If the new
+    query only narrows the previous one, e.g. \c{name='Ab*'} is changed to \c{name='Abc*'}, the
+    rows which don't match anymore are removed from the model instead of resetting it. The backend
+    continues with the new query from where the model ends and the rows already shown are
+    verified in the background. In all other cases the model is reset, as without this property.
+
+    This only has an effect if the loadingType is QIviPagingModel::FetchMore.
+
+    By default this property is \c false.
+*/
+bool QIviSearchAndBrowseModel::incrementalQuery() const
+{
+    Q_D(const QIviSearchAndBrowseModel);
+    return d->m_incrementalQuery;
+}
+
+void QIviSearchAndBrowseModel::setIncrementalQuery(bool incrementalQuery)
+{
+    Q_D(QIviSearchAndBrowseModel);
+    if (d->m_incrementalQuery == incrementalQuery)
+        return;
+
+    d->m_incrementalQuery = incrementalQuery;
+    emit incrementalQueryChanged(incrementalQuery);
+}
+
 /*!
     \reimp
 */
@@ -762,7 +1465,7 @@ QIviPendingReply<void> QIviSearchAndBrowseModel::insert(int index, const QVarian
         return QIviPendingReply<void>::createFailedReply();
     }
 
-    return backend->insert(d->m_identifier, d->m_contentType, index, item);
+    return backend->insert(d->m_identifier, d->m_contentType, d->sourceIndex(index), item);
 }
 
 /*!
@@ -794,7 +1497,7 @@ QIviPendingReply<void> QIviSearchAndBrowseModel::remove(int index)
         return QIviPendingReply<void>::createFailedReply();
     }
 
-    return backend->remove(d->m_identifier, d->m_contentType, index);
+    return backend->remove(d->m_identifier, d->m_contentType, d->sourceIndex(index));
 }
 
 /*!
@@ -826,7 +1529,7 @@ QIviPendingReply<void> QIviSearchAndBrowseModel::move(int cur_index, int new_ind
         return QIviPendingReply<void>::createFailedReply();
     }
 
-    return backend->move(d->m_identifier, d->m_contentType, cur_index, new_index);
+    return backend->move(d->m_identifier, d->m_contentType, d->sourceIndex(cur_index), d->sourceIndex(new_index));
 }
 
 /*!
@@ -857,7 +1560,16 @@ QIviPendingReply<int> QIviSearchAndBrowseModel::indexOf(const QVariant &variant)
         return QIviPendingReply<int>::createFailedReply();
     }
 
-    return backend->indexOf(d->m_identifier, d->m_contentType, item);
+    QIviPendingReply<int> reply = backend->indexOf(d->m_identifier, d->m_contentType, item);
+    if (!d->m_localQueryActive)
+        return reply;
+
+    //The backend reports the index of the unfiltered content, -1 is returned if the query doesn't match the item.
+    //The reply might be resolved in any thread, the continuation only uses a copy of the current permutation.
+    const QVector<int> permutation = d->m_permutation;
+    return reply.then([permutation](int index) {
+        return permutation.indexOf(index);
+    });
 }
 
 /*!
@@ -61,6 +61,8 @@ class Q_QTIVICORE_EXPORT QIviSearchAndBrowseModel : public QIviPagingModel
     Q_PROPERTY(QString contentType READ contentType WRITE setContentType NOTIFY contentTypeChanged)
     Q_PROPERTY(QStringList availableContentTypes READ availableContentTypes NOTIFY availableContentTypesChanged)
     Q_PROPERTY(bool canGoBack READ canGoBack NOTIFY canGoBackChanged)
+    Q_PROPERTY(bool localQueryFallback READ localQueryFallback WRITE setLocalQueryFallback NOTIFY localQueryFallbackChanged)
+    Q_PROPERTY(bool incrementalQuery READ incrementalQuery WRITE setIncrementalQuery NOTIFY incrementalQueryChanged)
 
 public:
 
@@ -88,6 +90,12 @@ public:
 
     bool canGoBack() const;
 
+    bool localQueryFallback() const;
+    void setLocalQueryFallback(bool localQueryFallback);
+
+    bool incrementalQuery() const;
+    void setIncrementalQuery(bool incrementalQuery);
+
     QVariant data(const QModelIndex &index, int role) const override;
 
     QHash<int, QByteArray> roleNames() const override;
@@ -105,6 +113,8 @@ Q_SIGNALS:
     void contentTypeChanged(const QString &contentType);
     void availableContentTypesChanged(const QStringList &availableContentTypes);
     void canGoBackChanged(bool canGoBack);
+    void localQueryFallbackChanged(bool localQueryFallback);
+    void incrementalQueryChanged(bool incrementalQuery);
 
 protected:
     QIviSearchAndBrowseModel(QIviServiceObject *serviceObject, const QString &contentType, QObject *parent = nullptr);
@@ -75,7 +75,18 @@ public:
 
     void resetModel() override;
     void parseQuery();
-    void setupFilter(QIviAbstractQueryTerm* queryTerm, const QList<QIviOrderTerm> &orderTerms);
+    QIviQuery cachedQuery(const QString &query, QString *errorString) const;
+    bool needsLocalQuery(const QIviQuery &query) const;
+    void setupQuery(const QIviQuery &query);
+    bool refineQuery();
+    void verifyRefinedRows(const QVector<QIviPagingModelRow> &items, bool moreAvailable);
+    void fetchData(int startIndex) override;
+    void handleDataFetched(const QUuid &identifier, const QVector<QIviPagingModelRow> &items, int start, bool moreAvailable) override;
+    void onCountChanged(const QUuid &identifier, int new_length) override;
+    void handleDataChanged(const QVector<QIviPagingModelRow> &data, int start, int count) override;
+    void evaluateLocalQuery();
+    void onLocalQueryEvaluated(quint32 generation, const QVector<int> &permutation, const QString &errorString);
+    int sourceIndex(int row) const;
     void checkType();
     void clearToDefaults() override;
     void setCanGoBack(bool canGoBack);
@@ -89,8 +100,19 @@ public:
 
     QString m_query;
 
-    QIviAbstractQueryTerm *m_queryTerm;
-    QList<QIviOrderTerm> m_orderTerms;
+    QIviQuery m_parsedQuery;
+
+    bool m_localQueryFallback;
+    bool m_localQueryActive;
+    QIviQuery m_localQuery;
+    QVector<QIviPagingModelRow> m_sourceRows;
+    QVector<int> m_permutation;
+    bool m_sourceRowsComplete;
+    bool m_localQueryEvaluating;
+    quint32 m_localQueryGeneration;
+
+    bool m_incrementalQuery;
+    int m_pendingRefines;
 
     QString m_contentType;
     QStringList m_availableContentTypes;
@@ -61,6 +61,22 @@ QT_BEGIN_NAMESPACE
     Every QIviSearchAndBrowseModel generates its own QUuid which is passed to the backend interface and can
     be used to identify a model instance.
 
+    \section1 Keeping the Query
+
+    The terms passed to setupFilter() are only valid until the next call for the same model
+    instance. Backends which need to access the query later, e.g. from a worker thread, can provide
+    an invokable function with the following signature instead:
+
+    \code
+    Q_INVOKABLE void setupQuery(const QUuid &identifier, const QIviQuery &query);
+    \endcode
+
+    The function is looked up by name and called instead of setupFilter(). The \e query holds the
+    terms which are used for filtering and sorting. It is empty when the backend doesn't support
+    filtering and sorting or when no query was defined in the QIviSearchAndBrowseModel instance.
+    A QIviQuery is immutable and implicitly shared, a backend can store a copy of it and read it
+    from any thread for as long as it is needed.
+
     \sa QIviSearchAndBrowseModel
 
     //TODO explain how the interface works on a example
@@ -135,14 +151,25 @@ void QIviSearchAndBrowseModelInterface::registerContentType(const QMetaObject &o
 */
 
 /*!
-    \fn void QIviSearchAndBrowseModelInterface::setupFilter(const QUuid &identifier, QIviAbstractQueryTerm *term, const QList<QIviOrderTerm> &orderTerms)
-
     Setup the filter for the QIviSearchAndBrowseModel instance identified by \a identifier.
 
     The \a term and \a orderTerms arguments are representations of the query which is used for
     filtering and sorting. The \a term argument is a null-pointer when the backend doesn't support
     filtering and sorting or when no query was defined in the QIviSearchAndBrowseModel instance.
+
+    The \a term is only valid until the next call of this function for the same \a identifier.
+    Backends which need to access the query later, e.g. from a worker thread, should provide a
+    setupQuery() function instead, see \l {QIviSearchAndBrowseModelInterface#Keeping the Query}
+    {Keeping the Query}.
+
+    The default implementation does nothing.
 */
+void QIviSearchAndBrowseModelInterface::setupFilter(const QUuid &identifier, QIviAbstractQueryTerm *term, const QList<QIviOrderTerm> &orderTerms)
+{
+    Q_UNUSED(identifier)
+    Q_UNUSED(term)
+    Q_UNUSED(orderTerms)
+}
 
 /*!
     \fn bool QIviSearchAndBrowseModelInterface::canGoBack(const QUuid &identifier, const QString &type)
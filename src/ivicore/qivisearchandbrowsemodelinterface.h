@@ -69,7 +69,7 @@ public:
     virtual QSet<QString> supportedIdentifiers(const QString &contentType) const;
 
     virtual void setContentType(const QUuid &identifier, const QString &contentType) = 0;
-    virtual void setupFilter(const QUuid &identifier, QIviAbstractQueryTerm *term, const QList<QIviOrderTerm> &orderTerms) = 0;
+    virtual void setupFilter(const QUuid &identifier, QIviAbstractQueryTerm *term, const QList<QIviOrderTerm> &orderTerms);
 
     virtual bool canGoBack(const QUuid &identifier, const QString &type) = 0;
     virtual QString goBack(const QUuid &identifier, const QString &type) = 0;  // Only used when in-model navigation
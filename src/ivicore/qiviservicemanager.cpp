@@ -47,11 +47,20 @@
 
 #include <QCoreApplication>
 #include <QDebug>
+#include <QDateTime>
 #include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
 #include <QJsonObject>
 #include <QLibrary>
 #include <QModelIndex>
+#include <QRunnable>
+#include <QSaveFile>
+#include <QStandardPaths>
 #include <QStringList>
+#include <QThread>
+#include <QThreadPool>
 
 #define QIVI_PLUGIN_DIRECTORY "qtivi"
 
@@ -71,6 +80,14 @@ namespace qtivi_helper {
     static const QString classNameLiteral = QStringLiteral("className");
     static const QString simulationLiteral = QStringLiteral("simulation");
     static const QString debugLiteral = QStringLiteral("debug");
+    static const QString cacheVersionLiteral = QStringLiteral("version");
+    static const QString cacheDirectoriesLiteral = QStringLiteral("directories");
+    static const QString cacheFilesLiteral = QStringLiteral("files");
+    static const QString cachePluginsLiteral = QStringLiteral("plugins");
+    static const QString cacheFileLiteral = QStringLiteral("file");
+    static const QString cacheLastModifiedLiteral = QStringLiteral("lastModified");
+    static const QString cacheSizeLiteral = QStringLiteral("size");
+    static const int pluginCacheVersion = 1;
 #ifdef Q_OS_WIN
     static const QString debugSuffixLiteral = QStringLiteral("d");
 #else
@@ -92,11 +109,68 @@ namespace qtivi_helper {
 
         return baseName;
     }
+
+    // The cache is stored per Qt version, as the plugin metadata format is tied to it.
+    QString pluginCacheFileName()
+    {
+        if (qEnvironmentVariableIsSet("QTIVI_DISABLE_PLUGIN_CACHE"))
+            return QString();
+
+        const QByteArray cacheFile = qgetenv("QTIVI_PLUGIN_CACHE");
+        if (!cacheFile.isEmpty())
+            return QFile::decodeName(cacheFile);
+
+        const QString cacheLocation = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+        if (cacheLocation.isEmpty())
+            return QString();
+
+        return cacheLocation + QLatin1String("/qtivi/plugincache-" QT_VERSION_STR ".json");
+    }
+
+    QJsonObject readPluginCache(const QString &fileName)
+    {
+        if (fileName.isEmpty())
+            return QJsonObject();
+
+        QFile file(fileName);
+        if (!file.open(QIODevice::ReadOnly))
+            return QJsonObject();
+
+        const QJsonObject cache = QJsonDocument::fromJson(file.readAll()).object();
+        if (cache.value(cacheVersionLiteral).toInt() != pluginCacheVersion) {
+            qCDebug(qLcIviServiceManagement) << "Ignoring outdated plugin cache:" << fileName;
+            return QJsonObject();
+        }
+
+        return cache.value(cacheDirectoriesLiteral).toObject();
+    }
+
+    void writePluginCache(const QString &fileName, const QJsonObject &directories)
+    {
+        if (fileName.isEmpty())
+            return;
+
+        QDir().mkpath(QFileInfo(fileName).absolutePath());
+
+        QJsonObject cache;
+        cache.insert(cacheVersionLiteral, pluginCacheVersion);
+        cache.insert(cacheDirectoriesLiteral, directories);
+
+        QSaveFile file(fileName);
+        if (!file.open(QIODevice::WriteOnly)
+                || file.write(QJsonDocument(cache).toJson(QJsonDocument::Compact)) == -1
+                || !file.commit()) {
+            qCDebug(qLcIviServiceManagement) << "Failed to write the plugin cache:" << fileName << file.errorString();
+        }
+    }
 }
 
 using namespace qtivi_helper;
 
-QIviServiceManagerPrivate::QIviServiceManagerPrivate(QIviServiceManager *parent) : QObject(parent), q_ptr(parent)
+QIviServiceManagerPrivate::QIviServiceManagerPrivate(QIviServiceManager *parent)
+    : QObject(parent)
+    , q_ptr(parent)
+    , m_lastLoadId(0)
 {
 }
 
@@ -141,16 +215,16 @@ QList<QIviServiceObject *> QIviServiceManagerPrivate::findServiceByInterface(con
     QList<QIviServiceObject*> list;
     qCDebug(qLcIviServiceManagement) << "Searching for a backend for:" << interface << "SearchFlags:" << searchFlags;
 
-    for (Backend *backend : m_backends) {
+    const auto it = m_interfaceIndex.constFind(interface);
+    if (it == m_interfaceIndex.constEnd())
+        return list;
 
-        if (backend->metaData[interfacesLiteral].toStringList().contains(interface)) {
-            bool isSimulation = QIviServiceManagerPrivate::isSimulation(backend->metaData);
-            if ((searchFlags & QIviServiceManager::IncludeSimulationBackends && isSimulation) ||
-                (searchFlags & QIviServiceManager::IncludeProductionBackends && !isSimulation)) {
-                QIviServiceObject *serviceObject = createServiceObject(backend);
-                if (serviceObject)
-                    list.append(serviceObject);
-            }
+    for (Backend *backend : it.value()) {
+        if ((searchFlags & QIviServiceManager::IncludeSimulationBackends && backend->simulation) ||
+            (searchFlags & QIviServiceManager::IncludeProductionBackends && !backend->simulation)) {
+            QIviServiceObject *serviceObject = createServiceObject(backend);
+            if (serviceObject)
+                list.append(serviceObject);
         }
     }
 
@@ -160,6 +234,15 @@ QList<QIviServiceObject *> QIviServiceManagerPrivate::findServiceByInterface(con
 void QIviServiceManagerPrivate::searchPlugins()
 {
     bool found = false;
+
+    // Reading the metadata of a plugin means mapping and parsing the library file, which is slow
+    // on some storage devices. The metadata is cached keyed by the canonical path, the size and
+    // the modification time of the plugin, and the file list of a plugin directory is only
+    // refreshed when the modification time of the directory changed.
+    const QString cacheFileName = pluginCacheFileName();
+    const QJsonObject cachedDirectories = readPluginCache(cacheFileName);
+    QJsonObject directories;
+
     const auto pluginDirs = QCoreApplication::libraryPaths();
     for (const QString &pluginDir : pluginDirs) {
 
@@ -169,19 +252,72 @@ void QIviServiceManagerPrivate::searchPlugins()
         if (!dir.exists())
             continue;
 
-        const QStringList plugins = QDir(path).entryList(QDir::Files);
-        for (const QString &pluginFileName : plugins) {
-            if (!QLibrary::isLibrary(pluginFileName))
-                continue;
+        const QFileInfo dirInfo(path);
+        const QString canonicalDir = dirInfo.canonicalFilePath();
+        const qint64 dirLastModified = dirInfo.lastModified().toMSecsSinceEpoch();
+        const QJsonObject cachedDirectory = cachedDirectories.value(canonicalDir).toObject();
+        const QJsonObject cachedPlugins = cachedDirectory.value(cachePluginsLiteral).toObject();
+
+        QStringList plugins;
+        if (!cachedDirectory.isEmpty()
+                && cachedDirectory.value(cacheLastModifiedLiteral).toVariant().toLongLong() == dirLastModified) {
+            const QJsonArray cachedFiles = cachedDirectory.value(cacheFilesLiteral).toArray();
+            for (const QJsonValue &file : cachedFiles)
+                plugins.append(file.toString());
+        } else {
+            const QStringList entries = QDir(path).entryList(QDir::Files);
+            for (const QString &pluginFileName : entries) {
+                if (QLibrary::isLibrary(pluginFileName))
+                    plugins.append(pluginFileName);
+            }
+        }
 
+        QJsonObject pluginEntries;
+        for (const QString &pluginFileName : qAsConst(plugins)) {
             const QFileInfo info(dir, pluginFileName);
             const QString absFile = info.canonicalFilePath();
-            QPluginLoader loader(absFile);
+            if (absFile.isEmpty())
+                continue;
 
-            registerBackend(absFile, loader.metaData());
+            const qint64 lastModified = info.lastModified().toMSecsSinceEpoch();
+            const qint64 size = info.size();
+
+            QJsonObject entry = cachedPlugins.value(absFile).toObject();
+            if (entry.isEmpty()
+                    || entry.value(cacheFileLiteral).toString() != pluginFileName
+                    || entry.value(cacheLastModifiedLiteral).toVariant().toLongLong() != lastModified
+                    || entry.value(cacheSizeLiteral).toVariant().toLongLong() != size) {
+                QPluginLoader loader(absFile);
+                entry = QJsonObject();
+                entry.insert(cacheFileLiteral, pluginFileName);
+                entry.insert(cacheLastModifiedLiteral, lastModified);
+                entry.insert(cacheSizeLiteral, size);
+                entry.insert(metaDataLiteral, loader.metaData());
+            }
+
+            registerBackend(absFile, entry.value(metaDataLiteral).toObject());
+            pluginEntries.insert(absFile, entry);
             found = true;
         }
+
+        QJsonObject directory;
+        directory.insert(cacheLastModifiedLiteral, dirLastModified);
+        directory.insert(cacheFilesLiteral, QJsonArray::fromStringList(plugins));
+        directory.insert(cachePluginsLiteral, pluginEntries);
+        directories.insert(canonicalDir, directory);
     }
+
+    // The cache is shared by all applications, which search different directories, e.g. their
+    // own application directory. Keep the entries of the other directories unless they are gone.
+    QJsonObject mergedDirectories = directories;
+    for (auto it = cachedDirectories.constBegin(); it != cachedDirectories.constEnd(); ++it) {
+        if (!mergedDirectories.contains(it.key()) && QFileInfo::exists(it.key()))
+            mergedDirectories.insert(it.key(), it.value());
+    }
+
+    if (mergedDirectories != cachedDirectories)
+        writePluginCache(cacheFileName, mergedDirectories);
+
     const auto staticPlugins = QPluginLoader::staticPlugins();
     for (const QStaticPlugin &plugin : staticPlugins)
         registerStaticBackend(plugin);
@@ -296,25 +432,37 @@ void QIviServiceManagerPrivate::unloadAllBackends()
     m_backends.clear();
     q->endResetModel();
 
-    m_interfaceNames.clear();
+    m_interfaceIndex.clear();
+
+    // Backends which are still loading are discarded once the loader thread is done. All waiting
+    // requests are finished, as there is nothing left to wait for.
+    m_loadingBackends.clear();
+    const QVector<PendingLoad> pendingLoads = m_pendingLoads;
+    m_pendingLoads.clear();
+    for (const PendingLoad &pendingLoad : pendingLoads) {
+        if (pendingLoad.context)
+            pendingLoad.callback();
+    }
 }
 
 void QIviServiceManagerPrivate::addBackend(Backend *backend)
 {
     Q_Q(QIviServiceManager);
+    //Precompute everything needed for the lookup in findServiceByInterface()
+    backend->interfaces = backend->metaData.value(interfacesLiteral).toStringList().toSet();
+    backend->simulation = isSimulation(backend->metaData);
+
     //Check whether the same plugin is already in (maybe also in a different configuration)
     //The current configuration of QtIviCore decides which configuration takes precedence
 
     const QString newBackendFile = backend->metaData.value(fileNameLiteral).toString();
     const QString newBackendFileBase = qtivi_helper::backendBaseName(newBackendFile);
-    const QSet<QString> newInterfaces = backend->metaData.value(interfacesLiteral).toStringList().toSet();
-
-    bool addBackend = true;
-    if (!newBackendFile.isEmpty()) {
-        for (int i = 0; i < m_backends.count(); i++) {
-            Backend *b = m_backends[i];
-            const QSet<QString> interfaces = b->metaData.value(interfacesLiteral).toStringList().toSet();
-            if (interfaces == newInterfaces && b->name == backend->name) {
+
+    if (!newBackendFile.isEmpty() && !backend->interfaces.isEmpty()) {
+        //Only backends which implement the same interfaces are candidates, use the index to find them
+        const QVector<Backend*> candidates = m_interfaceIndex.value(*backend->interfaces.constBegin());
+        for (Backend *b : candidates) {
+            if (b->interfaces == backend->interfaces && b->name == backend->name) {
                 const QString fileName = b->metaData.value(fileNameLiteral).toString();
                 if (fileName == newBackendFile) {
                     qCDebug(qLcIviServiceManagement, "SKIPPING %s: already in the list", qPrintable(newBackendFile));
@@ -330,11 +478,8 @@ void QIviServiceManagerPrivate::addBackend(Backend *backend)
                                                     qPrintable(b->debug == qtivi_helper::loadDebug ? fileName : newBackendFile));
                     if (b->debug != qtivi_helper::loadDebug) {
                         qCDebug(qLcIviServiceManagement, "REPLACING %s with %s", qPrintable(fileName), qPrintable(newBackendFile));
-                        addBackend = false;
-                        m_backends[i] = backend;
-                        emit q->dataChanged(q->index(i, 0), q->index(i, 0));
-                        delete b;
-                        break;
+                        replaceBackend(m_backends.indexOf(b), backend);
+                        return;
                     } else {
                         qCDebug(qLcIviServiceManagement, "SKIPPING %s: wrong configuration", qPrintable(newBackendFile));
                         return;
@@ -343,15 +488,36 @@ void QIviServiceManagerPrivate::addBackend(Backend *backend)
             }
         }
     }
-    if (addBackend) {
-        qCDebug(qLcIviServiceManagement, "ADDING %s", qPrintable(newBackendFile.isEmpty() ? backend->name : newBackendFile));
-        q->beginInsertRows(QModelIndex(), m_backends.count(), m_backends.count());
-        m_backends.append(backend);
-        q->endInsertRows();
+    qCDebug(qLcIviServiceManagement, "ADDING %s", qPrintable(newBackendFile.isEmpty() ? backend->name : newBackendFile));
+    q->beginInsertRows(QModelIndex(), m_backends.count(), m_backends.count());
+    m_backends.append(backend);
+    q->endInsertRows();
+
+    for (const QString &interface : qAsConst(backend->interfaces))
+        m_interfaceIndex[interface].append(backend);
+}
+
+void QIviServiceManagerPrivate::replaceBackend(int index, Backend *backend)
+{
+    Q_Q(QIviServiceManager);
+    Backend *oldBackend = m_backends.at(index);
+
+    //Both backends implement the same interfaces, the position in the index stays the same
+    for (const QString &interface : qAsConst(oldBackend->interfaces)) {
+        QVector<Backend*> &backends = m_interfaceIndex[interface];
+        const int i = backends.indexOf(oldBackend);
+        if (i != -1)
+            backends[i] = backend;
     }
 
-    for (const QString &interface : newInterfaces)
-        m_interfaceNames.insert(interface);
+    m_backends[index] = backend;
+    emit q->dataChanged(q->index(index, 0), q->index(index, 0));
+    const bool wasLoading = m_loadingBackends.remove(oldBackend);
+    delete oldBackend;
+
+    //The requests which are waiting for the old backend wait for its replacement instead
+    if (wasLoading)
+        startLoading(backend);
 }
 
 namespace {
@@ -385,6 +551,172 @@ QIviServiceInterface *QIviServiceManagerPrivate::loadServiceBackendInterface(str
     return backend->interface;
 }
 
+namespace {
+// Loads the library of a plugin on a thread of the global thread pool. The root instance of the
+// plugin is created later in the thread of the service manager, as plugins create objects which
+// are bound to the thread they are created in, e.g. database connections.
+class QIviBackendLoader : public QRunnable
+{
+public:
+    QIviBackendLoader(QIviServiceManagerPrivate *manager, Backend *backend, quint32 loadId, const QString &fileName)
+        : m_manager(manager)
+        , m_backend(backend)
+        , m_loadId(loadId)
+        , m_fileName(fileName)
+    {}
+
+    void run() override
+    {
+        auto *loader = new QPluginLoader(m_fileName);
+        loader->load();
+        loader->moveToThread(m_manager->thread());
+
+        QIviServiceManagerPrivate *manager = m_manager;
+        Backend *backend = m_backend;
+        const quint32 loadId = m_loadId;
+        QMetaObject::invokeMethod(manager, [manager, backend, loadId, loader]() {
+            manager->onBackendLoaded(backend, loadId, loader);
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    QIviServiceManagerPrivate *m_manager;
+    Backend *m_backend;
+    quint32 m_loadId;
+    QString m_fileName;
+};
+} // unnamed namespace
+
+/*
+    Loads all plugins implementing \a interface, which are matching the \a searchFlags, on a worker
+    thread and calls \a callback once all of them are loaded. Plugins which are already loading
+    because of an earlier request are not loaded again, instead the request waits for them as
+    well. The \a callback is not called if \a context was destroyed in the meantime.
+*/
+void QIviServiceManagerPrivate::loadBackendsAsync(const QString &interface, QIviServiceManager::SearchFlags searchFlags, QObject *context, const std::function<void()> &callback)
+{
+    const auto it = m_interfaceIndex.constFind(interface);
+    if (it != m_interfaceIndex.constEnd()) {
+        for (Backend *backend : it.value()) {
+            if (!((searchFlags & QIviServiceManager::IncludeSimulationBackends && backend->simulation) ||
+                  (searchFlags & QIviServiceManager::IncludeProductionBackends && !backend->simulation))) {
+                continue;
+            }
+
+            if (backend->interface || m_loadingBackends.contains(backend)
+                    || backend->metaData[fileNameLiteral].toString().isEmpty()) {
+                continue;
+            }
+
+            startLoading(backend);
+        }
+    }
+
+    if (!isLoading(interface, searchFlags)) {
+        QPointer<QObject> guard(context);
+        QMetaObject::invokeMethod(this, [guard, callback]() {
+            if (guard)
+                callback();
+        }, Qt::QueuedConnection);
+        return;
+    }
+
+    m_pendingLoads.append({ interface, searchFlags, context, callback });
+}
+
+/*
+    Loads the plugin of \a backend on a worker thread. Every load gets its own id, which is used to
+    recognize the result of a load for a backend which was unloaded or replaced in the meantime,
+    even if a new backend was created at the same address.
+*/
+void QIviServiceManagerPrivate::startLoading(Backend *backend)
+{
+    const quint32 loadId = ++m_lastLoadId;
+    m_loadingBackends.insert(backend, loadId);
+    const QString fileName = backend->metaData[fileNameLiteral].toString();
+    QThreadPool::globalInstance()->start(new QIviBackendLoader(this, backend, loadId, fileName));
+}
+
+bool QIviServiceManagerPrivate::isLoading(const QString &interface, QIviServiceManager::SearchFlags searchFlags) const
+{
+    const auto it = m_interfaceIndex.constFind(interface);
+    if (it == m_interfaceIndex.constEnd())
+        return false;
+
+    for (Backend *backend : it.value()) {
+        if (((searchFlags & QIviServiceManager::IncludeSimulationBackends && backend->simulation) ||
+             (searchFlags & QIviServiceManager::IncludeProductionBackends && !backend->simulation)) &&
+            m_loadingBackends.contains(backend)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool QIviServiceManagerPrivate::hasLoadedBackend(const QString &interface, QIviServiceManager::SearchFlags searchFlags) const
+{
+    const auto it = m_interfaceIndex.constFind(interface);
+    if (it == m_interfaceIndex.constEnd())
+        return false;
+
+    for (Backend *backend : it.value()) {
+        if (((searchFlags & QIviServiceManager::IncludeSimulationBackends && backend->simulation) ||
+             (searchFlags & QIviServiceManager::IncludeProductionBackends && !backend->simulation)) &&
+            backend->interface) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void QIviServiceManagerPrivate::onBackendLoaded(Backend *backend, quint32 loadId, QPluginLoader *loader)
+{
+    // The backend has been unloaded or replaced while the plugin was loading. The backend is not
+    // accessed in this case, as it is deleted already.
+    const auto it = m_loadingBackends.find(backend);
+    if (it == m_loadingBackends.end() || it.value() != loadId) {
+        loader->unload();
+        delete loader;
+        return;
+    }
+
+    m_loadingBackends.erase(it);
+    if (backend->interface) {
+        // Loaded synchronously in the meantime
+        delete loader;
+    } else {
+        QObject *plugin = loader->instance();
+        if (Q_UNLIKELY(!plugin)) {
+            warn("load", loader);
+        } else {
+            auto *backendInterface = qobject_cast<QIviServiceInterface*>(plugin);
+            if (Q_UNLIKELY(!backendInterface)) {
+                warn("cast to interface from", loader);
+            } else {
+                backend->interface = backendInterface;
+                backend->loader = loader;
+            }
+        }
+    }
+
+    QVector<PendingLoad> finishedLoads;
+    for (auto it = m_pendingLoads.begin(); it != m_pendingLoads.end();) {
+        if (!it->context) {
+            it = m_pendingLoads.erase(it);
+        } else if (!isLoading(it->interface, it->searchFlags)) {
+            finishedLoads.append(*it);
+            it = m_pendingLoads.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    for (const PendingLoad &pendingLoad : qAsConst(finishedLoads)) {
+        if (pendingLoad.context)
+            pendingLoad.callback();
+    }
+}
+
 /*!
     \class QIviServiceManager
     \inmodule QtIviCore
@@ -569,7 +901,7 @@ void QIviServiceManager::unloadAllBackends()
 bool QIviServiceManager::hasInterface(const QString &interface) const
 {
     Q_D(const QIviServiceManager);
-    return d->m_interfaceNames.contains(interface);
+    return d->m_interfaceIndex.contains(interface);
 }
 
 /*!
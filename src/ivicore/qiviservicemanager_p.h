@@ -55,12 +55,17 @@
 //
 
 #include <QtCore/QAbstractListModel>
+#include <QtCore/QHash>
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QMap>
 #include <QtCore/QPluginLoader>
+#include <QtCore/QPointer>
 #include <QtCore/QSet>
 #include <QtCore/QStringList>
 #include <QtCore/QVariantMap>
+#include <QtCore/QVector>
+
+#include <functional>
 
 #include <QtIviCore/qiviservicemanager.h>
 #include <private/qtiviglobal_p.h>
@@ -76,7 +81,9 @@ Q_DECLARE_LOGGING_CATEGORY(qLcIviServiceManagement)
 struct Backend{
     QString name;
     bool debug;
+    bool simulation;
     QVariantMap metaData;
+    QSet<QString> interfaces;
     QIviServiceInterface *interface;
     QObject *interfaceObject;
     QIviProxyServiceObject *proxyServiceObject;
@@ -101,13 +108,30 @@ public:
     void registerBackend(const QString &fileName, const QJsonObject &metaData);
     bool registerBackend(QObject *serviceBackendInterface, const QStringList &interfaces, QIviServiceManager::BackendType backendType);
     void addBackend(struct Backend *backend);
+    void replaceBackend(int index, struct Backend *backend);
 
     void unloadAllBackends();
 
     QIviServiceInterface *loadServiceBackendInterface(struct Backend *backend) const;
 
+    void loadBackendsAsync(const QString &interface, QIviServiceManager::SearchFlags searchFlags, QObject *context, const std::function<void()> &callback);
+    void startLoading(Backend *backend);
+    void onBackendLoaded(Backend *backend, quint32 loadId, QPluginLoader *loader);
+    bool isLoading(const QString &interface, QIviServiceManager::SearchFlags searchFlags) const;
+    bool hasLoadedBackend(const QString &interface, QIviServiceManager::SearchFlags searchFlags) const;
+
     QList<Backend*> m_backends;
-    QSet<QString> m_interfaceNames;
+    QHash<QString, QVector<Backend*>> m_interfaceIndex;
+
+    struct PendingLoad {
+        QString interface;
+        QIviServiceManager::SearchFlags searchFlags;
+        QPointer<QObject> context;
+        std::function<void()> callback;
+    };
+    QHash<Backend*, quint32> m_loadingBackends;
+    QVector<PendingLoad> m_pendingLoads;
+    quint32 m_lastLoadId;
 
     QIviServiceManager * const q_ptr;
     Q_DECLARE_PUBLIC(QIviServiceManager)
@@ -53,13 +53,21 @@ Q_LOGGING_CATEGORY(qLcIviSimulationEngine, "qt.ivi.simulationengine");
 
 namespace qtivi_private {
 
-QIviSimulationProxyBase::QIviSimulationProxyBase(QMetaObject *staticMetaObject, QObject *instance, const QHash<int, int> &methodMap, QObject *parent)
+QIviSimulationProxyBase::QIviSimulationProxyBase(QMetaObject *staticMetaObject, QObject *instance, const QVector<int> &methodMap, QObject *parent)
     : QObject(parent)
     , m_noSimulationEngine(false)
+    , m_dispatchTableReady(false)
     , m_instance(instance)
     , m_staticMetaObject(staticMetaObject)
+    , m_basePropertyIndex(staticMetaObject->indexOfProperty("Base"))
     , m_methodMap(methodMap)
+    , m_reverseMethodMap(staticMetaObject->methodCount(), -1)
 {
+    for (int i = 0; i < m_methodMap.count(); ++i) {
+        const int proxyIndex = m_methodMap.at(i);
+        if (proxyIndex >= 0 && proxyIndex < m_reverseMethodMap.count())
+            m_reverseMethodMap[proxyIndex] = i;
+    }
 }
 
 const QMetaObject *QIviSimulationProxyBase::metaObject() const
@@ -86,8 +94,7 @@ int QIviSimulationProxyBase::qt_metacall(QMetaObject::Call call, int methodId, v
     // All other properties are forwarded to the qt_metacall generated by moc which translates the
     // absolute id's back to relative ones
     if (call == QMetaObject::ReadProperty || call == QMetaObject::WriteProperty) {
-        int basePropertyIndex = m_staticMetaObject->indexOfProperty("Base");
-        if (methodId == basePropertyIndex) {
+        if (methodId == m_basePropertyIndex) {
             void *_v = a[0];
             *reinterpret_cast< QObject**>(_v) = m_instance;
             return -1;
@@ -101,9 +108,9 @@ int QIviSimulationProxyBase::qt_metacall(QMetaObject::Call call, int methodId, v
             QMetaObject::activate(this, m_staticMetaObject, methodId - m_staticMetaObject->methodOffset(), a);
             return 0;
         }
-        // As we don't derive from the MetaObject of m_instance, we need to use the methodMap to
+        // As we don't derive from the MetaObject of m_instance, we need to use the reverse methodMap to
         // translate our methodId to the methodId for m_instance
-        return m_instance->qt_metacall(call, m_methodMap.key(methodId), a);
+        return m_instance->qt_metacall(call, m_reverseMethodMap.value(methodId, -1), a);
     }
     return m_instance->qt_metacall(call, methodId, a);
 }
@@ -115,9 +122,31 @@ void QIviSimulationProxyBase::classBegin()
 void QIviSimulationProxyBase::componentComplete()
 {
     setProperty("Base", QVariant::fromValue(m_instance));
+    buildDispatchTable();
 }
 
-QMetaObject QIviSimulationProxyBase::buildObject(const QMetaObject *metaObject, QHash<int, int> &methodMap, QIviSimulationProxyBase::StaticMetacallFunction metaCallFunction)
+// Resolves all functions declared in QML once, instead of searching for them on every call
+void QIviSimulationProxyBase::buildDispatchTable()
+{
+    m_qmlMethods.clear();
+    m_dispatchTableReady = true;
+
+    // Only invoke the functions declared in QML.
+    // Once a function/property is added to a type a new MetaObject gets created which contains
+    // _QML_ in the name.
+    const QMetaObject *mo = metaObject();
+    if (!strstr(mo->className(), "_QML_"))
+        return;
+
+    for (int i = mo->methodOffset(); i < mo->methodCount(); i++) {
+        const QMetaMethod method = mo->method(i);
+        const QByteArray name = method.name();
+        if (!m_qmlMethods.contains(name))
+            m_qmlMethods.insert(name, method);
+    }
+}
+
+QMetaObject QIviSimulationProxyBase::buildObject(const QMetaObject *metaObject, QVector<int> &methodMap, QIviSimulationProxyBase::StaticMetacallFunction metaCallFunction)
 {
     QMetaObjectBuilder builder;
     const QString name = QString(QStringLiteral("QIviSimulationProxy_%1")).arg(QLatin1String(metaObject->className()));
@@ -140,8 +169,9 @@ QMetaObject QIviSimulationProxyBase::buildObject(const QMetaObject *metaObject,
     const int propertyOffset = superClass->propertyCount();
 
     //Fill the mapping for all QObject methods.
+    methodMap.fill(-1, mo->methodCount());
     for (int i=0; i<methodOffset; ++i)
-        methodMap.insert(i, i);
+        methodMap[i] = i;
 
     //Add all signals
     qCDebug(qLcIviSimulationEngine) << "Signal Mapping: Original -> Proxy";
@@ -150,7 +180,7 @@ QMetaObject QIviSimulationProxyBase::buildObject(const QMetaObject *metaObject,
         if (mm.methodType() == QMetaMethod::Signal) {
             auto mb = builder.addMethod(mm);
             qCDebug(qLcIviSimulationEngine) << index << "->" << methodOffset + mb.index();
-            methodMap.insert(index, methodOffset + mb.index());
+            methodMap[index] = methodOffset + mb.index();
         }
     }
 
@@ -161,7 +191,7 @@ QMetaObject QIviSimulationProxyBase::buildObject(const QMetaObject *metaObject,
         if (mm.methodType() != QMetaMethod::Signal) {
             auto mb = builder.addMethod(mm);
             qCDebug(qLcIviSimulationEngine) << index << "->" << methodOffset + mb.index();
-            methodMap.insert(index, methodOffset + mb.index());
+            methodMap[index] = methodOffset + mb.index();
         }
     }
 
@@ -216,21 +246,23 @@ bool QIviSimulationProxyBase::callQmlMethod(const char *function, QGenericReturn
 
     recursionGuard = true;
 
-    bool functionExecuted = false;
-    const QMetaObject *mo = metaObject();
+    if (!m_dispatchTableReady)
+        buildDispatchTable();
 
-    // Only invoke the functions declared in QML.
-    // Once a function/property is added to a type a new MetaObject gets created which contains
-    // _QML_ in the name.
-    if (QString::fromLatin1(mo->className()).contains(QLatin1String("_QML_"))) {
-        for (int i=mo->methodOffset(); i<mo->methodCount(); i++) {
-            //qDebug() << "CHECKING FOR: " << function << mo->method(i).name();
-            if (mo->method(i).name() != function)
-                continue;
-            //qDebug() << "EXECUTING";
+    bool functionExecuted = false;
+    const auto it = m_qmlMethods.constFind(QByteArray::fromRawData(function, int(qstrlen(function))));
+    if (it != m_qmlMethods.constEnd()) {
+        // The arguments are passed until the first empty one, see QMetaObject::invokeMethod
+        const QGenericArgument args[] = { val0, val1, val2, val3, val4, val5, val6, val7, val8, val9 };
+        int argumentCount = 0;
+        while (argumentCount < 10 && args[argumentCount].name())
+            ++argumentCount;
+
+        // Overloads are resolved by QMetaObject::invokeMethod
+        if (it->parameterCount() == argumentCount)
+            functionExecuted = it->invoke(this, Qt::AutoConnection, ret, val0, val1, val2, val3, val4, val5, val6, val7, val8, val9);
+        else
             functionExecuted = QMetaObject::invokeMethod(this, function, ret, val0, val1, val2, val3, val4, val5, val6, val7, val8, val9);
-            break;
-        }
     }
     recursionGuard = false;
     return functionExecuted;
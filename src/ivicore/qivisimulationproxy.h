@@ -46,8 +46,10 @@
 #include <QtIviCore/QtIviCoreModule>
 
 #include <QtCore/QObject>
+#include <QtCore/QHash>
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QVariant>
+#include <QtCore/QVector>
 #include <QtCore/QMetaObject>
 #include <QtQml/QQmlParserStatus>
 
@@ -83,7 +85,7 @@ namespace qtivi_private {
         Q_INTERFACES(QQmlParserStatus)
 
     public:
-        QIviSimulationProxyBase(QMetaObject *staticMetaObject, QObject *instance, const QHash<int, int> &methodMap, QObject *parent=nullptr);
+        QIviSimulationProxyBase(QMetaObject *staticMetaObject, QObject *instance, const QVector<int> &methodMap, QObject *parent=nullptr);
 
         virtual const QMetaObject *metaObject() const override;
         virtual void *qt_metacast(const char *classname) override;
@@ -93,7 +95,7 @@ namespace qtivi_private {
         void componentComplete() override;
 
         typedef void (*StaticMetacallFunction)(QObject *, QMetaObject::Call, int, void **);
-        static QMetaObject buildObject(const QMetaObject *metaObject, QHash<int, int> &methodMap, QIviSimulationProxyBase::StaticMetacallFunction metaCallFunction);
+        static QMetaObject buildObject(const QMetaObject *metaObject, QVector<int> &methodMap, QIviSimulationProxyBase::StaticMetacallFunction metaCallFunction);
 
         bool callQmlMethod(const char* function,
                           QGenericReturnArgument ret,
@@ -118,10 +120,18 @@ namespace qtivi_private {
         void setup(QIviSimulationEngine *engine);
 
     private:
+        void buildDispatchTable();
+
         bool m_noSimulationEngine;
+        bool m_dispatchTableReady;
         QObject *m_instance;
         QMetaObject *m_staticMetaObject;
-        QHash<int, int> m_methodMap;
+        int m_basePropertyIndex;
+        // Maps the method indexes of the instance to the ones of the proxy and vice versa
+        const QVector<int> m_methodMap;
+        QVector<int> m_reverseMethodMap;
+        // The functions declared in QML, resolved by name
+        QHash<QByteArray, QMetaMethod> m_qmlMethods;
     };
 
     template <typename T> class QIviSimulationProxy: public QIviSimulationProxyBase
@@ -168,9 +178,9 @@ namespace qtivi_private {
             m_instance = instance;
         }
 
-        static QHash<int, int> &methodMap()
+        static QVector<int> &methodMap()
         {
-            static QHash<int, int> map;
+            static QVector<int> map;
             return map;
         }
 
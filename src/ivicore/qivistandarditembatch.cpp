@@ -0,0 +1,197 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 Luxoft Sweden AB
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtIvi module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL-QTAS$
+** Commercial License Usage
+** Licensees holding valid commercial Qt Automotive Suite licenses may use
+** this file in accordance with the commercial license agreement provided
+** with the Software or, alternatively, in accordance with the terms
+** contained in a written agreement between you and The Qt Company.  For
+** licensing terms and conditions see https://www.qt.io/terms-conditions.
+** For further information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+** SPDX-License-Identifier: LGPL-3.0
+**
+****************************************************************************/
+
+#include "qivistandarditembatch.h"
+
+#include <cstdlib>
+
+QT_BEGIN_NAMESPACE
+
+class QIviStandardItemBatchPrivate : public QSharedData
+{
+public:
+    QIviStandardItemBatchPrivate(int typeId, int itemSize, int count, QIviStandardItemBatch::BaseCast baseCast)
+        : m_typeId(typeId)
+        , m_itemSize(itemSize)
+        , m_count(count)
+        , m_baseCast(baseCast)
+        , m_data(static_cast<char*>(::malloc(size_t(itemSize) * size_t(qMax(count, 1)))))
+    {
+        Q_CHECK_PTR(m_data);
+    }
+
+    ~QIviStandardItemBatchPrivate()
+    {
+        for (int i = 0; i < m_count; i++)
+            QMetaType::destruct(m_typeId, m_data + i * m_itemSize);
+        ::free(m_data);
+    }
+
+    int m_typeId;
+    int m_itemSize;
+    int m_count;
+    QIviStandardItemBatch::BaseCast m_baseCast;
+    char *m_data;
+};
+
+/*!
+    \class QIviStandardItemBatch
+    \inmodule QtIviCore
+    \brief The QIviStandardItemBatch class holds a chunk of items of the same type in one contiguous block of memory.
+
+    A QIviStandardItemBatch can be used by backends as an alternative to a list of QVariants when
+    passing data to a QIviPagingModel. All items of a batch are of the same type, which needs to be
+    derived from QIviStandardItem and is checked once when the batch is created.
+
+    The batch is immutable and implicitly shared, copying it only increases a reference counter. This
+    makes it possible to pass the same batch to several model instances without copying the items.
+
+    \code
+    QVector<ExampleItem> items = ...;
+    emit batchFetched(identifier, QIviStandardItemBatch::fromVector(items), start, moreAvailable);
+    \endcode
+
+    \sa QIviPagingModelInterface::batchFetched() QIviPagingModelInterface::batchChanged()
+*/
+
+/*!
+    \fn template <typename T> QIviStandardItemBatch QIviStandardItemBatch::fromVector(const QVector<T> &items)
+
+    Returns a new batch holding copies of all \a items. The type \c T needs to be derived from QIviStandardItem.
+*/
+
+/*!
+    \fn template <typename T> QIviStandardItemBatch QIviStandardItemBatch::fromList(const QList<T> &items)
+
+    Returns a new batch holding copies of all \a items. The type \c T needs to be derived from QIviStandardItem.
+*/
+
+/*!
+    Constructs an empty batch.
+*/
+QIviStandardItemBatch::QIviStandardItemBatch()
+{
+}
+
+QIviStandardItemBatch::QIviStandardItemBatch(const QIviStandardItemBatch &rhs) = default;
+
+QIviStandardItemBatch &QIviStandardItemBatch::operator=(const QIviStandardItemBatch &rhs)
+{
+    if (this != &rhs)
+        d.operator=(rhs.d);
+    return *this;
+}
+
+QIviStandardItemBatch::~QIviStandardItemBatch() = default;
+
+/*!
+    \internal
+*/
+QIviStandardItemBatch::QIviStandardItemBatch(int typeId, int itemSize, int count, BaseCast baseCast)
+    : d(new QIviStandardItemBatchPrivate(typeId, itemSize, count, baseCast))
+{
+}
+
+/*!
+    \internal
+*/
+void *QIviStandardItemBatch::itemStorage(int i)
+{
+    return d->m_data + i * d->m_itemSize;
+}
+
+/*!
+    Returns the meta type id of the items stored in this batch.
+*/
+int QIviStandardItemBatch::typeId() const
+{
+    return d ? d->m_typeId : int(QMetaType::UnknownType);
+}
+
+/*!
+    Returns the number of items stored in this batch.
+*/
+int QIviStandardItemBatch::count() const
+{
+    return d ? d->m_count : 0;
+}
+
+/*!
+    Returns \c true if the batch doesn't contain any items.
+*/
+bool QIviStandardItemBatch::isEmpty() const
+{
+    return !count();
+}
+
+/*!
+    Returns a pointer to the item at index \a i.
+
+    The pointer stays valid as long as a copy of this batch exists.
+*/
+const QIviStandardItem *QIviStandardItemBatch::itemAt(int i) const
+{
+    Q_ASSERT(i >= 0 && i < count());
+    return d->m_baseCast(d->m_data + i * d->m_itemSize);
+}
+
+/*!
+    Returns a copy of the item at index \a i wrapped in a QVariant.
+*/
+QVariant QIviStandardItemBatch::variantAt(int i) const
+{
+    Q_ASSERT(i >= 0 && i < count());
+    return QVariant(d->m_typeId, d->m_data + i * d->m_itemSize);
+}
+
+/*!
+    Returns a list containing copies of all items wrapped in a QVariant.
+*/
+QVariantList QIviStandardItemBatch::toVariantList() const
+{
+    QVariantList list;
+    list.reserve(count());
+    for (int i = 0; i < count(); i++)
+        list.append(variantAt(i));
+    return list;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,113 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 Luxoft Sweden AB
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtIvi module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL-QTAS$
+** Commercial License Usage
+** Licensees holding valid commercial Qt Automotive Suite licenses may use
+** this file in accordance with the commercial license agreement provided
+** with the Software or, alternatively, in accordance with the terms
+** contained in a written agreement between you and The Qt Company.  For
+** licensing terms and conditions see https://www.qt.io/terms-conditions.
+** For further information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+** SPDX-License-Identifier: LGPL-3.0
+**
+****************************************************************************/
+
+#ifndef QIVISTANDARDITEMBATCH_H
+#define QIVISTANDARDITEMBATCH_H
+
+#include <QtCore/QExplicitlySharedDataPointer>
+#include <QtCore/QList>
+#include <QtCore/QMetaType>
+#include <QtCore/QVariant>
+#include <QtCore/QVector>
+#include <QtIviCore/QIviStandardItem>
+#include <QtIviCore/qtiviglobal.h>
+
+#include <new>
+#include <type_traits>
+
+QT_BEGIN_NAMESPACE
+
+class QIviStandardItemBatchPrivate;
+
+class Q_QTIVICORE_EXPORT QIviStandardItemBatch
+{
+public:
+    QIviStandardItemBatch();
+    QIviStandardItemBatch(const QIviStandardItemBatch &);
+    QIviStandardItemBatch &operator=(const QIviStandardItemBatch &);
+    ~QIviStandardItemBatch();
+
+    template <typename T> static QIviStandardItemBatch fromVector(const QVector<T> &items)
+    {
+        return fromRange<T>(items.constBegin(), items.constEnd(), items.count());
+    }
+
+    template <typename T> static QIviStandardItemBatch fromList(const QList<T> &items)
+    {
+        return fromRange<T>(items.constBegin(), items.constEnd(), items.count());
+    }
+
+    int typeId() const;
+    int count() const;
+    bool isEmpty() const;
+
+    const QIviStandardItem *itemAt(int i) const;
+    QVariant variantAt(int i) const;
+    QVariantList toVariantList() const;
+
+private:
+    template <typename T, typename It> static QIviStandardItemBatch fromRange(It begin, It end, int count)
+    {
+        Q_STATIC_ASSERT_X((std::is_base_of<QIviStandardItem, T>::value), "T needs to be derived from QIviStandardItem");
+        QIviStandardItemBatch batch(qMetaTypeId<T>(), int(sizeof(T)), count, [](const void *item) {
+            return static_cast<const QIviStandardItem*>(static_cast<const T*>(item));
+        });
+        int i = 0;
+        for (It it = begin; it != end; ++it, ++i)
+            new (batch.itemStorage(i)) T(*it);
+        return batch;
+    }
+
+    typedef const QIviStandardItem *(*BaseCast)(const void *item);
+    QIviStandardItemBatch(int typeId, int itemSize, int count, BaseCast baseCast);
+    void *itemStorage(int i);
+
+    QExplicitlySharedDataPointer<QIviStandardItemBatchPrivate> d;
+    friend class QIviStandardItemBatchPrivate;
+};
+
+Q_DECLARE_TYPEINFO(QIviStandardItemBatch, Q_MOVABLE_TYPE);
+
+QT_END_NAMESPACE
+
+Q_DECLARE_METATYPE(QIviStandardItemBatch)
+
+#endif // QIVISTANDARDITEMBATCH_H
@@ -0,0 +1,253 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 Luxoft Sweden AB
+** Copyright (C) 2018 Pelagicore AG
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtIvi module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL-QTAS$
+** Commercial License Usage
+** Licensees holding valid commercial Qt Automotive Suite licenses may use
+** this file in accordance with the commercial license agreement provided
+** with the Software or, alternatively, in accordance with the terms
+** contained in a written agreement between you and The Qt Company.  For
+** licensing terms and conditions see https://www.qt.io/terms-conditions.
+** For further information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+** SPDX-License-Identifier: LGPL-3.0
+**
+****************************************************************************/
+
+#include "qiviupdatethrottle_p.h"
+#include "qiviabstractfeature_p.h"
+
+#include <QVector>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+bool isNumeric(const QVariant &value)
+{
+    switch (value.userType()) {
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::Long:
+    case QMetaType::ULong:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Short:
+    case QMetaType::UShort:
+    case QMetaType::Float:
+    case QMetaType::Double:
+        return true;
+    default:
+        return false;
+    }
+}
+
+qint64 intervalForRate(qreal rate)
+{
+    return qMax<qint64>(1, qRound64(1000 / rate));
+}
+
+} // namespace
+
+/*!
+    \internal
+    \class QIviUpdateThrottle
+    \inmodule QtIviCore
+
+    Applies the QIviAbstractFeature::UpdatePolicy of a feature to the property updates sent by its
+    backend. The feature passes every update to defer() before applying it. Updates which are held
+    back are delivered later by calling QIviAbstractFeaturePrivate::applyUpdate() on the feature
+    the update was meant for, which can also be one of the zone features of a zoned feature.
+
+    The throttle only exists while a policy other than QIviAbstractFeature::ImmediateUpdates is
+    configured, which keeps the default path free of any overhead.
+*/
+QIviUpdateThrottle::QIviUpdateThrottle(QIviAbstractFeaturePrivate *feature)
+    : m_feature(feature)
+{
+    m_clock.start();
+    m_timer.setSingleShot(true);
+    QObject::connect(&m_timer, &QTimer::timeout, &m_timer, [this]() {
+        deliverPending(false);
+    });
+}
+
+void QIviUpdateThrottle::setPropertyPolicy(int propertyIndex, QIviAbstractFeature::UpdatePolicy policy, qreal parameter)
+{
+    m_policies.insert(propertyIndex, { policy, parameter });
+    policyChanged();
+}
+
+bool QIviUpdateThrottle::hasPropertyPolicies() const
+{
+    return !m_policies.isEmpty();
+}
+
+/*!
+    \internal
+    Returns \c true if the update of the property at \a propertyIndex to \a value should not be
+    applied to \a target right now. The value is then either dropped or delivered later.
+
+    The values sent before the feature is initialized are never held back, to make sure the
+    initial state of the backend is available as soon as isInitialized changes.
+*/
+bool QIviUpdateThrottle::defer(QIviAbstractFeature *target, int propertyIndex, const QVariant &value)
+{
+    const Policy p = policy(propertyIndex);
+    if (p.policy == QIviAbstractFeature::ImmediateUpdates)
+        return false;
+
+    Entry &entry = m_entries[qMakePair(target, propertyIndex)];
+    if (!m_feature->m_isInitialized) {
+        entry.lastValue = value;
+        return false;
+    }
+
+    switch (p.policy) {
+    case QIviAbstractFeature::DeadbandUpdates:
+        if (entry.lastValue.isValid() && isNumeric(value) && isNumeric(entry.lastValue)
+                && qAbs(value.toDouble() - entry.lastValue.toDouble()) < p.parameter) {
+            return true;
+        }
+        entry.lastValue = value;
+        return false;
+    case QIviAbstractFeature::CoalescedUpdates:
+        entry.pendingValue = value;
+        entry.pending = true;
+        schedule(0);
+        return true;
+    case QIviAbstractFeature::RateLimitedUpdates: {
+        if (p.parameter <= 0)
+            return false;
+        const qint64 interval = intervalForRate(p.parameter);
+        const qint64 now = m_clock.elapsed();
+        // The first update after a quiet period is applied directly, everything following it
+        // within the interval is collapsed into the latest value
+        if (!entry.pending && (entry.lastUpdate < 0 || now - entry.lastUpdate >= interval)) {
+            entry.lastUpdate = now;
+            return false;
+        }
+        entry.pendingValue = value;
+        entry.pending = true;
+        schedule(qMax<qint64>(0, entry.lastUpdate + interval - now));
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+/*!
+    \internal
+    Needs to be called whenever one of the policies changed. The pending updates are
+    re-evaluated against the new policies.
+*/
+void QIviUpdateThrottle::policyChanged()
+{
+    schedule(0);
+}
+
+/*!
+    \internal
+    Delivers all pending updates right away.
+*/
+void QIviUpdateThrottle::flush()
+{
+    m_timer.stop();
+    deliverPending(true);
+}
+
+/*!
+    \internal
+    Drops all pending updates and the recorded values, but keeps the configured policies.
+*/
+void QIviUpdateThrottle::reset()
+{
+    m_timer.stop();
+    m_entries.clear();
+}
+
+QIviUpdateThrottle::Policy QIviUpdateThrottle::policy(int propertyIndex) const
+{
+    auto it = m_policies.constFind(propertyIndex);
+    if (it != m_policies.constEnd())
+        return it.value();
+
+    switch (m_feature->m_updatePolicy) {
+    case QIviAbstractFeature::RateLimitedUpdates:
+        return { m_feature->m_updatePolicy, m_feature->m_updateRate };
+    case QIviAbstractFeature::DeadbandUpdates:
+        return { m_feature->m_updatePolicy, m_feature->m_updateDeadband };
+    default:
+        return { m_feature->m_updatePolicy, 0 };
+    }
+}
+
+void QIviUpdateThrottle::schedule(qint64 msec)
+{
+    if (m_timer.isActive() && m_timer.remainingTime() <= msec)
+        return;
+    m_timer.start(int(msec));
+}
+
+void QIviUpdateThrottle::deliverPending(bool force)
+{
+    const qint64 now = m_clock.elapsed();
+    qint64 next = -1;
+    QVector<QPair<Key, QVariant>> due;
+
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+        Entry &entry = it.value();
+        if (!entry.pending)
+            continue;
+        if (!force) {
+            const Policy p = policy(it.key().second);
+            if (p.policy == QIviAbstractFeature::RateLimitedUpdates && p.parameter > 0) {
+                const qint64 remaining = entry.lastUpdate + intervalForRate(p.parameter) - now;
+                if (remaining > 0) {
+                    next = next < 0 ? remaining : qMin(next, remaining);
+                    continue;
+                }
+            }
+        }
+        entry.lastUpdate = now;
+        entry.pending = false;
+        due.append(qMakePair(it.key(), entry.pendingValue));
+        entry.pendingValue.clear();
+    }
+
+    if (next >= 0)
+        schedule(next);
+
+    // Applying the updates emits the change signals, which might end up changing the entries
+    for (const auto &update : qAsConst(due))
+        QIviAbstractFeaturePrivate::get(update.first.first)->applyUpdate(update.first.second, update.second);
+}
+
+QT_END_NAMESPACE
@@ -90,6 +90,9 @@ QtIviCoreModule::QtIviCoreModule(QObject *parent)
            The backend supports moving items within the model.
     \value SupportsRemove
            The backend supports removing items from the model.
+    \value SupportsContinuationTokens
+           The backend hands out a continuation token with every chunk of data and accepts it to fetch the following chunk.
+           \sa {QIviPagingModelInterface#Continuation Tokens}{Continuation Tokens}
 */
 
 /*!
@@ -64,7 +64,8 @@ public:
         SupportsStatelessNavigation = 0x20, // (the backend supports to have multiple models showing different contentTypes and filters at the same time)
         SupportsInsert = 0x40,
         SupportsMove = 0x80,
-        SupportsRemove = 0x100
+        SupportsRemove = 0x100,
+        SupportsContinuationTokens = 0x200 // (the backend can continue a request from where the previous chunk ended, without skipping all rows before it)
     };
     Q_DECLARE_FLAGS(ModelCapabilities, ModelCapability)
     Q_FLAG(ModelCapabilities)
@@ -88,6 +88,17 @@ QIviOrderTermPrivate::QIviOrderTermPrivate(const QIviOrderTermPrivate &other)
 
 }
 
+QIviQueryPrivate::QIviQueryPrivate(QIviAbstractQueryTerm *term, const QList<QIviOrderTerm> &orderTerms)
+    : m_term(term)
+    , m_orderTerms(orderTerms)
+{
+}
+
+QIviQueryPrivate::~QIviQueryPrivate()
+{
+    delete m_term;
+}
+
 /*!
     \class QIviAbstractQueryTerm
     \inmodule QtIviCore
@@ -402,3 +413,78 @@ QString QIviOrderTerm::propertyName() const
 {
     return d->m_propertyName;
 }
+
+/*!
+    \class QIviQuery
+    \inmodule QtIviCore
+    \brief The QIviQuery class holds a parsed query and its order terms.
+
+    A QIviQuery owns the tree of query terms returned by the query parser together with the
+    QIviOrderTerm list. The query is immutable and implicitly shared: copying it only increases
+    a reference count and the terms are deleted once the last copy is destroyed.
+
+    As none of the terms can be changed after parsing, a QIviQuery can be copied to and read
+    from any thread. Backends can keep a copy to translate the query later, e.g. from a worker
+    thread, without copying the terms and without depending on the lifetime of the model which
+    created it.
+
+    \sa {QIviSearchAndBrowseModelInterface#Keeping the Query}{Keeping the Query}
+*/
+
+/*!
+    Constructs an empty query.
+*/
+QIviQuery::QIviQuery()
+{
+}
+
+/*!
+    Constructs a query which takes the ownership of \a term and holds the \a orderTerms.
+
+    \a term must not be changed afterwards, as the query can be shared between threads.
+*/
+QIviQuery::QIviQuery(QIviAbstractQueryTerm *term, const QList<QIviOrderTerm> &orderTerms)
+    : d(new QIviQueryPrivate(term, orderTerms))
+{
+}
+
+QIviQuery::QIviQuery(const QIviQuery &other)
+    : d(other.d)
+{
+}
+
+QIviQuery::~QIviQuery()
+{
+}
+
+QIviQuery &QIviQuery::operator =(const QIviQuery &other)
+{
+    d = other.d;
+    return *this;
+}
+
+/*!
+    Returns \c true if the query neither has a term nor order terms.
+*/
+bool QIviQuery::isEmpty() const
+{
+    return !d || (!d->m_term && d->m_orderTerms.isEmpty());
+}
+
+/*!
+    Returns the root of the query terms or \c nullptr if the query doesn't filter.
+
+    The term is owned by the query and stays valid as long as a copy of the query exists.
+*/
+const QIviAbstractQueryTerm *QIviQuery::term() const
+{
+    return d ? d->m_term : nullptr;
+}
+
+/*!
+    Returns the terms which define the order of the result.
+*/
+QList<QIviOrderTerm> QIviQuery::orderTerms() const
+{
+    return d ? d->m_orderTerms : QList<QIviOrderTerm>();
+}
@@ -160,6 +160,26 @@ private:
 
 Q_DECLARE_TYPEINFO(QIviOrderTerm, Q_MOVABLE_TYPE);
 
+class QIviQueryPrivate;
+class Q_QTIVICORE_EXPORT QIviQuery
+{
+public:
+    QIviQuery();
+    explicit QIviQuery(QIviAbstractQueryTerm *term, const QList<QIviOrderTerm> &orderTerms = QList<QIviOrderTerm>());
+    QIviQuery(const QIviQuery &other);
+    ~QIviQuery();
+    QIviQuery& operator =(const QIviQuery &other);
+
+    bool isEmpty() const;
+    const QIviAbstractQueryTerm *term() const;
+    QList<QIviOrderTerm> orderTerms() const;
+
+private:
+    QExplicitlySharedDataPointer<QIviQueryPrivate> d;
+};
+
+Q_DECLARE_TYPEINFO(QIviQuery, Q_MOVABLE_TYPE);
+
 QT_END_NAMESPACE
 
 #endif // QUERYTERM_H
@@ -99,6 +99,19 @@ public:
     QString m_propertyName;
 };
 
+class Q_QTIVICORE_EXPORT QIviQueryPrivate : public QSharedData
+{
+public:
+    QIviQueryPrivate(QIviAbstractQueryTerm *term, const QList<QIviOrderTerm> &orderTerms);
+    ~QIviQueryPrivate();
+
+    QIviAbstractQueryTerm * const m_term;
+    const QList<QIviOrderTerm> m_orderTerms;
+
+private:
+    Q_DISABLE_COPY(QIviQueryPrivate)
+};
+
 QT_END_NAMESPACE
 
 #endif // QIVIQUERYTERM_P_H
@@ -124,7 +124,30 @@ void QIviMediaPlayerPrivate::onCurrentTrackChanged(const QVariant &currentTrack)
     emit q->currentTrackChanged(m_currentTrackData);
 }
 
+static int positionPropertyIndex()
+{
+    static const int index = QIviMediaPlayer::staticMetaObject.indexOfProperty("position");
+    return index;
+}
+
+void QIviMediaPlayerPrivate::applyUpdate(int propertyIndex, const QVariant &value)
+{
+    if (propertyIndex == positionPropertyIndex()) {
+        applyPosition(value.value<qint64>());
+        return;
+    }
+    QIviAbstractFeaturePrivate::applyUpdate(propertyIndex, value);
+}
+
 void QIviMediaPlayerPrivate::onPositionChanged(qint64 position)
+{
+    // The position is updated at a high rate while playing, let the update policy collapse it
+    if (Q_UNLIKELY(m_updateThrottle) && m_updateThrottle->defer(q_ptr, positionPropertyIndex(), position))
+        return;
+    applyPosition(position);
+}
+
+void QIviMediaPlayerPrivate::applyPosition(qint64 position)
 {
     if (m_position == position)
         return;
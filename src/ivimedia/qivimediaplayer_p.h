@@ -68,11 +68,13 @@ public:
     QIviMediaPlayerPrivate(const QString &interface, QIviMediaPlayer *parent);
 
     virtual void initialize() override;
+    void applyUpdate(int propertyIndex, const QVariant &value) override;
     void clearToDefaults();
     void onPlayModeChanged(QIviMediaPlayer::PlayMode playMode);
     void onPlayStateChanged(QIviMediaPlayer::PlayState playState);
     void onCurrentTrackChanged(const QVariant &currentTrack);
     void onPositionChanged(qint64 position);
+    void applyPosition(qint64 position);
     void onDurationChanged(qint64 duration);
     void onVolumeChanged(int volume);
     void onMutedChanged(bool muted);
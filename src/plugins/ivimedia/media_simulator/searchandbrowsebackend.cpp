@@ -45,11 +45,14 @@
 
 #include <QtConcurrent/QtConcurrent>
 
+#include <QDataStream>
 #include <QFuture>
 #include <QSqlError>
 #include <QSqlQuery>
 #include <QtDebug>
 
+#include <algorithm>
+
 static const QString artistLiteral = QStringLiteral("artist");
 static const QString albumLiteral = QStringLiteral("album");
 static const QString trackLiteral = QStringLiteral("track");
@@ -90,14 +93,23 @@ void SearchAndBrowseBackend::setContentType(const QUuid &identifier, const QStri
     state.contentType = contentType;
 }
 
-void SearchAndBrowseBackend::setupFilter(const QUuid &identifier, QIviAbstractQueryTerm *term, const QList<QIviOrderTerm> &orderTerms)
+void SearchAndBrowseBackend::setupQuery(const QUuid &identifier, const QIviQuery &query)
 {
     auto &state = m_state[identifier];
-    state.queryTerm = term;
-    state.orderTerms = orderTerms;
+    state.query = query;
 }
 
 void SearchAndBrowseBackend::fetchData(const QUuid &identifier, int start, int count)
+{
+    fetchRows(identifier, QByteArray(), start, count);
+}
+
+void SearchAndBrowseBackend::fetchDataAfter(const QUuid &identifier, const QByteArray &continuationToken, int start, int count)
+{
+    fetchRows(identifier, continuationToken, start, count);
+}
+
+void SearchAndBrowseBackend::fetchRows(const QUuid &identifier, const QByteArray &continuationToken, int start, int count)
 {
     emit supportedCapabilitiesChanged(identifier, QtIviCoreModule::ModelCapabilities(
                                           QtIviCoreModule::SupportsFiltering |
@@ -105,7 +117,8 @@ void SearchAndBrowseBackend::fetchData(const QUuid &identifier, int start, int c
                                           QtIviCoreModule::SupportsAndConjunction |
                                           QtIviCoreModule::SupportsOrConjunction |
                                           QtIviCoreModule::SupportsStatelessNavigation |
-                                          QtIviCoreModule::SupportsGetSize
+                                          QtIviCoreModule::SupportsGetSize |
+                                          QtIviCoreModule::SupportsContinuationTokens
                                           ));
 
     if (!m_state.contains(identifier)) {
@@ -129,10 +142,6 @@ void SearchAndBrowseBackend::fetchData(const QUuid &identifier, int start, int c
     }
     QString current_type = types.last();
 
-    QString order;
-    if (!state.orderTerms.isEmpty())
-        order = QStringLiteral("ORDER BY %1").arg(createSortOrder(current_type, state.orderTerms));
-
     QString columns;
     QString groupBy;
     if (current_type == artistLiteral) {
@@ -145,53 +154,131 @@ void SearchAndBrowseBackend::fetchData(const QUuid &identifier, int start, int c
         columns = QStringLiteral("artistName, albumName, trackName, genre, number, file, id, coverArtUrl");
     }
 
-    QString filterClause = createWhereClause(current_type, state.queryTerm);
+    QString filterClause = createWhereClause(current_type, state.query.term());
     if (!filterClause.isEmpty())
         where_clauses.append(filterClause);
 
     QString whereClause = where_clauses.join(QStringLiteral(" AND "));
 
-    QString countQuery = QStringLiteral("SELECT count() FROM (SELECT %1 FROM track %2 %3)")
-            .arg(columns,
-                 whereClause.isEmpty() ? QString() : QStringLiteral("WHERE ") + whereClause,
-                 groupBy.isEmpty() ? QString() : QStringLiteral("GROUP BY ") + groupBy);
-
-    QtConcurrent::run(m_threadPool, [this, countQuery, identifier]() {
-        QSqlQuery query(m_db);
-        if (query.exec(countQuery)) {
-            while (query.next()) {
-                emit countChanged(identifier, query.value(0).toInt());
+    //The rows are always sorted by a unique key, to be able to continue after the last row of a chunk
+    const QVector<SortKey> sortKeys = createSortKeys(current_type, state.query.orderTerms());
+    QStringList keyColumns;
+    QStringList order;
+    for (const SortKey &key : sortKeys) {
+        keyColumns.append(key.column);
+        order.append(key.column + (key.ascending ? QStringLiteral(" ASC") : QStringLiteral(" DESC")));
+    }
+
+    //Tokens of a different query or content type can't be used
+    const uint fingerprint = qHash(state.contentType + QLatin1Char('\n') + whereClause + QLatin1Char('\n') + order.join(','));
+
+    QVariantList keyValues;
+    uint tokenFingerprint = 0;
+    QDataStream stream(continuationToken);
+    stream >> tokenFingerprint >> keyValues;
+    bool continued = stream.status() == QDataStream::Ok && tokenFingerprint == fingerprint && keyValues.count() == sortKeys.count();
+
+    //Continue after the last row: (key1 > v1) OR (key1 IS v1 AND key2 > v2) OR ...
+    //SQLite sorts NULL before all other values, i.e. first in ascending and last in descending order.
+    QString keysetClause;
+    QVariantList bindValues;
+    if (continued) {
+        QStringList alternatives;
+        for (int i = 0; i < sortKeys.count(); i++) {
+            const QString &column = sortKeys.at(i).column;
+            const QVariant &value = keyValues.at(i);
+            //Nothing follows NULL in descending order
+            if (value.isNull() && !sortKeys.at(i).ascending)
+                continue;
+
+            QStringList conditions;
+            for (int j = 0; j < i; j++) {
+                conditions.append(sortKeys.at(j).column + QStringLiteral(" IS ?"));
+                bindValues.append(keyValues.at(j));
             }
-        } else {
-            sqlError(this, query.lastQuery(), query.lastError().text());
+            if (value.isNull()) {
+                conditions.append(column + QStringLiteral(" IS NOT NULL"));
+            } else if (sortKeys.at(i).ascending) {
+                conditions.append(column + QStringLiteral(" > ?"));
+                bindValues.append(value);
+            } else {
+                conditions.append(QStringLiteral("(%1 < ? OR %1 IS NULL)").arg(column));
+                bindValues.append(value);
+            }
+            alternatives.append(QStringLiteral("(%1)").arg(conditions.join(QStringLiteral(" AND "))));
         }
-    });
+        keysetClause = alternatives.isEmpty() ? QStringLiteral("0")
+                                              : QStringLiteral("(%1)").arg(alternatives.join(QStringLiteral(" OR ")));
+    }
+
+    //The number of items doesn't change while continuing the same query
+    if (!continued) {
+        QString countQuery = QStringLiteral("SELECT count() FROM (SELECT %1 FROM track %2 %3)")
+                .arg(columns,
+                     whereClause.isEmpty() ? QString() : QStringLiteral("WHERE ") + whereClause,
+                     groupBy.isEmpty() ? QString() : QStringLiteral("GROUP BY ") + groupBy);
+
+        QtConcurrent::run(m_threadPool, [this, countQuery, identifier]() {
+            QSqlQuery query(m_db);
+            if (query.exec(countQuery)) {
+                while (query.next()) {
+                    emit countChanged(identifier, query.value(0).toInt());
+                }
+            } else {
+                sqlError(this, query.lastQuery(), query.lastError().text());
+            }
+        });
+    }
+
+    //The key of a grouped row can only be compared after grouping
+    QString rowWhereClause = whereClause;
+    QString havingClause;
+    if (continued && groupBy.isEmpty())
+        rowWhereClause = whereClause.isEmpty() ? keysetClause : QStringLiteral("(%1) AND %2").arg(whereClause, keysetClause);
+    else if (continued)
+        havingClause = keysetClause;
 
-    QString queryString = QStringLiteral("SELECT %1 FROM track %2 %3 %4 LIMIT %5, %6")
+    QString queryString = QStringLiteral("SELECT %1, %2 FROM track %3 %4 %5 ORDER BY %6 LIMIT %7")
             .arg(columns,
-            whereClause.isEmpty() ? QString() : QStringLiteral("WHERE ") + whereClause,
-            order,
-            groupBy.isEmpty() ? QString() : QStringLiteral("GROUP BY ") + groupBy,
-            QString::number(start),
-            QString::number(count));
-
-    QtConcurrent::run(m_threadPool,
-                      this,
-                      &SearchAndBrowseBackend::search,
-                      identifier,
-                      queryString,
-                      current_type,
-                      start,
-                      count);
+                 keyColumns.join(QStringLiteral(", ")),
+                 rowWhereClause.isEmpty() ? QString() : QStringLiteral("WHERE ") + rowWhereClause,
+                 groupBy.isEmpty() ? QString() : QStringLiteral("GROUP BY ") + groupBy,
+                 havingClause.isEmpty() ? QString() : QStringLiteral("HAVING ") + havingClause,
+                 order.join(QStringLiteral(", ")),
+                 continued ? QString::number(count) : QStringLiteral("%1, %2").arg(start).arg(count));
+
+    SearchRequest request;
+    request.identifier = identifier;
+    request.queryString = queryString;
+    request.bindValues = bindValues;
+    request.type = current_type;
+    request.start = start;
+    request.count = count;
+    request.keyColumn = columns.count(QLatin1Char(',')) + 1;
+    request.keyCount = sortKeys.count();
+    request.fingerprint = fingerprint;
+
+    QtConcurrent::run(m_threadPool, [this, request]() {
+        search(request);
+    });
 }
 
-void SearchAndBrowseBackend::search(const QUuid &identifier, const QString &queryString, const QString &type, int start, int count)
+void SearchAndBrowseBackend::search(const SearchRequest &request)
 {
+    const QString &type = request.type;
     QVariantList list;
+    QVariantList keyValues;
     QSqlQuery query(m_db);
+    query.prepare(request.queryString);
+    for (const QVariant &value : request.bindValues)
+        query.addBindValue(value);
 
-    if (query.exec(queryString)) {
+    if (query.exec()) {
         while (query.next()) {
+            keyValues.clear();
+            for (int i = 0; i < request.keyCount; i++)
+                keyValues.append(query.value(request.keyColumn + i));
+
             QString artist = query.value(0).toString();
             QString album = query.value(1).toString();
 
@@ -243,27 +330,39 @@ void SearchAndBrowseBackend::search(const QUuid &identifier, const QString &quer
         qCWarning(media) << query.lastError().text();
     }
 
-    emit dataFetched(identifier, list, start, list.count() >= count);
+    //The sort key of the last row is all what's needed to continue with the next chunk
+    if (!list.isEmpty()) {
+        QByteArray continuationToken;
+        QDataStream stream(&continuationToken, QIODevice::WriteOnly);
+        stream << request.fingerprint << keyValues;
+        emit continuationTokenAvailable(request.identifier, request.start + list.count(), continuationToken);
+    }
+
+    emit dataFetched(request.identifier, list, request.start, list.count() >= request.count);
 }
 
-QString SearchAndBrowseBackend::createSortOrder(const QString &type, const QList<QIviOrderTerm> &orderTerms)
+QVector<SearchAndBrowseBackend::SortKey> SearchAndBrowseBackend::createSortKeys(const QString &type, const QList<QIviOrderTerm> &orderTerms)
 {
-    QStringList order;
-    int i = 0;
-    for (const QIviOrderTerm & term : orderTerms) {
-        if (i)
-            order.append(QStringLiteral(","));
-
-        order.append(mapIdentifiers(type, term.propertyName()));
-        if (term.isAscending())
-            order.append(QStringLiteral("ASC"));
-        else
-            order.append(QStringLiteral("DESC"));
+    QVector<SortKey> keys;
+    for (const QIviOrderTerm &term : orderTerms)
+        keys.append({ mapIdentifiers(type, term.propertyName()), term.isAscending() });
+
+    //Make the order unique, otherwise the rows following the last one can't be determined
+    QStringList uniqueColumns;
+    if (type == artistLiteral)
+        uniqueColumns = QStringList({ QStringLiteral("artistName") });
+    else if (type == albumLiteral)
+        uniqueColumns = QStringList({ QStringLiteral("artistName"), QStringLiteral("albumName") });
+    else
+        uniqueColumns = QStringList({ QStringLiteral("id") });
 
-        i++;
+    for (const QString &column : qAsConst(uniqueColumns)) {
+        auto it = std::find_if(keys.cbegin(), keys.cend(), [column](const SortKey &key) { return key.column == column; });
+        if (it == keys.cend())
+            keys.append({ column, true });
     }
 
-    return order.join(' ');
+    return keys;
 }
 
 QString SearchAndBrowseBackend::mapIdentifiers(const QString &type, const QString &identifer)
@@ -280,18 +379,18 @@ QString SearchAndBrowseBackend::mapIdentifiers(const QString &type, const QStrin
     return identifer;
 }
 
-QString SearchAndBrowseBackend::createWhereClause(const QString &type, QIviAbstractQueryTerm *term)
+QString SearchAndBrowseBackend::createWhereClause(const QString &type, const QIviAbstractQueryTerm *term)
 {
     if (!term)
         return QString();
 
     switch (term->type()) {
     case QIviAbstractQueryTerm::ScopeTerm: {
-        auto *scope = static_cast<QIviScopeTerm*>(term);
+        auto *scope = static_cast<const QIviScopeTerm*>(term);
         return QStringLiteral("%1 (%2)").arg(scope->isNegated() ? QStringLiteral("NOT") : QString(), createWhereClause(type, scope->term()));
     }
     case QIviAbstractQueryTerm::ConjunctionTerm: {
-        auto *conjunctionTerm = static_cast<QIviConjunctionTerm*>(term);
+        auto *conjunctionTerm = static_cast<const QIviConjunctionTerm*>(term);
         QString conjunction = QStringLiteral("AND");
         if (conjunctionTerm->conjunction() == QIviConjunctionTerm::Or)
             conjunction = QStringLiteral("OR");
@@ -306,7 +405,7 @@ QString SearchAndBrowseBackend::createWhereClause(const QString &type, QIviAbstr
         return string;
     }
     case QIviAbstractQueryTerm::FilterTerm: {
-        auto *filter = static_cast<QIviFilterTerm*>(term);
+        auto *filter = static_cast<const QIviFilterTerm*>(term);
         QString operatorString;
         bool negated = filter->isNegated();
         QString value;
@@ -49,6 +49,7 @@
 
 #include <QSqlDatabase>
 #include <QStack>
+#include <QVector>
 
 QT_FORWARD_DECLARE_CLASS(QThreadPool);
 
@@ -79,8 +80,9 @@ public:
     void registerInstance(const QUuid &identifier) override;
     void unregisterInstance(const QUuid &identifier) override;
     void setContentType(const QUuid &identifier, const QString &contentType) override;
-    void setupFilter(const QUuid &identifier, QIviAbstractQueryTerm *term, const QList<QIviOrderTerm> &orderTerms) override;
+    Q_INVOKABLE void setupQuery(const QUuid &identifier, const QIviQuery &query);
     void fetchData(const QUuid &identifier, int start, int count) override;
+    Q_INVOKABLE void fetchDataAfter(const QUuid &identifier, const QByteArray &continuationToken, int start, int count);
     bool canGoBack(const QUuid &identifier, const QString &type) override;
     QString goBack(const QUuid &identifier, const QString &type) override;
     bool canGoForward(const QUuid &identifier, const QString &type, const QString &itemId) override;
@@ -91,19 +93,35 @@ public:
     QIviPendingReply<void> move(const QUuid &identifier, const QString &type, int currentIndex, int newIndex) override;
     QIviPendingReply<int> indexOf(const QUuid &identifier, const QString &type, const QIviStandardItem *item) override;
 
-private slots:
-    void search(const QUuid &identifier, const QString &queryString, const QString &type, int start, int count);
-    QString createSortOrder(const QString &type, const QList<QIviOrderTerm> &orderTerms);
-    QString createWhereClause(const QString &type, QIviAbstractQueryTerm *term);
 private:
+    struct SortKey {
+        QString column;
+        bool ascending;
+    };
+
+    struct SearchRequest {
+        QUuid identifier;
+        QString queryString;
+        QVariantList bindValues;
+        QString type;
+        int start;
+        int count;
+        int keyColumn;
+        int keyCount;
+        uint fingerprint;
+    };
+
+    void fetchRows(const QUuid &identifier, const QByteArray &continuationToken, int start, int count);
+    void search(const SearchRequest &request);
+    QVector<SortKey> createSortKeys(const QString &type, const QList<QIviOrderTerm> &orderTerms);
+    QString createWhereClause(const QString &type, const QIviAbstractQueryTerm *term);
     QString mapIdentifiers(const QString &type, const QString &identifer);
 
     QSqlDatabase m_db;
     QThreadPool *m_threadPool;
     struct State {
         QString contentType;
-        QIviAbstractQueryTerm *queryTerm = nullptr;
-        QList<QIviOrderTerm> orderTerms;
+        QIviQuery query;
     };
     QMap<QUuid, State> m_state;
 };
@@ -67,6 +67,7 @@ void SearchAndBrowseBackend::registerInstance(const QUuid &identifier)
 void SearchAndBrowseBackend::unregisterInstance(const QUuid &identifier)
 {
     m_contentType.remove(identifier);
+    m_queries.remove(identifier);
 }
 
 void SearchAndBrowseBackend::setContentType(const QUuid &identifier, const QString &contentType)
@@ -74,16 +75,23 @@ void SearchAndBrowseBackend::setContentType(const QUuid &identifier, const QStri
     m_contentType[identifier] = contentType;
 }
 
-void SearchAndBrowseBackend::setupFilter(const QUuid &identifier, QIviAbstractQueryTerm *term, const QList<QIviOrderTerm> &orderTerms)
+void SearchAndBrowseBackend::setupQuery(const QUuid &identifier, const QIviQuery &query)
 {
-    Q_UNUSED(identifier)
-    Q_UNUSED(term)
-    Q_UNUSED(orderTerms)
+    const QIviQueryEvaluator evaluator(query, &QIviAmFmTunerStation::staticMetaObject);
+    if (!evaluator.isValid()) {
+        qWarning() << "SIMULATION Invalid query:" << evaluator.errorString();
+        emit errorChanged(QIviAbstractFeature::InvalidOperation, evaluator.errorString());
+    }
+    m_queries.insert(identifier, evaluator);
 }
 
 void SearchAndBrowseBackend::fetchData(const QUuid &identifier, int start, int count)
 {
     emit supportedCapabilitiesChanged(identifier, QtIviCoreModule::ModelCapabilities(
+                                          QtIviCoreModule::SupportsFiltering |
+                                          QtIviCoreModule::SupportsSorting |
+                                          QtIviCoreModule::SupportsAndConjunction |
+                                          QtIviCoreModule::SupportsOrConjunction |
                                           QtIviCoreModule::SupportsStatelessNavigation |
                                           QtIviCoreModule::SupportsGetSize |
                                           QtIviCoreModule::SupportsInsert |
@@ -100,14 +108,15 @@ void SearchAndBrowseBackend::fetchData(const QUuid &identifier, int start, int c
     else
         return;
 
-    emit countChanged(identifier, stations.length());
-    QVariantList requestedStations;
+    // A query which failed to compile doesn't match anything, see setupQuery()
+    const QVector<QIviAmFmTunerStation> rows = filteredStations(identifier, stations);
 
-    int size = qMin(count, stations.length());
-    for (int i = start; i < size; i++)
-        requestedStations.append(QVariant::fromValue(stations.at(i)));
+    emit countChanged(identifier, rows.length());
+    QVariantList requestedStations;
+    for (int i = start; i < qMin(start + count, rows.length()); i++)
+        requestedStations.append(QVariant::fromValue(rows.at(i)));
 
-    emit dataFetched(identifier, requestedStations, start, start + count < stations.length());
+    emit dataFetched(identifier, requestedStations, start, start + count < rows.length());
 }
 
 bool SearchAndBrowseBackend::canGoBack(const QUuid &identifier, const QString &type)
@@ -145,10 +154,21 @@ QIviPendingReply<void> SearchAndBrowseBackend::insert(const QUuid &identifier, c
     if (type != QLatin1String("presets") || item->type() != QLatin1String("amfmtunerstation"))
         return QIviPendingReply<void>::createFailedReply();
 
+    // The index is relative to the filtered and sorted rows of this instance
+    const QVector<int> rows = evaluateQuery(identifier, m_presets);
+    if (index < 0 || index > rows.count())
+        return QIviPendingReply<void>::createFailedReply();
+
+    const int presetIndex = index < rows.count() ? rows.at(index) : m_presets.count();
     const QIviAmFmTunerStation &station = *static_cast<const QIviAmFmTunerStation*>(item);
-    m_presets.insert(index, station);
-    QVariantList stations = { QVariant::fromValue(station) };
-    emit dataChanged(identifier, stations, index, 0);
+    m_presets.insert(presetIndex, station);
+
+    // The new station is only visible if it matches the query, at the position given by the order
+    const int row = evaluateQuery(identifier, m_presets).indexOf(presetIndex);
+    if (row != -1) {
+        QVariantList stations = { QVariant::fromValue(station) };
+        emit dataChanged(identifier, stations, row, 0);
+    }
 
     QIviPendingReply<void> reply;
     reply.setSuccess();
@@ -160,7 +180,11 @@ QIviPendingReply<void> SearchAndBrowseBackend::remove(const QUuid &identifier, c
     if (type != QLatin1String("presets"))
         return QIviPendingReply<void>::createFailedReply();
 
-    m_presets.removeAt(index);
+    const QVector<int> rows = evaluateQuery(identifier, m_presets);
+    if (index < 0 || index >= rows.count())
+        return QIviPendingReply<void>::createFailedReply();
+
+    m_presets.removeAt(rows.at(index));
     emit dataChanged(identifier, QVariantList(), index, 1);
 
     QIviPendingReply<void> reply;
@@ -173,15 +197,30 @@ QIviPendingReply<void> SearchAndBrowseBackend::move(const QUuid &identifier, con
     if (type != QLatin1String("presets"))
         return QIviPendingReply<void>::createFailedReply();
 
-    int min = qMin(currentIndex, newIndex);
-    int max = qMax(currentIndex, newIndex);
+    QVector<QIviAmFmTunerStation> oldRows = filteredStations(identifier, m_presets);
+    const QVector<int> rows = evaluateQuery(identifier, m_presets);
+    if (currentIndex < 0 || currentIndex >= rows.count() || newIndex < 0 || newIndex >= rows.count())
+        return QIviPendingReply<void>::createFailedReply();
+
+    m_presets.move(rows.at(currentIndex), rows.at(newIndex));
 
-    m_presets.move(currentIndex, newIndex);
-    QVariantList stations;
-    for (int i = min; i <= max; i++)
-        stations.append(QVariant::fromValue(m_presets.at(i)));
+    // Within a sorted result the station only moves between equal stations, if at all.
+    // Only the rows between the first and the last changed one need to be updated.
+    const QVector<QIviAmFmTunerStation> newRows = filteredStations(identifier, m_presets);
+    int first = 0;
+    int last = newRows.count() - 1;
+    while (first <= last && oldRows[first] == newRows.at(first))
+        first++;
+    while (last > first && oldRows[last] == newRows.at(last))
+        last--;
 
-    emit dataChanged(identifier, stations, min, max - min + 1);
+    if (first <= last) {
+        QVariantList stations;
+        for (int i = first; i <= last; i++)
+            stations.append(QVariant::fromValue(newRows.at(i)));
+
+        emit dataChanged(identifier, stations, first, last - first + 1);
+    }
 
     QIviPendingReply<void> reply;
     reply.setSuccess();
@@ -190,8 +229,6 @@ QIviPendingReply<void> SearchAndBrowseBackend::move(const QUuid &identifier, con
 
 QIviPendingReply<int> SearchAndBrowseBackend::indexOf(const QUuid &identifier, const QString &type, const QIviStandardItem *item)
 {
-    Q_UNUSED(identifier)
-
     if (item->type() != QLatin1String("amfmtunerstation"))
         return QIviPendingReply<int>::createFailedReply();
 
@@ -206,7 +243,41 @@ QIviPendingReply<int> SearchAndBrowseBackend::indexOf(const QUuid &identifier, c
 
     QIviAmFmTunerStation station = *static_cast<const QIviAmFmTunerStation*>(item);
 
+    // Return the index within the filtered and sorted rows, -1 if the station is filtered out
+    int index = stations.indexOf(station);
+    if (index != -1)
+        index = evaluateQuery(identifier, stations).indexOf(index);
+
     QIviPendingReply<int> reply;
-    reply.setSuccess(stations.indexOf(station));
+    reply.setSuccess(index);
     return reply;
 }
+
+// Returns the indexes of the stations matching the query of identifier, in the order requested
+// by the query. Without a query all stations are returned in their original order.
+QVector<int> SearchAndBrowseBackend::evaluateQuery(const QUuid &identifier, const QVector<QIviAmFmTunerStation> &stations) const
+{
+    const auto it = m_queries.constFind(identifier);
+    if (it != m_queries.constEnd()) {
+        QVariantList items;
+        items.reserve(stations.length());
+        for (const QIviAmFmTunerStation &station : stations)
+            items.append(QVariant::fromValue(station));
+        return it->evaluate(items);
+    }
+
+    QVector<int> rows(stations.length());
+    for (int i = 0; i < rows.length(); i++)
+        rows[i] = i;
+    return rows;
+}
+
+QVector<QIviAmFmTunerStation> SearchAndBrowseBackend::filteredStations(const QUuid &identifier, const QVector<QIviAmFmTunerStation> &stations) const
+{
+    const QVector<int> rows = evaluateQuery(identifier, stations);
+    QVector<QIviAmFmTunerStation> result;
+    result.reserve(rows.length());
+    for (int index : rows)
+        result.append(stations.at(index));
+    return result;
+}
@@ -43,6 +43,7 @@
 #ifndef SEARCHBACKEND_H
 #define SEARCHBACKEND_H
 
+#include <QtIviCore/QIviQueryEvaluator>
 #include <QtIviCore/QIviSearchAndBrowseModel>
 #include <QtIviCore/QIviSearchAndBrowseModelInterface>
 #include <QtIviMedia/QIviAmFmTunerStation>
@@ -59,7 +60,7 @@ public:
     void registerInstance(const QUuid &identifier) override;
     void unregisterInstance(const QUuid &identifier) override;
     void setContentType(const QUuid &identifier, const QString &contentType) override;
-    void setupFilter(const QUuid &identifier, QIviAbstractQueryTerm *term, const QList<QIviOrderTerm> &orderTerms) override;
+    Q_INVOKABLE void setupQuery(const QUuid &identifier, const QIviQuery &query);
     void fetchData(const QUuid &identifier, int start, int count) override;
     bool canGoBack(const QUuid &identifier, const QString &type) override;
     QString goBack(const QUuid &identifier, const QString &type) override;
@@ -71,10 +72,13 @@ public:
     QIviPendingReply<void> move(const QUuid &identifier, const QString &type, int currentIndex, int newIndex) override;
     QIviPendingReply<int> indexOf(const QUuid &identifier, const QString &type, const QIviStandardItem *item) override;
 private:
+    QVector<int> evaluateQuery(const QUuid &identifier, const QVector<QIviAmFmTunerStation> &stations) const;
+    QVector<QIviAmFmTunerStation> filteredStations(const QUuid &identifier, const QVector<QIviAmFmTunerStation> &stations) const;
 
     AmFmTunerBackend *m_tunerBackend;
     QVector<QIviAmFmTunerStation> m_presets;
     QHash<QUuid, QString> m_contentType;
+    QHash<QUuid, QIviQueryEvaluator> m_queries;
 };
 
 #endif // SEARCHBACKEND_H
@@ -61,6 +61,8 @@ Filters.classPrefix = ''
 
 builtin_config = {}
 IVI_DEFAULT_TEMPLATES = ['frontend', 'backend_simulator', 'generation_validator', 'control_panel', 'backend_qtro', 'server_qtro', 'test']
+# Property names which clash with the functions generated to update all properties at once
+RESERVED_PROPERTY_NAMES = ['properties', 'allProperties']
 
 def tag_by_path(symbol, path, default_value=False):
     """
@@ -651,6 +653,26 @@ def struct_includes(symbol):
     return includesSet
 
 
+def validate_system(system):
+    """
+    Checks that the names used in the IDL don't clash with the names used by the generated code
+    """
+    for module in system.modules:
+        struct_names = [struct.name for struct in module.structs]
+        for interface in module.interfaces:
+            for property in interface.properties:
+                if property.name in RESERVED_PROPERTY_NAMES:
+                    print('{0}.{1}: the property name "{1}" is reserved by the generated code. '
+                          'Reserved names are: {2}'.format(interface.qualified_name, property.name,
+                                                           ', '.join(RESERVED_PROPERTY_NAMES)))
+                    exit(1)
+            state_name = '{0}State'.format(interface.name)
+            if state_name in struct_names:
+                print('{0}: the struct name "{1}" is reserved by the generated code for the state '
+                      'of the interface'.format(module.name, state_name))
+                exit(1)
+
+
 def generate(tplconfig, moduleConfig, annotations, src, dst):
     log.debug('run {0} {1}'.format(src, dst))
     FileSystem.strict = True
@@ -664,6 +686,7 @@ def generate(tplconfig, moduleConfig, annotations, src, dst):
             print('no such annotation file: {0}'.format(annotations_file))
             exit(1)
         FileSystem.merge_annotations(system, Path(annotations_file))
+    validate_system(system)
     generator = Generator(search_path=[tplconfig, here / "common"])
     generator.register_filter('return_type', return_type)
     generator.register_filter('parameter_type_default', parameter_type_default)
@@ -80,6 +80,15 @@ QT_BEGIN_NAMESPACE
 }
 {% endfor %}
 
+{{interface}}State {{zone_class}}::allProperties() const
+{
+    {{interface}}State properties;
+{% for property in interface.properties if not property.type.is_model %}
+    properties.{{property}} = m_{{property}};
+{% endfor %}
+    return properties;
+}
+
 {% for property in interface.properties %}
 {{ivi.prop_setter(property, zone_class, model_interface = true)}}
 {
@@ -112,6 +121,7 @@ QT_BEGIN_NAMESPACE
 {% if interface_zoned %}
     , m_zones(new QQmlPropertyMap(this))
 {% endif %}
+    , m_initialized(false)
 {% if 'simulator' in features %}
     , mWorker(nullptr)
 {% endif %}
@@ -120,6 +130,11 @@ QT_BEGIN_NAMESPACE
     Q_UNUSED(engine)
     qRegisterMetaType<QQmlPropertyMap*>();
 
+    //initialize() might be overridden by the simulation QML, which also signals the end of it
+    connect(this, &{{class}}::initializationDone, this, [this]() {
+        m_initialized = true;
+    });
+
 {% for property in interface.properties %}
 {%   if not property.tags.config_simulator or not property.tags.config_simulator.zoned %}
 {%       if property.type.is_model %}
@@ -153,8 +168,11 @@ QStringList {{class}}::availableZones() const
     QStringList zones;
     QIVI_SIMULATION_TRY_CALL_FUNC({{class}}, "availableZones", zones = return_value.toStringList());
 
-    for (const QString &zone : zones)
-        const_cast<{{class}}*>(this)->addZone(zone);
+    // availableZones() is called by every connecting feature, keep the state of known zones
+    for (const QString &zone : zones) {
+        if (!m_zoneMap.contains(zone))
+            const_cast<{{class}}*>(this)->addZone(zone);
+    }
     return zones;
 }
 {% endif %}
@@ -169,18 +187,25 @@ QStringList {{class}}::availableZones() const
 void {{class}}::initialize()
 {
     QIVI_SIMULATION_TRY_CALL({{class}}, "initialize", void);
+{% if not interface_zoned  %}
+    emit propertiesChanged(allProperties());
+{% endif %}
 {% for property in interface.properties %}
 {%   if not interface_zoned  %}
+{%     if property.type.is_model %}
     emit {{property}}Changed(m_{{property}});
+{%     endif %}
 {%   elif not property.tags.config_simulator or not property.tags.config_simulator.zoned%}
     emit {{property}}Changed(m_{{property}}, QString());
 {%   endif %}
 {% endfor %}
 
 {% if interface.tags.config.zoned %}
-    for (const QString &zone : m_zones->keys()) {
-        {{interface}}Zone *zo = zoneAt(zone);
-{%   for property in interface.properties %}
+    for (auto it = m_zoneMap.cbegin(); it != m_zoneMap.cend(); ++it) {
+        const QString &zone = it.key();
+        {{interface}}Zone *zo = it.value();
+        emit propertiesChanged(zo->allProperties(), zone);
+{%   for property in interface.properties if property.type.is_model %}
         emit {{property}}Changed(zo->{{property|getter_name}}(), zone);
 {%   endfor %}
     }
@@ -207,15 +232,69 @@ void {{class}}::initialize()
     emit initializationDone();
 }
 
+/*!
+    \fn bool {{class}}::replayState(QIviAbstractFeature *subscriber)
+
+    Sends the current state (property values) to the \a subscriber only, once the backend
+    has been initialized.
+
+    Returns \c false if the backend is not initialized yet, in which case initialize()
+    is called instead.
+*/
+bool {{class}}::replayState(QIviAbstractFeature *subscriber)
+{
+    if (!m_initialized)
+        return false;
+
+{% if not interface_zoned  %}
+    replayPropertiesChanged(subscriber, allProperties());
+{% endif %}
+{% for property in interface.properties %}
+{%   if not interface_zoned  %}
+{%     if property.type.is_model %}
+    replay{{property|upperfirst}}Changed(subscriber, m_{{property}});
+{%     endif %}
+{%   elif not property.tags.config_simulator or not property.tags.config_simulator.zoned%}
+    replay{{property|upperfirst}}Changed(subscriber, m_{{property}}, QString());
+{%   endif %}
+{% endfor %}
+
+{% if interface.tags.config.zoned %}
+    for (auto it = m_zoneMap.cbegin(); it != m_zoneMap.cend(); ++it) {
+        const QString &zone = it.key();
+        {{interface}}Zone *zo = it.value();
+        replayPropertiesChanged(subscriber, zo->allProperties(), zone);
+{%   for property in interface.properties if property.type.is_model %}
+        replay{{property|upperfirst}}Changed(subscriber, zo->{{property|getter_name}}(), zone);
+{%   endfor %}
+    }
+{% endif %}
+    return true;
+}
+
 {% if interface_zoned %}
+/*!
+    \fn void {{class}}::addZone(const QString &zone)
+
+    Adds a new zone with the name \a zone and the default values.
+
+    An already existing zone with the same name is replaced and its zone object is deleted.
+*/
 void {{class}}::addZone(const QString &zone)
 {
-    m_zones->insert(zone, QVariant::fromValue(new {{zone_class}}(zone, this)));
+    {{zone_class}} *oldZone = m_zoneMap.value(zone);
+    auto zo = new {{zone_class}}(zone, this);
+    m_zoneMap.insert(zone, zo);
+    m_zones->insert(zone, QVariant::fromValue(zo));
+
+    //The simulation QML might still access the old zone object until the event loop runs
+    if (oldZone)
+        oldZone->deleteLater();
 }
 
 {{zone_class}}* {{class}}::zoneAt(const QString &zone)
 {
-    return m_zones->value(zone).value<{{zone_class}}*>();
+    return m_zoneMap.value(zone);
 }
 {% endif %}
 
@@ -226,6 +305,18 @@ void {{class}}::addZone(const QString &zone)
 }
 {% endfor %}
 
+/*!
+    Returns the values of all properties, which are not models.
+*/
+{{interface}}State {{class}}::allProperties() const
+{
+    {{interface}}State properties;
+{% for property in interface.properties if not property.type.is_model %}
+    properties.{{property}} = m_{{property}};
+{% endfor %}
+    return properties;
+}
+
 {% for property in interface.properties %}
 /*!
     \fn virtual {{ivi.prop_setter(property, class, interface_zoned)}}
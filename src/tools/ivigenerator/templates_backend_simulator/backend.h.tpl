@@ -49,6 +49,7 @@
 
 #include <QObject>
 #include <QQmlPropertyMap>
+#include <QHash>
 {% if module.tags.config.module %}
 #include <{{module.tags.config.module}}/{{class}}Interface>
 {% else %}
@@ -88,6 +89,7 @@ public:
 {% for property in interface.properties %}
     {{ivi.prop_getter(property, model_interface = true)}};
 {% endfor %}
+    {{interface}}State allProperties() const;
 
 public Q_SLOTS:
 {% for property in interface.properties %}
@@ -137,6 +139,7 @@ public:
 {%   endif %}
 
     Q_INVOKABLE void initialize() override;
+    Q_INVOKABLE bool replayState(QIviAbstractFeature *subscriber);
 {% if interface_zoned %}
     void addZone(const QString &zone);
     {{zone_class}}* zoneAt(const QString &zone);
@@ -145,6 +148,7 @@ public:
 {% for property in interface.properties %}
     {{ivi.prop_getter(property, model_interface = true)}};
 {% endfor %}
+    {{interface}}State allProperties() const;
 {% if interface_zoned %}
     QQmlPropertyMap *zones() const { return m_zones; }
 {% endif %}
@@ -177,7 +181,9 @@ protected:
 {% endfor %}
 {% if interface_zoned %}
     QQmlPropertyMap *m_zones;
+    QHash<QString, {{zone_class}}*> m_zoneMap;
 {% endif %}
+    bool m_initialized;
 
 {% if 'simulator' in features %}
     QSimulatorConnection *mConnection;
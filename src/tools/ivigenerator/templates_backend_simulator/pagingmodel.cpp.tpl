@@ -79,12 +79,10 @@ void {{class}}::fetchData(const QUuid &identifier, int start, int count)
 
     qCritical() << "FETCH" << identifier << start << count;
 
-    QVariantList list;
     int max = qMin(start + count, m_list.count());
-    for(int i=start; i < max; i++)
-        list.append(QVariant::fromValue(m_list.at(i)));
+    QIviStandardItemBatch batch = QIviStandardItemBatch::fromList(m_list.mid(start, max - start));
 
-    emit dataFetched(identifier, list, start, max <  m_list.count());
+    emit batchFetched(identifier, batch, start, max <  m_list.count());
 }
 
 void {{class}}::insert(int index, const {{property.type.nested}} &item)
@@ -41,9 +41,24 @@
 {% include 'generated_comment.cpp.tpl' %}
 
 #include "{{class|lower}}.h"
+#include "{{interface|lower}}.h"
+#include "{{interface|lower}}_p.h"
 
 QT_BEGIN_NAMESPACE
 
+/*!
+    \class {{interface}}State
+    \inmodule {{module}}
+    \ingroup backends
+
+    \brief Holds the state of all properties of {{interface}}.
+
+    The state is sent by the propertiesChanged() signal of \l {{class}} to update multiple properties
+    at once. Properties holding a model are not part of the state.
+
+    \sa {{class}}::propertiesChanged()
+*/
+
 /*!
     \class {{class}}
     \inmodule {{module}}
@@ -62,6 +77,13 @@ QT_BEGIN_NAMESPACE
     The interface is discovered by a \l {{interface}} object, which connects to it and sets up
     the connections to it.
 
+    The backend is initialized by the first \l {{interface}} which connects to it. If the backend
+    provides an invokable \c replayState() function, all features connecting afterwards call it
+    instead, see \l {QIviFeatureInterface#Replaying the State}{Replaying the State}. The
+    backend sends its current state to the new feature by calling the protected \e replay
+    functions of this class. The values are delivered queued, i.e. once the feature has finished
+    connecting to the backend and all its zones exist.
+
     \sa {{interface}}
  */
 {{class}}::{{class}}(QObject *parent)
@@ -71,6 +93,7 @@ QT_BEGIN_NAMESPACE
     : QIviFeatureInterface(parent)
 {% endif %}
 {
+    qRegisterMetaType<{{interface}}State>();
 }
 
 {{class}}::~{{class}}()
@@ -120,6 +143,20 @@ QT_BEGIN_NAMESPACE
 {%   endif %}
 */
 {% endfor %}
+/*!
+    \fn void {{class}}::propertiesChanged(const {{interface}}State &properties{% if interface.tags.config.zoned %}, const QString &zone = QString(){% endif %});
+
+    The signal is emitted to update all properties to the values of \a properties at once.
+
+{% if interface.tags.config.zoned %}
+    The value of \a zone indicates the zone the state belongs to.
+
+{% endif %}
+    Other than emitting the change signals of every property, all properties are updated before
+    the change notifications are sent by \l {{interface}}. Notifications are only sent for
+    properties which actually changed. Backends changing multiple properties at once should use
+    this signal instead of the individual change signals.
+*/
 {% for property in interface.properties %}
 /*!
     \fn {{ivi.prop_notify(property, class, interface.tags.config.zoned)}};
@@ -136,5 +173,60 @@ QT_BEGIN_NAMESPACE
     \sa {{interface}}::{{property}}
 */
 {% endfor %}
+{% for property in interface.properties %}
+/*!
+    Sends the current value of the \e {{property}} property, passed by \a {{property}}, to the
+    \a subscriber only.
+
+{%   if interface.tags.config.zoned %}
+    The value of \a zone indicates the zone this property belongs to.
+
+{%   endif %}
+    Other than emitting the \l {{property}}Changed() signal, this doesn't affect any other
+    {{interface}} connected to this backend. It is meant to be called from a replayState()
+    implementation.
+*/
+{{ivi.replay_prop_changed(property, class, interface.tags.config.zoned)}}
+{
+{%   set parameters = property.name %}
+{%   if interface.tags.config.zoned %}
+{%     set parameters = parameters + ', zone' %}
+{%   endif %}
+    auto feature = qobject_cast<{{interface}}*>(subscriber);
+    if (!feature)
+        return;
+
+    QMetaObject::invokeMethod(feature, [feature, {{parameters}}]() {
+        {{interface}}Private::get(feature)->on{{property|upperfirst}}Changed({{parameters}});
+    }, Qt::QueuedConnection);
+}
+
+{% endfor %}
+/*!
+    Sends the current values of all properties, passed by \a properties, to the \a subscriber
+    only.
+
+{% if interface.tags.config.zoned %}
+    The value of \a zone indicates the zone the state belongs to.
+
+{% endif %}
+    Other than emitting the \l propertiesChanged() signal, this doesn't affect any other
+    {{interface}} connected to this backend. It is meant to be called from a replayState()
+    implementation.
+*/
+void {{class}}::replayPropertiesChanged(QIviAbstractFeature *subscriber, const {{interface}}State &properties{% if interface.tags.config.zoned %}, const QString &zone{% endif %})
+{
+{% set parameters = 'properties' %}
+{% if interface.tags.config.zoned %}
+{%   set parameters = parameters + ', zone' %}
+{% endif %}
+    auto feature = qobject_cast<{{interface}}*>(subscriber);
+    if (!feature)
+        return;
+
+    QMetaObject::invokeMethod(feature, [feature, {{parameters}}]() {
+        {{interface}}Private::get(feature)->onPropertiesChanged({{parameters}});
+    }, Qt::QueuedConnection);
+}
 
 QT_END_NAMESPACE
@@ -66,6 +66,15 @@
 
 QT_BEGIN_NAMESPACE
 
+struct {{interface}}State
+{
+{% for property in interface.properties %}
+{%   if not property.type.is_model %}
+    {{property|return_type}} {{property}} = {{property|default_type_value}};
+{%   endif %}
+{% endfor %}
+};
+
 class {{exportsymbol}} {{class}} : public {{base_class}}
 {
     Q_OBJECT
@@ -83,10 +92,17 @@ public:
     virtual {{ivi.operation(operation, zoned = interface.tags.config.zoned)}} = 0;
 {% endfor %}
 
+protected:
+{% for property in interface.properties %}
+    {{ivi.replay_prop_changed(property, zoned = interface.tags.config.zoned)}};
+{% endfor %}
+    void replayPropertiesChanged(QIviAbstractFeature *subscriber, const {{interface}}State &properties{% if interface.tags.config.zoned %}, const QString &zone{% endif %});
+
 Q_SIGNALS:
 {% for signal in interface.signals %}
     {{ivi.signal(signal, zoned = interface.tags.config.zoned)}};
 {% endfor %}
+    void propertiesChanged(const {{interface}}State &properties{% if interface.tags.config.zoned %}, const QString &zone = QString(){% endif %});
 {% for property in interface.properties %}
     {{ivi.prop_notify(property, zoned = interface.tags.config.zoned, model_interface = true, default_values = true)}};
 {% endfor %}
@@ -96,4 +112,6 @@ Q_SIGNALS:
 
 QT_END_NAMESPACE
 
+Q_DECLARE_METATYPE({{interface}}State)
+
 #endif // {{oncedefine}}
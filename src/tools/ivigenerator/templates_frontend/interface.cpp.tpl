@@ -86,6 +86,7 @@ QT_BEGIN_NAMESPACE
 {%   endif %}
     , q_ptr(parent)
 {% endif %}
+    , m_backendInterface(nullptr)
 {% for property in interface.properties %}
     , m_{{property}}({{property|default_type_value}})
 {% endfor %}
@@ -125,6 +126,21 @@ const {{class}}Private *{{class}}Private::get(const {{class}} *v)
 {% endif %}
 }
 
+{% if interface.tags.config.zoned %}
+/*! \internal
+    Returns the instance responsible for \a zone or \c nullptr if \a zone is not handled by this
+    instance. This is used to dispatch the updates from the backend.
+*/
+{{class}} *{{class}}Private::zoneFeature(const QString &zone)
+{
+    auto q = getParent();
+    // The zone features are created by createZoneFeature() and always have the type of q
+    if (QIviAbstractZonedFeature *f = q->zoneAt(zone))
+        return static_cast<{{class}}*>(f);
+    return q->zone() == zone ? q : nullptr;
+}
+
+{% endif %}
 /*! \internal */
 void {{class}}Private::clearToDefaults()
 {
@@ -144,15 +160,12 @@ void {{class}}Private::clearToDefaults()
 {%   if interface.tags.config.zoned %}
 {{ivi.on_prop_changed(property, class+"Private", interface.tags.config.zoned, true)}}
 {
-    auto q = getParent();
-    auto f = qobject_cast<{{class}}*>(q->zoneAt(zone));
+    auto f = zoneFeature(zone);
     if (!f)
-        f = q;
-    if (f->zone() != zone)
         return;
 {% if not module.tags.config.disablePrivateIVI and not property.type.is_model %}
     if (Q_UNLIKELY(m_propertyOverride)) {
-        const int pi = f->metaObject()->indexOfProperty("{{property}}");
+        const int pi = propertyOffset() + {{property|upperfirst}}Property;
         if (m_propertyOverride->isOverridden(pi)) {
             QVariant v = qVariantFromValue<{{property|return_type}}>({{property}});
             m_propertyOverride->setProperty(pi, v);
@@ -176,10 +189,13 @@ void {{class}}Private::clearToDefaults()
         delete old;
     }
 {% else %}
-    if ({{class}}Private::get(f)->m_{{property}} != {{property}}) {
-        {{class}}Private::get(f)->m_{{property}} = {{property}};
-        emit f->{{property}}Changed({{property}});
+{%   if not module.tags.config.disablePrivateIVI %}
+    if (Q_UNLIKELY(m_updateThrottle)
+            && m_updateThrottle->defer(f, propertyOffset() + {{property|upperfirst}}Property, qVariantFromValue<{{property|return_type}}>({{property}}))) {
+        return;
     }
+{%   endif %}
+    {{class}}Private::get(f)->apply{{property|upperfirst}}({{property}});
 {% endif %}
 }
 {%   else %}
@@ -203,14 +219,31 @@ void {{class}}Private::clearToDefaults()
         delete old;
     }
 {% else %}
+{%   if not module.tags.config.disablePrivateIVI %}
+    if (Q_UNLIKELY(m_updateThrottle)
+            && m_updateThrottle->defer(q_ptr, propertyOffset() + {{property|upperfirst}}Property, qVariantFromValue<{{property|return_type}}>({{property}}))) {
+        return;
+    }
+{%   endif %}
+    apply{{property|upperfirst}}({{property}});
+{% endif %}
+}
+{%   endif %}
+
+{% endfor %}
+{% for property in interface.properties|rejectattr('type.is_model') %}
+/*! \internal
+    Stores the new value of {{property}} and notifies about the change. The updates held back by
+    the update policy are applied through this function as well.
+*/
+void {{class}}Private::apply{{property|upperfirst}}({{property|parameter_type}})
+{
     if (m_{{property}} != {{property}}) {
         auto q = getParent();
         m_{{property}} = {{property}};
         emit q->{{property}}Changed({{property}});
     }
-{% endif %}
 }
-{%   endif %}
 
 {% endfor %}
 {% for signal in interface.signals %}
@@ -218,11 +251,8 @@ void {{class}}Private::clearToDefaults()
 {%   if interface.tags.config.zoned %}
 void {{class}}Private::on{{signal|upperfirst}}({{ivi.join_params(signal, true)}})
 {
-    auto q = getParent();
-    auto f = qobject_cast<{{class}}*>(q->zoneAt(zone));
+    auto f = zoneFeature(zone);
     if (!f)
-        f = q;
-    if (f->zone() != zone)
         return;
     emit f->{{signal}}({{signal.parameters|join(', ')}});
 }
@@ -235,21 +265,92 @@ void {{class}}Private::on{{signal|upperfirst}}({{ivi.join_params(signal)}})
 {%   endif %}
 
 {% endfor %}
+{% set state_properties = interface.properties|rejectattr('type.is_model')|list %}
+/*! \internal */
+{% if interface.tags.config.zoned %}
+void {{class}}Private::onPropertiesChanged(const {{class}}State &properties, const QString &zone)
+{
+    auto f = zoneFeature(zone);
+    if (!f)
+        return;
+{% else %}
+void {{class}}Private::onPropertiesChanged(const {{class}}State &properties)
+{
+    auto f = getParent();
+{% endif %}
+{% if state_properties %}
+{%   if not module.tags.config.disablePrivateIVI %}
+    // Overridden or throttled properties need to be handled one by one
+    if (Q_UNLIKELY(m_propertyOverride || m_updateThrottle)) {
+{%     for property in state_properties %}
+        on{{property|upperfirst}}Changed(properties.{{property}}{% if interface.tags.config.zoned %}, zone{% endif %});
+{%     endfor %}
+        return;
+    }
+{%   endif %}
+    auto d = {{class}}Private::get(f);
+    // Update all values first, the notifications should only see the complete new state
+{%   for property in state_properties %}
+    const bool {{property}}Differs = d->m_{{property}} != properties.{{property}};
+    d->m_{{property}} = properties.{{property}};
+{%   endfor %}
+{%   for property in state_properties %}
+    if ({{property}}Differs)
+        emit f->{{property}}Changed(d->m_{{property}});
+{%   endfor %}
+{% else %}
+    Q_UNUSED(f)
+    Q_UNUSED(properties)
+{% endif %}
+}
 
 {% if not module.tags.config.disablePrivateIVI %}
-bool {{class}}Private::notify(const QByteArray &propertyName, const QVariant &value)
+/*! \internal
+    Returns the index of the first property of {{class}} in its meta object. Together with the
+    Property enum it replaces the lookup of the property indexes by name.
+*/
+int {{class}}Private::propertyOffset()
+{
+    static const int offset = {{class}}::staticMetaObject.propertyOffset();
+    return offset;
+}
+
+/*! \internal */
+bool {{class}}Private::notify(int propertyIndex, const QVariant &value)
 {
     auto q = getParent();
+    switch (propertyIndex - propertyOffset()) {
 {%   for property in interface.properties %}
-    if (propertyName == QByteArray("{{property}}")) {
+    case {{property|upperfirst}}Property:
         emit q->{{property}}Changed(value.value<{{property|return_type}}>());
         return true;
+{%   endfor %}
+    default:
+        break;
     }
+{%   if interface.tags.config.zoned %}
+    return QIviAbstractZonedFeaturePrivate::notify(propertyIndex, value);
+{%   else %}
+    return QIviAbstractFeaturePrivate::notify(propertyIndex, value);
+{%   endif %}
+}
+
+/*! \internal */
+void {{class}}Private::applyUpdate(int propertyIndex, const QVariant &value)
+{
+    switch (propertyIndex - propertyOffset()) {
+{%   for property in interface.properties|rejectattr('type.is_model') %}
+    case {{property|upperfirst}}Property:
+        apply{{property|upperfirst}}(value.value<{{property|return_type}}>());
+        return;
 {%   endfor %}
+    default:
+        break;
+    }
 {%   if interface.tags.config.zoned %}
-    return QIviAbstractZonedFeaturePrivate::notify(propertyName, value);
+    QIviAbstractZonedFeaturePrivate::applyUpdate(propertyIndex, value);
 {%   else %}
-    return QIviAbstractFeaturePrivate::notify(propertyName, value);
+    QIviAbstractFeaturePrivate::applyUpdate(propertyIndex, value);
 {%   endif %}
 }
 {% endif %}
@@ -293,6 +394,29 @@ bool {{class}}Private::notify(const QByteArray &propertyName, const QVariant &va
 {%   endif %}
 {% endif %}
 {
+{% if not module.tags.config.disablePrivateIVI %}
+{%   set config = interface.tags.config %}
+{%   if config.updatePolicy %}
+    setUpdatePolicy(QIviAbstractFeature::{{config.updatePolicy}});
+{%   endif %}
+{%   if config.updateRate is defined %}
+    setUpdateRate({{config.updateRate}});
+{%   endif %}
+{%   if config.updateDeadband is defined %}
+    setUpdateDeadband({{config.updateDeadband}});
+{%   endif %}
+{%   for property in interface.properties|rejectattr('type.is_model') %}
+{%     set config = property.tags.config %}
+{%     if config.updatePolicy %}
+{%       if config.updatePolicy == 'RateLimitedUpdates' %}
+{%         set parameter = config.updateRate %}
+{%       else %}
+{%         set parameter = config.updateDeadband %}
+{%       endif %}
+    setPropertyUpdatePolicy(QStringLiteral("{{property}}"), QIviAbstractFeature::{{config.updatePolicy}}{% if parameter is defined %}, {{parameter}}{% endif %});
+{%     endif %}
+{%   endfor %}
+{% endif %}
 }
 
 /*! \internal */
@@ -335,7 +459,7 @@ void {{class}}::registerQmlTypes(const QString& uri, int majorVersion, int minor
     const auto d = {{class}}Private::get(this);
 {% if not module.tags.config.disablePrivateIVI %}
     if (Q_UNLIKELY(d->m_propertyOverride))
-        return d->m_propertyOverride->property(metaObject()->indexOfProperty("{{property}}")).value<{{property|return_type}}>();
+        return d->m_propertyOverride->property({{class}}Private::propertyOffset() + {{class}}Private::{{property|upperfirst}}Property).value<{{property|return_type}}>();
 {% endif %}
     return d->m_{{property}};
 }
@@ -347,7 +471,7 @@ void {{class}}::registerQmlTypes(const QString& uri, int majorVersion, int minor
     bool forceUpdate = false;
 {% if not module.tags.config.disablePrivateIVI %}
     if (Q_UNLIKELY(d->m_propertyOverride)) {
-        const int pi = metaObject()->indexOfProperty("{{property}}");
+        const int pi = {{class}}Private::propertyOffset() + {{class}}Private::{{property|upperfirst}}Property;
         if (d->m_propertyOverride->isOverridden(pi)) {
             emit {{property}}Changed(d->m_propertyOverride->property(pi).value<{{property|return_type}}>());
             return;
@@ -408,7 +532,13 @@ void {{class}}::connectToServiceObject(QIviServiceObject *serviceObject)
 {
     auto d = {{class}}Private::get(this);
 
-    auto *backend = {{interface|lower}}Backend();
+    // The backend is resolved only once, all setters and operations use the cached pointer
+{% if interface.tags.config.zoned %}
+    d->m_backendInterface = qivi_interface_cast<{{class}}BackendInterface*>(backend());
+{% else %}
+    d->m_backendInterface = serviceObject->interfaceInstance<{{class}}BackendInterface*>(interfaceName());
+{% endif %}
+    auto *backend = d->m_backendInterface;
     if (!backend)
         return;
 
@@ -424,39 +554,58 @@ void {{class}}::connectToServiceObject(QIviServiceObject *serviceObject)
     {{Connect}}(backend, &{{class}}BackendInterface::{{signal}},
         d, &{{class}}Private::on{{signal|upperfirst}});
 {% endfor %}
+{% if module.tags.config.disablePrivateIVI %}{% set Connect = 'QObject::connect' %}
+{% else %}{% set Connect = 'QObjectPrivate::connect' %}{% endif %}
+    {{Connect}}(backend, &{{class}}BackendInterface::propertiesChanged,
+        d, &{{class}}Private::onPropertiesChanged);
 
 {% if interface.tags.config.zoned %}
     QIviAbstractZonedFeature::connectToServiceObject(serviceObject);
+
+    // The zone features are not connected themselves, they use the backend of this instance
+    const auto zoneFeatures = zones();
+    for (QIviAbstractZonedFeature *zoneFeature : zoneFeatures) {
+        if (auto f = qobject_cast<{{class}}*>(zoneFeature))
+            {{class}}Private::get(f)->m_backendInterface = backend;
+    }
 {% else %}
     QIviAbstractFeature::connectToServiceObject(serviceObject);
 {% endif %}
 }
 
 /*! \internal */
-void {{class}}::clearServiceObject()
+void {{class}}::disconnectFromServiceObject(QIviServiceObject *serviceObject)
 {
     auto d = {{class}}Private::get(this);
-    d->clearToDefaults();
+    d->m_backendInterface = nullptr;
 {% if interface.tags.config.zoned %}
-    QIviAbstractZonedFeature::clearServiceObject();
+    const auto zoneFeatures = zones();
+    for (QIviAbstractZonedFeature *zoneFeature : zoneFeatures) {
+        if (auto f = qobject_cast<{{class}}*>(zoneFeature))
+            {{class}}Private::get(f)->m_backendInterface = nullptr;
+    }
+    QIviAbstractZonedFeature::disconnectFromServiceObject(serviceObject);
+{% else %}
+    QIviAbstractFeature::disconnectFromServiceObject(serviceObject);
 {% endif %}
 }
 
-{% if interface.tags.config.zoned %}
 /*! \internal */
-{{class}}BackendInterface *{{class}}::{{interface|lower}}Backend() const
+void {{class}}::clearServiceObject()
 {
-    return qivi_interface_cast<{{class}}BackendInterface*>(backend());
+    auto d = {{class}}Private::get(this);
+    d->m_backendInterface = nullptr;
+    d->clearToDefaults();
+{% if interface.tags.config.zoned %}
+    QIviAbstractZonedFeature::clearServiceObject();
+{% endif %}
 }
-{% else %}
+
 /*! \internal */
 {{class}}BackendInterface *{{class}}::{{interface|lower}}Backend() const
 {
-    if (QIviServiceObject *so = serviceObject())
-        return so->interfaceInstance<{{class}}BackendInterface*>(interfaceName());
-    return nullptr;
+    return {{class}}Private::get(this)->m_backendInterface;
 }
-{% endif %}
 
 QT_END_NAMESPACE
 
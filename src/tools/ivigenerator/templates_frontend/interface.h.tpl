@@ -120,6 +120,7 @@ protected:
     {{class}}BackendInterface *{{interface|lower}}Backend() const;
 
     void connectToServiceObject(QIviServiceObject *service) Q_DECL_OVERRIDE;
+    void disconnectFromServiceObject(QIviServiceObject *service) Q_DECL_OVERRIDE;
     void clearServiceObject() Q_DECL_OVERRIDE;
 
 private:
@@ -72,6 +72,8 @@
 QT_BEGIN_NAMESPACE
 
 class {{class}};
+class {{class}}BackendInterface;
+struct {{class}}State;
 
 {% if module.tags.config.disablePrivateIVI %}
 class {{class}}Private : public QObject
@@ -93,6 +95,9 @@ public:
     static {{class}}Private *get({{class}} *p);
     static const {{class}}Private *get(const {{class}} *p);
     {{class}} *getParent();
+{% if interface.tags.config.zoned %}
+    {{class}} *zoneFeature(const QString &zone);
+{% endif %}
 
     void clearToDefaults();
 
@@ -102,12 +107,26 @@ public:
 {% for signal in interface.signals %}
     void on{{signal|upperfirst}}({{ivi.join_params(signal, zoned = interface.tags.config.zoned)}});
 {% endfor %}
+    void onPropertiesChanged(const {{class}}State &properties{% if interface.tags.config.zoned %}, const QString &zone{% endif %});
+{% for property in interface.properties|rejectattr('type.is_model') %}
+    void apply{{property|upperfirst}}({{property|parameter_type}});
+{% endfor %}
 
 {% if not module.tags.config.disablePrivateIVI %}
-    bool notify(const QByteArray &propertyName, const QVariant &value) override;
+    // The properties in the order of the meta object, relative to propertyOffset()
+    enum Property {
+{%   for property in interface.properties %}
+        {{property|upperfirst}}Property{% if loop.first %} = 0{% endif %},
+{%   endfor %}
+    };
+    static int propertyOffset();
+
+    bool notify(int propertyIndex, const QVariant &value) override;
+    void applyUpdate(int propertyIndex, const QVariant &value) override;
 
     {{class}} * const q_ptr;
 {% endif %}
+    {{class}}BackendInterface *m_backendInterface;
 {% for property in interface.properties %}
     {{property|return_type}} m_{{property}};
 {% endfor %}
@@ -47,6 +47,10 @@
 
 #include <{{interface|lower}}.h>
 #include <{{interface|lower}}backendinterface.h>
+{% if not module.tags.config.disablePrivateIVI %}
+#include <{{interface|lower}}_p.h>
+#include <QtIviCore/private/qividefaultpropertyoverrider_p.h>
+{% endif %}
 
 {% for property in interface.properties %}
 {%   if property.type.is_model %}
@@ -68,6 +72,7 @@ public:
         , m_{{property}}({{property|default_type_value}})
 {%   endif %}
 {% endfor %}
+        , m_initializeCount(0)
     {
 {% if interface.tags.config.zoned %}
         m_zones << "TestZone1" << "TestZone2";
@@ -100,9 +105,33 @@ public:
 {%   endfor %}
         }
 {% endif %}
+        m_initializeCount++;
         emit initializationDone();
     }
 
+    Q_INVOKABLE bool replayState(QIviAbstractFeature *subscriber)
+    {
+        if (!m_initializeCount)
+            return false;
+
+        {{interface}}State properties;
+{% for property in interface.properties if not property.type.is_model %}
+        properties.{{property}} = m_{{property}};
+{% endfor %}
+        replayPropertiesChanged(subscriber, properties{% if interface.tags.config.zoned %}, QString(){% endif %});
+{% if interface.tags.config.zoned %}
+
+        for (const QString &zone : qAsConst(m_zones)) {
+            {{interface}}State zoneProperties;
+{%   for property in interface.properties if not property.type.is_model %}
+            zoneProperties.{{property}} = m_zone{{property|upperfirst}}[zone];
+{%   endfor %}
+            replayPropertiesChanged(subscriber, zoneProperties, zone);
+        }
+{% endif %}
+        return true;
+    }
+
 {% if interface.tags.config.zoned %}
 {%   for property in interface.properties %}
 {%     if not property.type.is_model %}
@@ -180,13 +209,16 @@ private:
 {% endif %}
 
     QStringList m_zones;
+
+public:
+    int m_initializeCount;
 };
 
 class {{interface}}TestServiceObject : public QIviServiceObject {
 
 public:
     explicit {{interface}}TestServiceObject(QObject *parent=nullptr) :
-        QIviServiceObject(parent), m_name(QLatin1String(""))
+        QIviServiceObject(parent), m_name(QLatin1String("")), m_interfaceInstanceCount(0)
     {
         m_backend = new {{interface}}TestBackend;
         m_interfaces << {{module.module_name|upperfirst}}_{{interface}}_iid;
@@ -196,6 +228,7 @@ public:
     QStringList interfaces() const { return m_interfaces; }
     QIviFeatureInterface *interfaceInstance(const QString& interface) const
     {
+        m_interfaceInstanceCount++;
         if (interface == {{module.module_name|upperfirst}}_{{interface}}_iid)
             return testBackend();
         else
@@ -211,6 +244,9 @@ private:
     QString m_name;
     QStringList m_interfaces;
     {{interface}}TestBackend *m_backend;
+
+public:
+    mutable int m_interfaceInstanceCount;
 };
 
 class {{interface}}InvalidInterface : public QIviFeatureInterface
@@ -250,6 +286,8 @@ private:
     : QObject()
 {
     {{module.module_name|upperfirst}}Module::registerTypes();
+    //Don't touch the plugin cache of the user
+    qputenv("QTIVI_DISABLE_PLUGIN_CACHE", "1");
     manager = QIviServiceManager::instance();
 }
 
@@ -406,6 +444,116 @@ void {{interface}}Test::testChangeFromBackend()
 {% endfor %}
 }
 
+void {{interface}}Test::testPropertiesChanged()
+{
+    {{interface}}TestServiceObject *service = new {{interface}}TestServiceObject();
+    manager->registerService(service, service->interfaces());
+
+    {{interface}} cc;
+    cc.startAutoDiscovery();
+
+    {{interface}}State properties;
+{% for property in interface.properties %}
+{%   if not property.type.is_model %}
+    //Test {{property}}
+    QSignalSpy {{property}}Spy(&cc, SIGNAL({{property}}Changed({{property|return_type}})));
+    {{property|parameter_type}}TestValue = {{property|test_type_value}};
+    properties.{{property}} = {{property}}TestValue;
+{%   endif %}
+{% endfor %}
+    emit service->testBackend()->propertiesChanged(properties);
+{% for property in interface.properties %}
+{%   if not property.type.is_model %}
+    QCOMPARE({{property}}Spy.count(), 1);
+    QCOMPARE(cc.{{property|getter_name}}(), {{property}}TestValue);
+{%   endif %}
+{% endfor %}
+
+    //Sending the same state again doesn't notify about any change
+    emit service->testBackend()->propertiesChanged(properties);
+{% for property in interface.properties %}
+{%   if not property.type.is_model %}
+    QCOMPARE({{property}}Spy.count(), 1);
+{%   endif %}
+{% endfor %}
+}
+
+void {{interface}}Test::testStateReplay()
+{
+    {{interface}}TestServiceObject *service = new {{interface}}TestServiceObject();
+    manager->registerService(service, service->interfaces());
+
+{% for property in interface.properties %}
+{%   if not property.type.is_model %}
+    {{property|parameter_type}}TestValue = {{property|test_type_value}};
+{%     if interface_zoned %}
+    service->testBackend()->set{{property|upperfirst}}({{property}}TestValue, QString());
+{%     else %}
+    service->testBackend()->set{{property|upperfirst}}({{property}}TestValue);
+{%     endif %}
+{%   endif %}
+{% endfor %}
+
+    {{interface}} cc;
+    cc.startAutoDiscovery();
+    QVERIFY(cc.isInitialized());
+    QCOMPARE(service->testBackend()->m_initializeCount, 1);
+
+{% for property in interface.properties %}
+{%   if not property.type.is_model %}
+    QSignalSpy {{property}}Spy(&cc, SIGNAL({{property}}Changed({{property|return_type}})));
+{%   endif %}
+{% endfor %}
+
+    //The backend is not initialized again, its state is replayed to the new feature only
+    {{interface}} cc2;
+    cc2.startAutoDiscovery();
+    QVERIFY(!cc2.isInitialized());
+    QTRY_VERIFY(cc2.isInitialized());
+    QCOMPARE(service->testBackend()->m_initializeCount, 1);
+
+{% for property in interface.properties %}
+{%   if not property.type.is_model %}
+    QCOMPARE(cc2.{{property|getter_name}}(), {{property}}TestValue);
+    QCOMPARE({{property}}Spy.count(), 0);
+{%   endif %}
+{% endfor %}
+}
+
+void {{interface}}Test::testCoalescedUpdates()
+{
+{% if module.tags.config.disablePrivateIVI %}
+    QSKIP("The update policies are only supported by features using the private QtIvi classes");
+{% else %}
+    {{interface}}TestServiceObject *service = new {{interface}}TestServiceObject();
+    manager->registerService(service, service->interfaces());
+
+    {{interface}} cc;
+    cc.setUpdatePolicy(QIviAbstractFeature::CoalescedUpdates);
+    cc.startAutoDiscovery();
+    QVERIFY(cc.isInitialized());
+
+{%   for property in interface.properties %}
+{%     if not property.type.is_model %}
+    //Test {{property}}
+    QSignalSpy {{property}}Spy(&cc, SIGNAL({{property}}Changed({{property|return_type}})));
+    {{property|parameter_type}}TestValue = {{property|test_type_value}};
+{%       if interface_zoned %}
+    service->testBackend()->set{{property|upperfirst}}({{property}}TestValue, QString());
+{%       else %}
+    service->testBackend()->set{{property|upperfirst}}({{property}}TestValue);
+{%       endif %}
+    //The update is applied once the event loop runs
+    QCOMPARE({{property}}Spy.count(), 0);
+    QCOMPARE(cc.{{property|getter_name}}(), {{property|default_type_value}});
+    QTRY_COMPARE({{property}}Spy.count(), 1);
+    QCOMPARE(cc.{{property|getter_name}}(), {{property}}TestValue);
+
+{%     endif %}
+{%   endfor %}
+{% endif %}
+}
+
 void {{interface}}Test::testChangeFromFrontend()
 {
     {{interface}}TestServiceObject *service = new {{interface}}TestServiceObject();
@@ -429,6 +577,97 @@ void {{interface}}Test::testChangeFromFrontend()
 {% endfor %}
 }
 
+void {{interface}}Test::testBackendCache()
+{
+    {{interface}}TestServiceObject *service = new {{interface}}TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    {{interface}}TestServiceObject otherService;
+
+    {{interface}} cc;
+    cc.startAutoDiscovery();
+    QVERIFY(cc.isValid());
+
+    //The backend is resolved when connecting, not for every call
+    const int interfaceInstanceCount = service->m_interfaceInstanceCount;
+{% for property in interface.properties %}
+{%   if not property.readonly and not property.const and not property.type.is_model %}
+    cc.{{property|setter_name}}({{property|test_type_value}});
+{%   endif %}
+{% endfor %}
+{% if interface_zoned %}
+    QCOMPARE(cc.zones().count(), cc.availableZones().count());
+    const auto zones = cc.zones();
+    for (QIviAbstractZonedFeature *zone : zones) {
+        auto zoneFeature = qobject_cast<{{interface}}*>(zone);
+        QVERIFY(zoneFeature);
+{%   for property in interface.properties %}
+{%     if not property.readonly and not property.const and not property.type.is_model %}
+        zoneFeature->{{property|setter_name}}({{property|test_type_value}});
+{%     endif %}
+{%   endfor %}
+    }
+{% endif %}
+    QCOMPARE(service->m_interfaceInstanceCount, interfaceInstanceCount);
+
+    //The cached backend is replaced together with the service object
+    cc.setServiceObject(&otherService);
+    QVERIFY(cc.isValid());
+{% for property in interface.properties %}
+{%   if not property.readonly and not property.const and not property.type.is_model %}
+    QCOMPARE(cc.{{property|getter_name}}(), {{property|default_type_value}});
+    {{property|parameter_type}}TestValue = {{property|test_type_value}};
+    cc.{{property|setter_name}}({{property}}TestValue);
+    QCOMPARE(cc.{{property|getter_name}}(), {{property}}TestValue);
+{%   endif %}
+{% endfor %}
+    cc.setServiceObject(nullptr);
+}
+
+void {{interface}}Test::testPropertyIndexes()
+{
+{% if module.tags.config.disablePrivateIVI %}
+    QSKIP("The property indexes are only used by features using the private QtIvi classes");
+{% else %}
+    //The notifications and overrides are dispatched by index, which has to follow the meta object
+    const QMetaObject &mo = {{interface}}::staticMetaObject;
+{%   for property in interface.properties %}
+    QCOMPARE(mo.property(mo.propertyOffset() + {{interface}}Private::{{property|upperfirst}}Property).name(), "{{property}}");
+{%   endfor %}
+    QCOMPARE(mo.propertyCount() - mo.propertyOffset(), {{interface.properties|length}});
+{% endif %}
+}
+
+void {{interface}}Test::testPropertyOverride()
+{
+{% if module.tags.config.disablePrivateIVI %}
+    QSKIP("Overriding properties is only supported by features using the private QtIvi classes");
+{% else %}
+    {{interface}}TestServiceObject *service = new {{interface}}TestServiceObject();
+    manager->registerService(service, service->interfaces());
+
+    {{interface}} cc;
+    cc.startAutoDiscovery();
+
+    QIviDefaultPropertyOverrider overrider(nullptr);
+    overrider.addCarrier(&cc);
+
+{%   for property in interface.properties if not property.type.is_model %}
+    //Test {{property}}
+    const int {{property}}Index = overrider.indexOfProperty("{{property}}");
+    QVERIFY({{property}}Index >= 0);
+    QVERIFY(overrider.setOverride({{property}}Index, true));
+    QSignalSpy {{property}}Spy(&cc, SIGNAL({{property}}Changed({{property|return_type}})));
+    {{property|parameter_type}}OverrideValue = {{property|test_type_value}};
+    overrider.setOverridenValue({{property}}Index, QVariant::fromValue({{property}}OverrideValue));
+    QCOMPARE({{property}}Spy.count(), 1);
+    QCOMPARE({{property}}Spy.at(0).at(0).value<{{property|return_type}}>(), {{property}}OverrideValue);
+    QCOMPARE(cc.{{property|getter_name}}(), {{property}}OverrideValue);
+
+{%   endfor %}
+    overrider.removeCarrier(&cc);
+{% endif %}
+}
+
 void {{interface}}Test::testMethods()
 {
     {{interface}}TestServiceObject *service = new {{interface}}TestServiceObject();
@@ -58,7 +58,13 @@ private slots:
     void testInvalidBackend();
     void testClearServiceObject();
     void testChangeFromBackend();
+    void testPropertiesChanged();
+    void testStateReplay();
+    void testCoalescedUpdates();
     void testChangeFromFrontend();
+    void testBackendCache();
+    void testPropertyIndexes();
+    void testPropertyOverride();
     void testMethods();
     void testSignals();
 {% set once = false %}
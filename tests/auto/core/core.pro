@@ -9,6 +9,8 @@ SUBDIRS = servicemanagertest \
           qivipagingmodel \
           qivisearchandbrowsemodel \
           qivisimulationengine \
+          qiviqmlconversionhelper \
+          qiviqueryevaluator \
 
 QT_FOR_CONFIG += ivicore
 qtConfig(ivigenerator): SUBDIRS += ivigenerator
@@ -0,0 +1,17 @@
+TARGET = tst_org-example-echo-simulator-backend
+QMAKE_PROJECT_NAME = $$TARGET
+DESTDIR = ../
+
+QT += testlib core ivicore qml
+CONFIG += c++11 ivigenerator testcase
+CONFIG -= app_bundle
+
+INCLUDEPATH += $$OUT_PWD/../frontend
+LIBS += -L$$OUT_PWD/.. -l$$qtLibraryTarget(echo_simulator_frontend)
+
+QMAKE_RPATHDIR += $$OUT_PWD/..
+
+SOURCES += tst_echozonedbackend.cpp
+
+QFACE_FORMAT = backend_simulator
+QFACE_SOURCES = ../../../org.example.echo.simulator.qface
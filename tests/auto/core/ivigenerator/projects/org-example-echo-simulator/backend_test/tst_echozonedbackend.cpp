@@ -0,0 +1,98 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 Luxoft Sweden AB
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtIvi module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT-QTAS$
+** Commercial License Usage
+** Licensees holding valid commercial Qt Automotive Suite licenses may use
+** this file in accordance with the commercial license agreement provided
+** with the Software or, alternatively, in accordance with the terms
+** contained in a written agreement between you and The Qt Company.  For
+** licensing terms and conditions see https://www.qt.io/terms-conditions.
+** For further information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest>
+#include <QPointer>
+#include <QQmlPropertyMap>
+
+#include "echozonedbackend.h"
+
+class EchoZonedBackendTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testAddZone();
+    void testReplaceZone();
+};
+
+void EchoZonedBackendTest::testAddZone()
+{
+    EchoZonedBackend backend;
+    QVERIFY(!backend.zoneAt(QStringLiteral("FrontLeft")));
+
+    backend.addZone(QStringLiteral("FrontLeft"));
+    EchoZonedZone *zone = backend.zoneAt(QStringLiteral("FrontLeft"));
+    QVERIFY(zone);
+    QCOMPARE(zone->parent(), static_cast<QObject*>(&backend));
+    QCOMPARE(backend.zones()->value(QStringLiteral("FrontLeft")).value<EchoZonedZone*>(), zone);
+
+    //Changing a zone is forwarded to the backend interface
+    QSignalSpy intValueSpy(&backend, &EchoZonedBackendInterface::intValueChanged);
+    zone->setIntValue(42);
+    QCOMPARE(intValueSpy.count(), 1);
+    QCOMPARE(intValueSpy.at(0).at(0).toInt(), 42);
+    QCOMPARE(intValueSpy.at(0).at(1).toString(), QStringLiteral("FrontLeft"));
+}
+
+void EchoZonedBackendTest::testReplaceZone()
+{
+    EchoZonedBackend backend;
+    backend.addZone(QStringLiteral("FrontLeft"));
+    backend.addZone(QStringLiteral("FrontRight"));
+    QPointer<EchoZonedZone> oldZone = backend.zoneAt(QStringLiteral("FrontLeft"));
+    QPointer<EchoZonedZone> otherZone = backend.zoneAt(QStringLiteral("FrontRight"));
+    QVERIFY(oldZone);
+    QVERIFY(otherZone);
+    oldZone->setIntValue(42);
+    otherZone->setIntValue(23);
+
+    //Adding an existing zone again replaces it with a zone using the default values
+    backend.addZone(QStringLiteral("FrontLeft"));
+    EchoZonedZone *newZone = backend.zoneAt(QStringLiteral("FrontLeft"));
+    QVERIFY(newZone);
+    QVERIFY(newZone != oldZone);
+    QCOMPARE(newZone->intValue(), 0);
+    QCOMPARE(backend.zones()->value(QStringLiteral("FrontLeft")).value<EchoZonedZone*>(), newZone);
+
+    //The old zone object is released, the other zones are untouched
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    QVERIFY(oldZone.isNull());
+    QCOMPARE(backend.zoneAt(QStringLiteral("FrontRight")), otherZone.data());
+    QCOMPARE(otherZone->intValue(), 23);
+
+    //Changes of the new zone are still forwarded with the zone name
+    QSignalSpy intValueSpy(&backend, &EchoZonedBackendInterface::intValueChanged);
+    newZone->setIntValue(5);
+    QCOMPARE(intValueSpy.count(), 1);
+    QCOMPARE(intValueSpy.at(0).at(1).toString(), QStringLiteral("FrontLeft"));
+}
+
+QTEST_MAIN(EchoZonedBackendTest)
+
+#include "tst_echozonedbackend.moc"
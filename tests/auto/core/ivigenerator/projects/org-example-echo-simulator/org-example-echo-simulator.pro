@@ -6,8 +6,10 @@ SUBDIRS = frontend \
           backend_simulator \
           control_panel \
           validator \
-          test
+          test \
+          backend_test
 
 backend_simulator.depends = frontend
 validator.depends = frontend
 test.depends = frontend
+backend_test.depends = frontend
@@ -2,7 +2,7 @@ TARGET = tst_org-example-echo-simulator
 QMAKE_PROJECT_NAME = $$TARGET
 DESTDIR = ../
 
-QT += testlib core ivicore
+QT += testlib core ivicore ivicore-private
 CONFIG += c++11 ivigenerator testcase
 
 INCLUDEPATH += $$OUT_PWD/../frontend
@@ -41,6 +41,7 @@ class QIviFeatureTester : public QObject
 
     Q_PROPERTY(QIviAbstractFeature::DiscoveryMode discoveryMode READ discoveryMode WRITE setDiscoveryMode NOTIFY discoveryModeChanged)
     Q_PROPERTY(QIviAbstractFeature::DiscoveryResult discoveryResult READ discoveryResult NOTIFY discoveryResultChanged)
+    Q_PROPERTY(bool asynchronousDiscovery READ asynchronousDiscovery WRITE setAsynchronousDiscovery NOTIFY asynchronousDiscoveryChanged)
     Q_PROPERTY(QIviServiceObject *serviceObject READ serviceObject WRITE setServiceObject NOTIFY serviceObjectChanged)
     Q_PROPERTY(bool isValid READ isValid NOTIFY isValidChanged)
     Q_PROPERTY(bool isInitialized READ isInitialized NOTIFY isInitializedChanged)
@@ -54,6 +55,7 @@ public:
     {
         connect(m_feature, &QIviAbstractFeature::discoveryModeChanged, this, &QIviFeatureTester::discoveryModeChanged);
         connect(m_feature, &QIviAbstractFeature::discoveryResultChanged, this, &QIviFeatureTester::discoveryResultChanged);
+        connect(m_feature, &QIviAbstractFeature::asynchronousDiscoveryChanged, this, &QIviFeatureTester::asynchronousDiscoveryChanged);
         connect(m_feature, &QIviAbstractFeature::serviceObjectChanged, this, &QIviFeatureTester::serviceObjectChanged);
         connect(m_feature, &QIviAbstractFeature::isValidChanged, this, &QIviFeatureTester::isValidChanged);
         connect(m_feature, &QIviAbstractFeature::isInitializedChanged, this, &QIviFeatureTester::isInitializedChanged);
@@ -67,6 +69,7 @@ public:
     {
         connect(m_featureListModel, &QIviAbstractFeatureListModel::discoveryModeChanged, this, &QIviFeatureTester::discoveryModeChanged);
         connect(m_featureListModel, &QIviAbstractFeatureListModel::discoveryResultChanged, this, &QIviFeatureTester::discoveryResultChanged);
+        connect(m_featureListModel, &QIviAbstractFeatureListModel::asynchronousDiscoveryChanged, this, &QIviFeatureTester::asynchronousDiscoveryChanged);
         connect(m_featureListModel, &QIviAbstractFeatureListModel::serviceObjectChanged, this, &QIviFeatureTester::serviceObjectChanged);
         connect(m_featureListModel, &QIviAbstractFeatureListModel::isValidChanged, this, &QIviFeatureTester::isValidChanged);
         connect(m_featureListModel, &QIviAbstractFeatureListModel::isInitializedChanged, this, &QIviFeatureTester::isInitializedChanged);
@@ -88,6 +91,11 @@ public:
         return m_feature ? m_feature->discoveryResult() : m_featureListModel->discoveryResult();
     }
 
+    bool asynchronousDiscovery() const
+    {
+        return m_feature ? m_feature->asynchronousDiscovery() : m_featureListModel->asynchronousDiscovery();
+    }
+
     bool isValid() const
     {
         return m_feature ? m_feature->isValid() : m_featureListModel->isValid();
@@ -122,6 +130,10 @@ public Q_SLOTS:
     {
         return m_feature ? m_feature->setDiscoveryMode(discoveryMode) : m_featureListModel->setDiscoveryMode(discoveryMode);
     }
+    void setAsynchronousDiscovery(bool asynchronousDiscovery)
+    {
+        return m_feature ? m_feature->setAsynchronousDiscovery(asynchronousDiscovery) : m_featureListModel->setAsynchronousDiscovery(asynchronousDiscovery);
+    }
     QIviAbstractFeature::DiscoveryResult startAutoDiscovery()
     {
         return m_feature ? m_feature->startAutoDiscovery() : m_featureListModel->startAutoDiscovery();
@@ -131,6 +143,7 @@ Q_SIGNALS:
     void serviceObjectChanged();
     void discoveryModeChanged(QIviAbstractFeature::DiscoveryMode discoveryMode);
     void discoveryResultChanged(QIviAbstractFeature::DiscoveryResult discoveryResult);
+    void asynchronousDiscoveryChanged(bool asynchronousDiscovery);
     void isValidChanged(bool arg);
     void isInitializedChanged(bool isInitialized);
     void errorChanged(QIviAbstractFeature::Error error, const QString &message);
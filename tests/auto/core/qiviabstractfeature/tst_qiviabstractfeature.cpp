@@ -165,13 +165,28 @@ class TestFeatureBackend : public TestFeatureInterface
 public:
     TestFeatureBackend(QObject *parent = nullptr)
         : TestFeatureInterface(parent)
+        , m_initializeCount(0)
+        , m_replayCount(0)
     {}
 
     void initialize() override
     {
+        m_initializeCount++;
         emit initializationDone();
     }
 
+    Q_INVOKABLE bool replayState(QIviAbstractFeature *subscriber)
+    {
+        Q_UNUSED(subscriber)
+        if (!m_initializeCount)
+            return false;
+        m_replayCount++;
+        return true;
+    }
+
+    int m_initializeCount;
+    int m_replayCount;
+
     void emitError(QIviAbstractFeature::Error error, const QString &message)
     {
         emit errorChanged(error, message);
@@ -207,6 +222,11 @@ public:
         m_testBackend->emitError(error, message);
     }
 
+    TestFeatureBackend *featureBackend() const
+    {
+        return m_testBackend;
+    }
+
 private:
     TestFeatureBackend* m_testBackend;
 };
@@ -218,9 +238,11 @@ class BaseTest : public QObject
 public:
     BaseTest(bool testModel = false)
         : QObject()
-        , m_manager(QIviServiceManager::instance())
         , m_isModel(testModel)
     {
+        //Don't touch the plugin cache of the user
+        qputenv("QTIVI_DISABLE_PLUGIN_CACHE", "1");
+        m_manager = QIviServiceManager::instance();
     }
 
 private Q_SLOTS:
@@ -232,6 +254,9 @@ private Q_SLOTS:
     void testAutoDiscovery_data();
     void testAutoDiscovery();
     void testAutoDiscovery_qml();
+    void testAsynchronousAutoDiscovery_data();
+    void testAsynchronousAutoDiscovery();
+    void testStateReplay();
     void testProxyServiceObject();
     void testErrors_data();
     void testErrors();
@@ -392,6 +417,60 @@ void BaseTest::testAutoDiscovery()
     QCOMPARE(initializedSpy.at(0).at(0).toBool(), true);
 }
 
+void BaseTest::testAsynchronousAutoDiscovery_data()
+{
+    testAutoDiscovery_data();
+}
+
+void BaseTest::testAsynchronousAutoDiscovery()
+{
+    QFETCH(QIviAbstractFeature::DiscoveryMode, mode);
+    QFETCH(QIviAbstractFeature::DiscoveryResult, result);
+    QFETCH(bool, registerProduction);
+    QFETCH(bool, testBaseFunctions);
+
+    TestBackend* backend = new TestBackend();
+    if (mode == QIviAbstractFeature::LoadOnlySimulationBackends || !registerProduction) {
+        m_manager->registerService(backend, backend->interfaces(), QIviServiceManager::SimulationBackend);
+    } else if (mode == QIviAbstractFeature::LoadOnlyProductionBackends) {
+        m_manager->registerService(backend, backend->interfaces());
+    } else {
+        m_manager->registerService(backend, backend->interfaces());
+        TestBackend* backend2 = new TestBackend();
+        m_manager->registerService(backend2, backend2->interfaces(), QIviServiceManager::SimulationBackend);
+    }
+    QIviFeatureTester *f = createTester(testBaseFunctions);
+    QIviFeatureTester *f2 = createTester(testBaseFunctions);
+    QSignalSpy asyncSpy(f, &QIviFeatureTester::asynchronousDiscoveryChanged);
+    f->setAsynchronousDiscovery(true);
+    f2->setAsynchronousDiscovery(true);
+    QVERIFY(f->asynchronousDiscovery());
+    QCOMPARE(asyncSpy.count(), 1);
+    f->setDiscoveryMode(mode);
+    f2->setDiscoveryMode(mode);
+    QSignalSpy validSpy(f, &QIviFeatureTester::isValidChanged);
+    QSignalSpy resultSpy(f, &QIviFeatureTester::discoveryResultChanged);
+    if (!registerProduction) {
+        QTest::ignoreMessage(QtWarningMsg, "There is no production backend implementing \"testFeature\" .");
+        QTest::ignoreMessage(QtWarningMsg, "There is no production backend implementing \"testFeature\" .");
+    }
+
+    //The discovery is done once the event loop runs, both requests are served together
+    QCOMPARE(f->startAutoDiscovery(), QIviAbstractFeature::NoResult);
+    QCOMPARE(f2->startAutoDiscovery(), QIviAbstractFeature::NoResult);
+    QVERIFY(!f->serviceObject());
+    QVERIFY(!f->isValid());
+
+    QTRY_VERIFY(f->isValid());
+    QTRY_VERIFY(f2->isValid());
+    QVERIFY(f->serviceObject());
+    QCOMPARE(validSpy.count(), 1);
+    QCOMPARE(resultSpy.count(), 1);
+    QCOMPARE(f->discoveryResult(), result);
+    QCOMPARE(f2->discoveryResult(), result);
+    QVERIFY(f->isInitialized());
+}
+
 void BaseTest::testAutoDiscovery_qml()
 {
     TestBackend* backend = new TestBackend();
@@ -437,6 +516,32 @@ void BaseTest::testAutoDiscovery_qml()
     delete autoDiscoveryDisabledItem;
 }
 
+void BaseTest::testStateReplay()
+{
+    TestBackend* backend = new TestBackend();
+    m_manager->registerService(backend, backend->interfaces());
+    TestFeatureBackend *featureBackend = backend->featureBackend();
+
+    QIviFeatureTester *f = createTester();
+    QSignalSpy initializedSpy(f, &QIviFeatureTester::isInitializedChanged);
+    QCOMPARE(f->startAutoDiscovery(), QIviAbstractFeature::ProductionBackendLoaded);
+    QVERIFY(f->isInitialized());
+    QCOMPARE(featureBackend->m_initializeCount, 1);
+    QCOMPARE(featureBackend->m_replayCount, 0);
+
+    // The backend is not initialized again, the state is only sent to the new feature
+    QIviFeatureTester *f2 = createTester();
+    QSignalSpy initializedSpy2(f2, &QIviFeatureTester::isInitializedChanged);
+    QCOMPARE(f2->startAutoDiscovery(), QIviAbstractFeature::ProductionBackendLoaded);
+    // The replayed state is delivered queued, the feature is initialized once it arrived
+    QVERIFY(!f2->isInitialized());
+    QTRY_VERIFY(f2->isInitialized());
+    QCOMPARE(initializedSpy2.count(), 1);
+    QCOMPARE(featureBackend->m_initializeCount, 1);
+    QCOMPARE(featureBackend->m_replayCount, 1);
+    QCOMPARE(initializedSpy.count(), 1);
+}
+
 void BaseTest::testProxyServiceObject()
 {
     TestBackend* backend = new TestBackend();
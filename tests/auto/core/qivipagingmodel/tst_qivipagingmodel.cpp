@@ -55,6 +55,18 @@ public:
         m_caps = capabilities;
     }
 
+    //Sets whether the data should be returned as a QIviStandardItemBatch
+    void setUseBatches(bool useBatches)
+    {
+        m_useBatches = useBatches;
+    }
+
+    //Sets whether fetch requests should be ignored, like a backend which lost the request
+    void setDropRequests(bool dropRequests)
+    {
+        m_dropRequests = dropRequests;
+    }
+
     //Adds very simple Data which can be used for most of the unit tests
     void initializeSimpleData()
     {
@@ -93,23 +105,45 @@ public:
 
     void fetchData(const QUuid &identifier, int start, int count) override
     {
+        emit fetchDataCalled(start);
+        if (m_dropRequests)
+            return;
+
         emit supportedCapabilitiesChanged(identifier, m_caps);
 
         if (m_caps.testFlag(QtIviCoreModule::SupportsGetSize))
             emit countChanged(identifier, m_list.count());
 
-        QVariantList requestedItems;
-
         int size = qMin(start + count, m_list.count());
+        //The index of the following row is enough to continue for this simple backend
+        if (m_caps.testFlag(QtIviCoreModule::SupportsContinuationTokens) && size > start)
+            emit continuationTokenAvailable(identifier, size, QByteArray::number(size));
+
+        if (m_useBatches) {
+            emit batchFetched(identifier, QIviStandardItemBatch::fromList(m_list.mid(start, size - start)), start, start + count < m_list.count());
+            return;
+        }
+
+        QVariantList requestedItems;
         for (int i = start; i < size; i++)
             requestedItems.append(QVariant::fromValue(m_list.at(i)));
 
         emit dataFetched(identifier, requestedItems, start, start + count < m_list.count());
     }
 
+    Q_INVOKABLE void fetchDataAfter(const QUuid &identifier, const QByteArray &continuationToken, int start, int count)
+    {
+        emit fetchDataAfterCalled(continuationToken, start);
+        fetchData(identifier, continuationToken.toInt(), count);
+    }
+
     void insert(int index, const QIviStandardItem item)
     {
         m_list.insert(index, item);
+        if (m_useBatches) {
+            emit batchChanged(QUuid(), QIviStandardItemBatch::fromList(QList<QIviStandardItem>({ item })), index, 0);
+            return;
+        }
         QVariantList variantList = { QVariant::fromValue(item) };
 
         emit dataChanged(QUuid(), variantList, index, 0);
@@ -138,10 +172,14 @@ public:
 Q_SIGNALS:
     void registerInstanceCalled(const QUuid &identifier);
     void unregisterInstanceCalled(const QUuid &identifier);
+    void fetchDataCalled(int start);
+    void fetchDataAfterCalled(const QByteArray &continuationToken, int start);
 
 private:
     QList<QIviStandardItem> m_list;
     QtIviCoreModule::ModelCapabilities m_caps;
+    bool m_useBatches = false;
+    bool m_dropRequests = false;
 };
 
 class TestServiceObject : public QIviServiceObject
@@ -203,7 +241,14 @@ private Q_SLOTS:
     void testDataChangedMode();
     void testReload();
     void testDataChangedMode_jump();
+    void testDataChangedMode_cacheEviction();
+    void testDataChangedMode_cacheEvictionEditing();
+    void testDataChangedMode_prefetch();
+    void testDataChangedMode_prefetchLostRequest();
+    void testDataChangedMode_prefetchConcurrent();
     void testEditing();
+    void testBatches();
+    void testContinuationTokens();
     void testMissingCapabilities();
 
 private:
@@ -211,8 +256,10 @@ private:
 };
 
 tst_QIviPagingModel::tst_QIviPagingModel()
-    : manager(QIviServiceManager::instance())
 {
+    //Don't touch the plugin cache of the user
+    qputenv("QTIVI_DISABLE_PLUGIN_CACHE", "1");
+    manager = QIviServiceManager::instance();
 }
 
 void tst_QIviPagingModel::cleanup()
@@ -261,14 +308,14 @@ void tst_QIviPagingModel::testRegisterInstance()
     QIviPagingModel firstModel;
     firstModel.setServiceObject(service);
     QCOMPARE(registerSpy.count(), 1);
-    auto *firstModelPrivate = reinterpret_cast<QIviPagingModelPrivate*> (QObjectPrivate::get(&firstModel));
+    auto *firstModelPrivate = QIviPagingModelPrivate::get(&firstModel);
     QUuid firstModelIdentifier = firstModelPrivate->m_identifier;
     QCOMPARE(registerSpy.at(0).at(0).toUuid(), firstModelIdentifier);
 
     QIviPagingModel secondModel;
     secondModel.setServiceObject(service);
     QCOMPARE(registerSpy.count(), 2);
-    auto *secondModelPrivate = reinterpret_cast<QIviPagingModelPrivate*> (QObjectPrivate::get(&secondModel));
+    auto *secondModelPrivate = QIviPagingModelPrivate::get(&secondModel);
     QUuid secondModelIdentifier = secondModelPrivate->m_identifier;
     QCOMPARE(registerSpy.at(1).at(0).toUuid(), secondModelIdentifier);
 
@@ -483,6 +530,210 @@ void tst_QIviPagingModel::testDataChangedMode_jump()
     QCOMPARE(fetchDataSpy.at(0).at(2).toInt(), chunkBegin);
 }
 
+void tst_QIviPagingModel::testDataChangedMode_cacheEviction()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    service->testBackend()->setCapabilities(QtIviCoreModule::SupportsGetSize);
+    service->testBackend()->initializeSimpleData();
+
+    QIviPagingModel model;
+    model.setServiceObject(service);
+    QVERIFY(model.serviceObject());
+
+    model.setLoadingType(QIviPagingModel::DataChanged);
+    QCOMPARE(model.loadingType(), QIviPagingModel::DataChanged);
+    QCOMPARE(model.rowCount(), 100);
+
+    QSignalSpy maximumCachedChunksChangedSpy(&model, SIGNAL(maximumCachedChunksChanged(int)));
+    model.setMaximumCachedChunks(2);
+    QCOMPARE(model.maximumCachedChunks(), 2);
+    QCOMPARE(maximumCachedChunksChangedSpy.count(), 1);
+
+    QSignalSpy fetchDataSpy(service->testBackend(), SIGNAL(dataFetched(const QUuid &, const QList<QVariant> &, int , bool )));
+    const int chunkSize = model.chunkSize();
+
+    // Load three chunks, the first one was accessed least recently and needs to be evicted.
+    model.get(0);
+    QCOMPARE(model.at<QIviStandardItem>(0).id(), QLatin1String("simple 0"));
+    model.get(chunkSize);
+    QCOMPARE(model.at<QIviStandardItem>(chunkSize).id(), QLatin1String("simple ") + QString::number(chunkSize));
+    model.get(chunkSize * 2);
+    QCOMPARE(model.at<QIviStandardItem>(chunkSize * 2).id(), QLatin1String("simple ") + QString::number(chunkSize * 2));
+
+    // The second chunk is still in memory and becomes the most recently used one
+    fetchDataSpy.clear();
+    QCOMPARE(model.at<QIviStandardItem>(chunkSize + 1).id(), QLatin1String("simple ") + QString::number(chunkSize + 1));
+    QCOMPARE(fetchDataSpy.count(), 0);
+
+    // Accessing the evicted chunk fetches it from the backend and evicts the third chunk
+    QVERIFY(!model.data(model.index(0), QIviPagingModel::ItemRole).isValid());
+    QCOMPARE(fetchDataSpy.count(), 1);
+    QCOMPARE(fetchDataSpy.at(0).at(2).toInt(), 0);
+    QCOMPARE(model.at<QIviStandardItem>(0).id(), QLatin1String("simple 0"));
+
+    fetchDataSpy.clear();
+    QCOMPARE(model.at<QIviStandardItem>(chunkSize).id(), QLatin1String("simple ") + QString::number(chunkSize));
+    QCOMPARE(fetchDataSpy.count(), 0);
+    QVERIFY(!model.data(model.index(chunkSize * 2), QIviPagingModel::ItemRole).isValid());
+    QCOMPARE(fetchDataSpy.count(), 1);
+    QCOMPARE(fetchDataSpy.at(0).at(2).toInt(), chunkSize * 2);
+}
+
+void tst_QIviPagingModel::testDataChangedMode_cacheEvictionEditing()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    service->testBackend()->setCapabilities(QtIviCoreModule::SupportsGetSize);
+    service->testBackend()->initializeSimpleData();
+
+    QIviPagingModel model;
+    model.setServiceObject(service);
+    model.setLoadingType(QIviPagingModel::DataChanged);
+    QCOMPARE(model.rowCount(), 100);
+    model.setMaximumCachedChunks(2);
+    const int chunkSize = model.chunkSize();
+
+    model.get(0);
+    model.get(chunkSize);
+    QCOMPARE(model.at<QIviStandardItem>(chunkSize).id(), QLatin1String("simple ") + QString::number(chunkSize));
+
+    // Inserting a row moves all following rows, the loaded chunks still need to be used
+    QIviStandardItem newItem;
+    newItem.setId(QLatin1String("testItem"));
+    QSignalSpy fetchDataSpy(service->testBackend(), SIGNAL(dataFetched(const QUuid &, const QList<QVariant> &, int , bool )));
+    service->testBackend()->insert(0, newItem);
+    QCOMPARE(model.rowCount(), 101);
+    QCOMPARE(model.at<QIviStandardItem>(0).id(), newItem.id());
+    QCOMPARE(model.at<QIviStandardItem>(chunkSize).id(), QLatin1String("simple ") + QString::number(chunkSize - 1));
+    QCOMPARE(fetchDataSpy.count(), 0);
+
+    // A newly loaded chunk evicts the chunk which was used least recently, i.e. the first one
+    QVERIFY(!model.data(model.index(chunkSize * 2), QIviPagingModel::ItemRole).isValid());
+    QCOMPARE(fetchDataSpy.count(), 1);
+    QCOMPARE(model.at<QIviStandardItem>(chunkSize * 2).id(), QLatin1String("simple ") + QString::number(chunkSize * 2 - 1));
+    QCOMPARE(model.at<QIviStandardItem>(chunkSize + 1).id(), QLatin1String("simple ") + QString::number(chunkSize));
+    QCOMPARE(fetchDataSpy.count(), 1);
+    QVERIFY(!model.data(model.index(0), QIviPagingModel::ItemRole).isValid());
+    QCOMPARE(fetchDataSpy.count(), 2);
+    QCOMPARE(model.at<QIviStandardItem>(0).id(), newItem.id());
+
+    // After removing the row again, the partially loaded chunks are fetched again
+    service->testBackend()->remove(0);
+    QCOMPARE(model.rowCount(), 100);
+    model.get(0);
+    QCOMPARE(model.at<QIviStandardItem>(0).id(), QLatin1String("simple 0"));
+    model.get(chunkSize * 2);
+    QCOMPARE(model.at<QIviStandardItem>(chunkSize * 2).id(), QLatin1String("simple ") + QString::number(chunkSize * 2));
+}
+
+void tst_QIviPagingModel::testDataChangedMode_prefetch()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    service->testBackend()->setCapabilities(QtIviCoreModule::SupportsGetSize);
+    service->testBackend()->initializeSimpleData();
+
+    QIviPagingModel model;
+    model.setServiceObject(service);
+    QVERIFY(model.serviceObject());
+
+    model.setLoadingType(QIviPagingModel::DataChanged);
+    QCOMPARE(model.loadingType(), QIviPagingModel::DataChanged);
+    QCOMPARE(model.rowCount(), 100);
+
+    QSignalSpy prefetchAheadChangedSpy(&model, SIGNAL(prefetchAheadChanged(int)));
+    model.setPrefetchAhead(2);
+    QCOMPARE(model.prefetchAhead(), 2);
+    QCOMPARE(prefetchAheadChangedSpy.count(), 1);
+
+    // Accessing the first chunk prefetches the next two chunks
+    QSignalSpy fetchDataSpy(service->testBackend(), SIGNAL(dataFetched(const QUuid &, const QList<QVariant> &, int , bool )));
+    model.get(0);
+    QTRY_COMPARE(fetchDataSpy.count(), 2);
+    QCOMPARE(fetchDataSpy.at(0).at(2).toInt(), model.chunkSize());
+    QCOMPARE(fetchDataSpy.at(1).at(2).toInt(), model.chunkSize() * 2);
+
+    // The prefetched data is available without an additional request
+    fetchDataSpy.clear();
+    QCOMPARE(model.at<QIviStandardItem>(model.chunkSize()).id(), QLatin1String("simple ") + QString::number(model.chunkSize()));
+    QCOMPARE(fetchDataSpy.count(), 0);
+
+    // Jumping to the end cancels the queued requests which are out of range
+    model.reload();
+    fetchDataSpy.clear();
+    model.get(0);
+    model.get(99);
+    QCOMPARE(fetchDataSpy.count(), 1);
+    QTest::qWait(50);
+    QCOMPARE(fetchDataSpy.count(), 1);
+    QCOMPARE(fetchDataSpy.at(0).at(2).toInt(), int(99 / model.chunkSize()) * model.chunkSize());
+
+    // The second chunk was never requested and is fetched once it is needed
+    QVERIFY(!model.data(model.index(model.chunkSize()), QIviPagingModel::ItemRole).isValid());
+    QCOMPARE(fetchDataSpy.count(), 2);
+    QCOMPARE(fetchDataSpy.at(1).at(2).toInt(), model.chunkSize());
+}
+
+void tst_QIviPagingModel::testDataChangedMode_prefetchLostRequest()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    service->testBackend()->setCapabilities(QtIviCoreModule::SupportsGetSize);
+    service->testBackend()->initializeSimpleData();
+
+    QIviPagingModel model;
+    model.setServiceObject(service);
+    model.setLoadingType(QIviPagingModel::DataChanged);
+    QCOMPARE(model.rowCount(), 100);
+    model.setPrefetchAhead(1);
+
+    // The backend ignores the prefetch request for the second chunk
+    QSignalSpy fetchDataSpy(service->testBackend(), SIGNAL(dataFetched(const QUuid &, const QList<QVariant> &, int , bool )));
+    service->testBackend()->setDropRequests(true);
+    model.get(0);
+    QTest::qWait(50);
+    QCOMPARE(fetchDataSpy.count(), 0);
+
+    // Once the request timed out, the chunk is requested again
+    service->testBackend()->setDropRequests(false);
+    QTRY_COMPARE(fetchDataSpy.count(), 1);
+    QCOMPARE(fetchDataSpy.at(0).at(2).toInt(), model.chunkSize());
+
+    // Prefetching continues afterwards
+    fetchDataSpy.clear();
+    model.get(model.chunkSize());
+    QTRY_COMPARE(fetchDataSpy.count(), 1);
+    QCOMPARE(fetchDataSpy.at(0).at(2).toInt(), model.chunkSize() * 2);
+}
+
+void tst_QIviPagingModel::testDataChangedMode_prefetchConcurrent()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    service->testBackend()->setCapabilities(QtIviCoreModule::SupportsGetSize);
+    service->testBackend()->initializeSimpleData();
+
+    QIviPagingModel model;
+    model.setServiceObject(service);
+    model.setLoadingType(QIviPagingModel::DataChanged);
+    QCOMPARE(model.rowCount(), 100);
+    model.setPrefetchAhead(2);
+
+    // All chunks of the prefetch window are requested without waiting for an answer
+    QSignalSpy fetchDataCalledSpy(service->testBackend(), SIGNAL(fetchDataCalled(int)));
+    service->testBackend()->setDropRequests(true);
+    model.get(0);
+    QTRY_COMPARE(fetchDataCalledSpy.count(), 3);
+    QCOMPARE(fetchDataCalledSpy.at(0).at(0).toInt(), 0);
+    QCOMPARE(fetchDataCalledSpy.at(1).at(0).toInt(), model.chunkSize());
+    QCOMPARE(fetchDataCalledSpy.at(2).at(0).toInt(), model.chunkSize() * 2);
+
+    // No more than the window is outstanding
+    QTest::qWait(50);
+    QCOMPARE(fetchDataCalledSpy.count(), 3);
+}
+
 void tst_QIviPagingModel::testEditing()
 {
     TestServiceObject *service = new TestServiceObject();
@@ -526,6 +777,74 @@ void tst_QIviPagingModel::testEditing()
     QCOMPARE(model.at<QIviStandardItem>(newIndex).id(), QLatin1String("simple 10"));
 }
 
+void tst_QIviPagingModel::testBatches()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    service->testBackend()->initializeSimpleData();
+    service->testBackend()->setUseBatches(true);
+
+    QIviPagingModel model;
+    QSignalSpy batchFetchedSpy(service->testBackend(), SIGNAL(batchFetched(const QUuid &, const QIviStandardItemBatch &, int , bool )));
+    model.setServiceObject(service);
+
+    QCOMPARE(batchFetchedSpy.count(), 1);
+    QCOMPARE(model.rowCount(), model.chunkSize());
+    QCOMPARE(model.data(model.index(1), QIviPagingModel::NameRole).toString(), QString());
+    QCOMPARE(model.at<QIviStandardItem>(1).id(), QLatin1String("simple 1"));
+
+    // The item is only boxed once, reading it again shares the QVariant
+    const QVariant first = model.data(model.index(2), QIviPagingModel::ItemRole);
+    const QVariant second = model.data(model.index(2), QIviPagingModel::ItemRole);
+    QCOMPARE(first.value<QIviStandardItem>().id(), QLatin1String("simple 2"));
+    QCOMPARE(first.constData(), second.constData());
+    QCOMPARE(model.data(model.index(2), QIviPagingModel::NameRole).toString(), second.value<QIviStandardItem>().name());
+
+    QIviStandardItem newItem;
+    newItem.setId(QLatin1String("testItem"));
+
+    QSignalSpy insertSpy(&model, SIGNAL(rowsInserted(const QModelIndex &, int , int )));
+    service->testBackend()->insert(0, newItem);
+    QCOMPARE(insertSpy.count(), 1);
+    QCOMPARE(model.rowCount(), model.chunkSize() + 1);
+    QCOMPARE(model.at<QIviStandardItem>(0).id(), newItem.id());
+    QCOMPARE(model.at<QIviStandardItem>(1).id(), QLatin1String("simple 0"));
+}
+
+void tst_QIviPagingModel::testContinuationTokens()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    service->testBackend()->setCapabilities(QtIviCoreModule::ModelCapabilities(QtIviCoreModule::SupportsGetSize |
+                                                                               QtIviCoreModule::SupportsContinuationTokens));
+    service->testBackend()->initializeSimpleData();
+
+    QSignalSpy fetchDataAfterSpy(service->testBackend(), SIGNAL(fetchDataAfterCalled(QByteArray, int)));
+
+    QIviPagingModel model;
+    model.setServiceObject(service);
+    QCOMPARE(model.rowCount(), model.chunkSize());
+    // The first chunk doesn't continue anything
+    QVERIFY(!fetchDataAfterSpy.count());
+
+    // Reading sequentially continues with the token of the previous chunk
+    QCOMPARE(model.at<QIviStandardItem>(model.chunkSize() - 1).id(), QLatin1String("simple ") + QString::number(model.chunkSize() - 1));
+    QCOMPARE(model.rowCount(), model.chunkSize() * 2);
+    QCOMPARE(fetchDataAfterSpy.count(), 1);
+    QCOMPARE(fetchDataAfterSpy.at(0).at(0).toByteArray(), QByteArray::number(model.chunkSize()));
+    QCOMPARE(fetchDataAfterSpy.at(0).at(1).toInt(), model.chunkSize());
+    QCOMPARE(model.at<QIviStandardItem>(model.chunkSize()).id(), QLatin1String("simple ") + QString::number(model.chunkSize()));
+
+    // Jumping to a random position uses the index
+    fetchDataAfterSpy.clear();
+    model.setLoadingType(QIviPagingModel::DataChanged);
+    QSignalSpy dataChangedSpy(&model, SIGNAL(dataChanged(const QModelIndex, const QModelIndex, const QVector<int>)));
+    model.get(99);
+    dataChangedSpy.wait();
+    QCOMPARE(model.at<QIviStandardItem>(99).id(), QLatin1String("simple ") + QString::number(99));
+    QVERIFY(!fetchDataAfterSpy.count());
+}
+
 void tst_QIviPagingModel::testMissingCapabilities()
 {
     TestServiceObject *service = new TestServiceObject();
@@ -149,6 +149,10 @@ private Q_SLOTS:
     void testFailed_qml();
     void testEmittingTwice();
     void testInvalidReply();
+    void testLateWatcher();
+    void testContinuation();
+    void testWhenAll();
+    void testWhenAny();
     void testThen_errors();
     void testTypeError();
     void testThenLater();
@@ -432,6 +436,98 @@ void tst_QIviPendingReply::testInvalidReply()
     QVERIFY(!reply.isValid());
 }
 
+void tst_QIviPendingReply::testLateWatcher()
+{
+    QIviPendingReply<int> reply;
+    QIviPendingReply<int> copy = reply;
+    reply.setSuccess(5);
+    QVERIFY(copy.isResultAvailable());
+    QVERIFY(copy.isSuccessful());
+    QCOMPARE(copy.reply(), 5);
+
+    //The watcher is only created when requested, but still knows about the result
+    QIviPendingReplyWatcher *watcher = copy.watcher();
+    QVERIFY(watcher);
+    QCOMPARE(reply.watcher(), watcher);
+    QVERIFY(watcher->isResultAvailable());
+    QVERIFY(watcher->isSuccessful());
+    QCOMPARE(watcher->value(), QVariant(5));
+
+    QIviPendingReply<int> failedReply = QIviPendingReply<int>::createFailedReply();
+    QVERIFY(failedReply.isResultAvailable());
+    QVERIFY(!failedReply.watcher()->isSuccessful());
+    QCOMPARE(failedReply.watcher()->value(), QVariant());
+}
+
+void tst_QIviPendingReply::testContinuation()
+{
+    QIviPendingReply<int> reply;
+    int calls = 0;
+    QIviPendingReply<QString> chained = reply.then([&calls](int value) {
+        ++calls;
+        return QString::number(value * 2);
+    });
+    QIviPendingReply<void> last = chained.then([&calls](const QString &) { ++calls; });
+    QVERIFY(!chained.isResultAvailable());
+
+    reply.setSuccess(21);
+    QCOMPARE(calls, 2);
+    QVERIFY(chained.isSuccessful());
+    QCOMPARE(chained.reply(), QStringLiteral("42"));
+    QVERIFY(last.isSuccessful());
+
+    //The continuation is called inline if the result is already available
+    QIviPendingReply<bool> inlineReply = reply.then([](int value) { return value == 21; });
+    QVERIFY(inlineReply.isSuccessful());
+    QCOMPARE(inlineReply.reply(), true);
+
+    //Failures are propagated without calling the continuation
+    QIviPendingReply<int> failedReply = QIviPendingReply<int>::createFailedReply();
+    QIviPendingReply<int> failedChain = failedReply.then([&calls](int value) { ++calls; return value; });
+    QCOMPARE(calls, 2);
+    QVERIFY(failedChain.isResultAvailable());
+    QVERIFY(!failedChain.isSuccessful());
+}
+
+void tst_QIviPendingReply::testWhenAll()
+{
+    QIviPendingReply<int> first;
+    QIviPendingReply<QString> second;
+    QIviPendingReply<void> all = qIviWhenAll({ first, second });
+    first.setSuccess(1);
+    QVERIFY(!all.isResultAvailable());
+    second.setSuccess(QStringLiteral("2"));
+    QVERIFY(all.isSuccessful());
+
+    QIviPendingReply<int> third;
+    QIviPendingReply<void> failed = qIviWhenAll({ first, third });
+    third.setFailed();
+    QVERIFY(failed.isResultAvailable());
+    QVERIFY(!failed.isSuccessful());
+
+    QVERIFY(qIviWhenAll({}).isSuccessful());
+}
+
+void tst_QIviPendingReply::testWhenAny()
+{
+    QIviPendingReply<int> first;
+    QIviPendingReply<int> second;
+    QIviPendingReply<int> any = qIviWhenAny({ first, second });
+    first.setFailed();
+    QVERIFY(!any.isResultAvailable());
+    second.setSuccess(2);
+    QVERIFY(any.isSuccessful());
+    QCOMPARE(any.reply(), 1);
+
+    QIviPendingReply<int> third;
+    QIviPendingReply<int> failed = qIviWhenAny({ first, third });
+    third.setFailed();
+    QVERIFY(failed.isResultAvailable());
+    QVERIFY(!failed.isSuccessful());
+
+    QVERIFY(!qIviWhenAny({}).isSuccessful());
+}
+
 void tst_QIviPendingReply::testThen_errors()
 {
     QIviPendingReply<QString> reply;
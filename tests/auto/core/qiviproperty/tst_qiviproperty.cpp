@@ -116,6 +116,10 @@ public:
                                                                                    &TestObject::setflagsAttributeValue))
       , m_flagsAttributeValue(TestObject::TestFlags())
     {}
+
+    //Changes the value and the attribute without emitting the change signals
+    void setintAttributeValueSilently(int value) { m_intAttributeValue = value; }
+    void setintAttributeSilently(const QIviPropertyAttribute<int> &attribute) { m_intAttribute = attribute; }
 };
 
 Q_DECLARE_METATYPE(TestObject::TestEnum)
@@ -138,10 +142,13 @@ private Q_SLOTS:
     void attribute();
     void setGetValue();
     void setGetValue_flags();
+    void setValueError_enum();
     void setGetValue_qml();
     void setValueError_qml();
     void readOnly();
     void readOnly_qml();
+    void cachedValue();
+    void uncachedValue();
 
 private:
     void initializeEnumAttribute(TestObject *testObject)
@@ -335,6 +342,25 @@ void tst_QIviProperty::setGetValue_flags()
     QCOMPARE(testObject->flagsAttributeProperty()->value(), newValueVariant);
 }
 
+void tst_QIviProperty::setValueError_enum()
+{
+    TestObject *testObject = new TestObject();
+    testObject->setenumAttributeValue(TestObject::TestValue_1);
+    QSignalSpy valueChangedSpy(testObject, &TestObject::enumAttributeValueChanged);
+
+    //The enum is resolved once, check that it is used for every write
+    for (int i = 0; i < 2; i++) {
+        QTest::ignoreMessage(QtWarningMsg, "Enum value out of range");
+        testObject->enumAttributeProperty()->setValue(QVariant(42));
+        QCOMPARE(valueChangedSpy.count(), 0);
+        QCOMPARE(testObject->enumAttributeValue(), TestObject::TestValue_1);
+    }
+
+    testObject->enumAttributeProperty()->setValue(QVariant(int(TestObject::TestValue_2)));
+    QCOMPARE(valueChangedSpy.count(), 1);
+    QCOMPARE(testObject->enumAttributeValue(), TestObject::TestValue_2);
+}
+
 void tst_QIviProperty::setGetValue_qml()
 {
     TestObject *testObject = new TestObject();
@@ -485,6 +511,55 @@ void tst_QIviProperty::readOnly_qml()
     QCOMPARE(errorList.at(0).toString(), QStringLiteral("<Unknown File>:1: Error: TypeError: Cannot assign to read-only property \"value\""));
 }
 
+void tst_QIviProperty::cachedValue()
+{
+    TestObject *testObject = new TestObject();
+    QIviProperty *property = testObject->intAttributeProperty();
+
+    testObject->setintAttributeValue(1);
+    testObject->setintAttribute(QIviPropertyAttribute<int>(0, 10));
+    QCOMPARE(property->value(), QVariant(1));
+    QCOMPARE(property->maximumValue(), QVariant(10));
+
+    //The property relies on the change signals and keeps the values of the last notification
+    testObject->setintAttributeValueSilently(2);
+    testObject->setintAttributeSilently(QIviPropertyAttribute<int>(0, 20));
+    QCOMPARE(property->value(), QVariant(1));
+    QCOMPARE(property->maximumValue(), QVariant(10));
+
+    //The change signals update the cached values
+    testObject->setintAttributeValue(3);
+    testObject->setintAttribute(QIviPropertyAttribute<int>(0, 30));
+    QCOMPARE(property->value(), QVariant(3));
+    QCOMPARE(property->isAvailable(), true);
+    QCOMPARE(property->minimumValue(), QVariant(0));
+    QCOMPARE(property->maximumValue(), QVariant(30));
+    QCOMPARE(property->availableValues(), QVariantList());
+}
+
+void tst_QIviProperty::uncachedValue()
+{
+    TestObject *testObject = new TestObject();
+
+    //The value signal can't be connected, as it isn't a signal
+    QTest::ignoreMessage(QtWarningMsg, "QObject::connect: signal not found in TestObject");
+    QIviProperty *property = QIviPropertyFactory<int>::create(testObject,
+                                                              &TestObject::intAttribute,
+                                                              &TestObject::intAttributeChanged,
+                                                              &TestObject::intAttributeValue,
+                                                              &TestObject::setintAttributeValue);
+    QCOMPARE(property->value(), QVariant(-1));
+
+    //Without a change signal the getter is used for every read
+    testObject->setintAttributeValueSilently(2);
+    QCOMPARE(property->value(), QVariant(2));
+
+    //The attribute is still updated by its change signal
+    testObject->setintAttribute(QIviPropertyAttribute<int>(0, 10));
+    testObject->setintAttributeSilently(QIviPropertyAttribute<int>(0, 20));
+    QCOMPARE(property->maximumValue(), QVariant(10));
+}
+
 QTEST_MAIN(tst_QIviProperty)
 
 #include "tst_qiviproperty.moc"
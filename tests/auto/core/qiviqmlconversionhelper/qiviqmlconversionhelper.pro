@@ -0,0 +1,12 @@
+QT       += testlib ivicore
+
+TARGET = tst_qiviqmlconversionhelper
+QMAKE_PROJECT_NAME = $$TARGET
+CONFIG   += testcase
+
+TEMPLATE = app
+
+SOURCES += \
+    tst_qiviqmlconversionhelper.cpp
+
+DEFINES += SRCDIR=\\\"$$PWD/\\\"
@@ -0,0 +1,257 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 Luxoft Sweden AB
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtIvi module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT-QTAS$
+** Commercial License Usage
+** Licensees holding valid commercial Qt Automotive Suite licenses may use
+** this file in accordance with the commercial license agreement provided
+** with the Software or, alternatively, in accordance with the terms
+** contained in a written agreement between you and The Qt Company.  For
+** licensing terms and conditions see https://www.qt.io/terms-conditions.
+** For further information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest>
+#include <QIviStandardItem>
+#include <qiviqmlconversion_helper.h>
+
+class TestItem : public QIviStandardItem
+{
+    Q_GADGET
+
+public:
+    QString name() const override { return QStringLiteral("testItem"); }
+};
+Q_DECLARE_METATYPE(TestItem)
+
+class OtherGadget
+{
+    Q_GADGET
+};
+Q_DECLARE_METATYPE(OtherGadget)
+
+class EnumHolder : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum TestEnum {
+        FirstValue,
+        SecondValue
+    };
+    Q_ENUM(TestEnum)
+};
+
+// The implementations before the meta type resolution was cached. Used as a reference for the benchmarks.
+template <class T> const T *uncached_gadgetFromVariant(const QVariant &var)
+{
+    if (!var.isValid())
+        return nullptr;
+
+    QMetaType type(var.userType());
+    if (!type.flags().testFlag(QMetaType::IsGadget))
+        return nullptr;
+
+    const QMetaObject *mo = type.metaObject();
+    while (mo) {
+        if (mo->className() == T::staticMetaObject.className())
+            return reinterpret_cast<const T*>(var.constData());
+        mo = mo->superClass();
+    }
+    return nullptr;
+}
+
+template <typename T> QVariant uncached_convertValue(const T &val)
+{
+    QVariant var;
+    int userType = qMetaTypeId<T>();
+    QMetaType metaType(userType);
+    const QMetaObject *mo = metaType.metaObject();
+    QString enumName = QString::fromLocal8Bit(QMetaType::typeName(userType)).split(QStringLiteral("::")).last();
+    if (mo) {
+        QMetaEnum mEnum = mo->enumerator(mo->indexOfEnumerator(enumName.toLocal8Bit().constData()));
+        if (mEnum.isValid())
+            var = QVariant::fromValue<T>(val).toInt();
+    }
+
+    if (!var.isValid())
+        var = QVariant::fromValue<T>(val);
+
+    return var;
+}
+
+class tst_QIviQmlConversionHelper : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void gadgetFromVariant();
+    void convertValue();
+    void metaEnumForType();
+    void convertToType_data();
+    void convertToType();
+
+    void benchmarkGadgetFromVariant_data();
+    void benchmarkGadgetFromVariant();
+    void benchmarkConvertValue_data();
+    void benchmarkConvertValue();
+};
+
+void tst_QIviQmlConversionHelper::gadgetFromVariant()
+{
+    QVariant itemVariant = QVariant::fromValue(TestItem());
+
+    // Call it twice to also test the cached path
+    for (int i = 0; i < 2; i++) {
+        const QIviStandardItem *item = qtivi_gadgetFromVariant<QIviStandardItem>(this, itemVariant);
+        QVERIFY(item);
+        QCOMPARE(item->name(), QStringLiteral("testItem"));
+        QVERIFY(qtivi_gadgetFromVariant<TestItem>(this, itemVariant));
+    }
+
+    QVERIFY(qtivi_gadgetFromVariant<QIviStandardItem>(this, QVariant::fromValue(QIviStandardItem())));
+
+    QTest::ignoreMessage(QtWarningMsg, "The passed QVariant is not derived from QIviStandardItem");
+    QVERIFY(!qtivi_gadgetFromVariant<QIviStandardItem>(this, QVariant::fromValue(OtherGadget())));
+
+    QTest::ignoreMessage(QtWarningMsg, "The passed QVariant needs to use the Q_GADGET macro");
+    QVERIFY(!qtivi_gadgetFromVariant<QIviStandardItem>(this, QVariant(5)));
+
+    QTest::ignoreMessage(QtWarningMsg, "The passed QVariant is undefined");
+    QVERIFY(!qtivi_gadgetFromVariant<QIviStandardItem>(this, QVariant()));
+}
+
+void tst_QIviQmlConversionHelper::convertValue()
+{
+    QVariant var = qtivi_convertValue(EnumHolder::SecondValue);
+    QCOMPARE(var.type(), QVariant::Int);
+    QCOMPARE(var.toInt(), int(EnumHolder::SecondValue));
+
+    var = qtivi_convertValue(QStringLiteral("test"));
+    QCOMPARE(var.type(), QVariant::String);
+    QCOMPARE(var.toString(), QStringLiteral("test"));
+}
+
+void tst_QIviQmlConversionHelper::metaEnumForType()
+{
+    QMetaEnum mEnum = qtivi_metaEnumForType(qMetaTypeId<EnumHolder::TestEnum>());
+    QVERIFY(mEnum.isValid());
+    QCOMPARE(mEnum.name(), "TestEnum");
+
+    // The second call is answered from the cache
+    QCOMPARE(qtivi_metaEnumForType(qMetaTypeId<EnumHolder::TestEnum>()).name(), "TestEnum");
+
+    QVERIFY(!qtivi_metaEnumForType(qMetaTypeId<int>()).isValid());
+    QVERIFY(!qtivi_metaEnumForType(qMetaTypeId<TestItem>()).isValid());
+}
+
+void tst_QIviQmlConversionHelper::convertToType_data()
+{
+    QTest::addColumn<QVariant>("value");
+    QTest::addColumn<int>("userType");
+    QTest::addColumn<bool>("success");
+    QTest::addColumn<int>("result");
+    QTest::addColumn<QString>("error");
+
+    const int intType = qMetaTypeId<int>();
+    const int enumType = qMetaTypeId<EnumHolder::TestEnum>();
+    QTest::newRow("sameType") << QVariant(5) << intType << true << 5 << QString();
+    QTest::newRow("converted") << QVariant(5.0) << intType << true << 5 << QString();
+    QTest::newRow("notConvertible") << QVariant(QStringLiteral("test")) << intType << false << 0
+                                    << QStringLiteral("Expected: int but got QString");
+    QTest::newRow("enum") << QVariant::fromValue(EnumHolder::SecondValue) << enumType << true << int(EnumHolder::SecondValue) << QString();
+    QTest::newRow("enumFromInt") << QVariant(int(EnumHolder::SecondValue)) << enumType << true << int(EnumHolder::SecondValue) << QString();
+    QTest::newRow("enumOutOfRange") << QVariant(42) << enumType << false << 0
+                                    << QStringLiteral("Enum value out of range");
+}
+
+void tst_QIviQmlConversionHelper::convertToType()
+{
+    QFETCH(QVariant, value);
+    QFETCH(int, userType);
+    QFETCH(bool, success);
+    QFETCH(int, result);
+    QFETCH(QString, error);
+
+    // The enum is resolved once and used for all conversions, like QIviProperty does
+    const QMetaEnum metaEnum = qtivi_metaEnumForType(userType);
+    QCOMPARE(metaEnum.isValid(), userType != qMetaTypeId<int>());
+
+    for (int i = 0; i < 2; i++) {
+        QString errorString;
+        QCOMPARE(qtivi_convertToType(value, userType, metaEnum, &errorString), success);
+        QCOMPARE(errorString, error);
+        if (!success)
+            break;
+        // The second run converts the already converted value
+        QCOMPARE(value.toInt(), result);
+    }
+}
+
+void tst_QIviQmlConversionHelper::benchmarkGadgetFromVariant_data()
+{
+    QTest::addColumn<bool>("cached");
+    QTest::newRow("uncached") << false;
+    QTest::newRow("cached") << true;
+}
+
+void tst_QIviQmlConversionHelper::benchmarkGadgetFromVariant()
+{
+    QFETCH(bool, cached);
+    QVariant itemVariant = QVariant::fromValue(TestItem());
+    const QIviStandardItem *item = nullptr;
+
+    if (cached) {
+        QBENCHMARK {
+            item = qtivi_gadgetFromVariant<QIviStandardItem>(this, itemVariant);
+        }
+    } else {
+        QBENCHMARK {
+            item = uncached_gadgetFromVariant<QIviStandardItem>(itemVariant);
+        }
+    }
+    QVERIFY(item);
+}
+
+void tst_QIviQmlConversionHelper::benchmarkConvertValue_data()
+{
+    QTest::addColumn<bool>("cached");
+    QTest::newRow("uncached") << false;
+    QTest::newRow("cached") << true;
+}
+
+void tst_QIviQmlConversionHelper::benchmarkConvertValue()
+{
+    QFETCH(bool, cached);
+    QVariant var;
+
+    if (cached) {
+        QBENCHMARK {
+            var = qtivi_convertValue(EnumHolder::SecondValue);
+        }
+    } else {
+        QBENCHMARK {
+            var = uncached_convertValue(EnumHolder::SecondValue);
+        }
+    }
+    QCOMPARE(var.toInt(), int(EnumHolder::SecondValue));
+}
+
+QTEST_APPLESS_MAIN(tst_QIviQmlConversionHelper)
+
+#include "tst_qiviqmlconversionhelper.moc"
@@ -0,0 +1,12 @@
+QT       += testlib ivicore ivicore-private
+
+TARGET = tst_qiviqueryevaluator
+QMAKE_PROJECT_NAME = $$TARGET
+CONFIG   += testcase
+
+TEMPLATE = app
+
+SOURCES += \
+    tst_qiviqueryevaluator.cpp
+
+DEFINES += SRCDIR=\\\"$$PWD/\\\"
@@ -0,0 +1,201 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 Luxoft Sweden AB
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtIvi module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT-QTAS$
+** Commercial License Usage
+** Licensees holding valid commercial Qt Automotive Suite licenses may use
+** this file in accordance with the commercial license agreement provided
+** with the Software or, alternatively, in accordance with the terms
+** contained in a written agreement between you and The Qt Company.  For
+** licensing terms and conditions see https://www.qt.io/terms-conditions.
+** For further information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest>
+#include <QIviQueryEvaluator>
+#include <private/qiviqueryparser_p.h>
+
+class TestItem
+{
+    Q_GADGET
+    Q_PROPERTY(QString name MEMBER m_name)
+    Q_PROPERTY(int number MEMBER m_number)
+
+public:
+    QString m_name;
+    int m_number = 0;
+};
+Q_DECLARE_METATYPE(TestItem)
+
+class tst_QIviQueryEvaluator : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void filter_data();
+    void filter();
+    void sort_data();
+    void sort();
+    void invalidQuery();
+    void unrelatedItems();
+    void parallel();
+
+private:
+    QIviQuery parse(const QString &query);
+    QVariantList items() const;
+    QStringList names(const QVariantList &items) const;
+};
+
+QIviQuery tst_QIviQueryEvaluator::parse(const QString &query)
+{
+    QIviQueryParser parser;
+    parser.setQuery(query);
+    QIviAbstractQueryTerm *term = parser.parse();
+    if (!term && !query.isEmpty())
+        qWarning("%s", qPrintable(parser.lastError()));
+    return QIviQuery(term, parser.orderTerms());
+}
+
+QVariantList tst_QIviQueryEvaluator::items() const
+{
+    const QStringList names = { QStringLiteral("Bravo"), QStringLiteral("alpha"), QStringLiteral("Charlie"),
+                                QStringLiteral("Alpha"), QStringLiteral("Delta") };
+    const QList<int> numbers = { 2, 5, 3, 1, 2 };
+    QVariantList list;
+    for (int i = 0; i < names.count(); ++i) {
+        TestItem item;
+        item.m_name = names.at(i);
+        item.m_number = numbers.at(i);
+        list.append(QVariant::fromValue(item));
+    }
+    return list;
+}
+
+QStringList tst_QIviQueryEvaluator::names(const QVariantList &items) const
+{
+    QStringList list;
+    for (const QVariant &item : items)
+        list.append(item.value<TestItem>().m_name);
+    return list;
+}
+
+void tst_QIviQueryEvaluator::filter_data()
+{
+    QTest::addColumn<QString>("query");
+    QTest::addColumn<QStringList>("expected");
+
+    QTest::newRow("equals") << "name='Alpha'" << QStringList({ "Alpha" });
+    QTest::newRow("equals case insensitive") << "name~='alpha'" << QStringList({ "alpha", "Alpha" });
+    QTest::newRow("unequals") << "name!='Alpha'" << QStringList({ "Bravo", "alpha", "Charlie", "Delta" });
+    QTest::newRow("wildcard") << "name='*a*'" << QStringList({ "Bravo", "alpha", "Charlie", "Alpha", "Delta" });
+    QTest::newRow("wildcard prefix") << "name~='al*'" << QStringList({ "alpha", "Alpha" });
+    QTest::newRow("greater") << "number>2" << QStringList({ "alpha", "Charlie" });
+    QTest::newRow("lower equals") << "number<=2" << QStringList({ "Bravo", "Alpha", "Delta" });
+    QTest::newRow("and") << "number=2 & name='Delta'" << QStringList({ "Delta" });
+    QTest::newRow("or") << "number=1 | number=5" << QStringList({ "alpha", "Alpha" });
+    QTest::newRow("negated scope") << "!(number>=2)" << QStringList({ "Alpha" });
+    QTest::newRow("nested") << "(number=2 | number=3) & !(name='Bravo')" << QStringList({ "Charlie", "Delta" });
+}
+
+void tst_QIviQueryEvaluator::filter()
+{
+    QFETCH(QString, query);
+    QFETCH(QStringList, expected);
+
+    QIviQueryEvaluator evaluator(parse(query), &TestItem::staticMetaObject);
+    QVERIFY2(evaluator.isValid(), qPrintable(evaluator.errorString()));
+    QVERIFY(evaluator.hasFilter());
+    QCOMPARE(names(evaluator.apply(items())), expected);
+}
+
+void tst_QIviQueryEvaluator::sort_data()
+{
+    QTest::addColumn<QString>("query");
+    QTest::addColumn<QStringList>("expected");
+
+    QTest::newRow("ascending") << "number>0 [/number]" << QStringList({ "Alpha", "Bravo", "Delta", "Charlie", "alpha" });
+    QTest::newRow("descending") << "number>0 [\\number]" << QStringList({ "alpha", "Charlie", "Bravo", "Delta", "Alpha" });
+    QTest::newRow("two keys") << "number>0 [/number\\name]" << QStringList({ "Alpha", "Delta", "Bravo", "Charlie", "alpha" });
+    QTest::newRow("filter and sort") << "number>=2 [/name]" << QStringList({ "Bravo", "Charlie", "Delta", "alpha" });
+}
+
+void tst_QIviQueryEvaluator::sort()
+{
+    QFETCH(QString, query);
+    QFETCH(QStringList, expected);
+
+    QIviQueryEvaluator evaluator(parse(query), &TestItem::staticMetaObject);
+    QVERIFY2(evaluator.isValid(), qPrintable(evaluator.errorString()));
+    QVERIFY(evaluator.hasOrder());
+    QCOMPARE(names(evaluator.apply(items())), expected);
+
+    const QVariantList list = items();
+    QCOMPARE(evaluator.lessThan(list.at(3), list.at(0)), expected.indexOf("Alpha") < expected.indexOf("Bravo"));
+}
+
+void tst_QIviQueryEvaluator::invalidQuery()
+{
+    QIviQueryEvaluator evaluator(parse(QStringLiteral("unknown=5")), &TestItem::staticMetaObject);
+    QVERIFY(!evaluator.isValid());
+    QVERIFY(!evaluator.errorString().isEmpty());
+    QVERIFY(evaluator.evaluate(items()).isEmpty());
+
+    QIviQueryEvaluator empty;
+    QVERIFY(!empty.isValid());
+
+    QIviQueryEvaluator all(QIviQuery(), &TestItem::staticMetaObject);
+    QVERIFY(all.isValid());
+    QVERIFY(!all.hasFilter());
+    QCOMPARE(all.evaluate(items()), QVector<int>({ 0, 1, 2, 3, 4 }));
+}
+
+void tst_QIviQueryEvaluator::unrelatedItems()
+{
+    QIviQueryEvaluator evaluator(QIviQuery(), &TestItem::staticMetaObject);
+    QVariantList list = items();
+    list.insert(1, QStringLiteral("no gadget"));
+    list.append(42);
+    QCOMPARE(evaluator.evaluate(list), QVector<int>({ 0, 2, 3, 4, 5 }));
+    QVERIFY(!evaluator.matches(QVariant(42)));
+}
+
+void tst_QIviQueryEvaluator::parallel()
+{
+    QVariantList list;
+    for (int i = 0; i < 20000; ++i) {
+        TestItem item;
+        item.m_name = QString::number(i);
+        item.m_number = (i * 7919) % 1000;
+        list.append(QVariant::fromValue(item));
+    }
+
+    QIviQueryEvaluator serial(parse(QStringLiteral("number>100 & number<900 [\\number/name]")), &TestItem::staticMetaObject);
+    serial.setParallelThreshold(0);
+    QIviQueryEvaluator parallel = serial;
+    parallel.setParallelThreshold(100);
+    QCOMPARE(serial.parallelThreshold(), 0);
+
+    const QVector<int> expected = serial.evaluate(list);
+    QVERIFY(!expected.isEmpty());
+    QCOMPARE(parallel.evaluate(list), expected);
+}
+
+QTEST_MAIN(tst_QIviQueryEvaluator)
+
+#include "tst_qiviqueryevaluator.moc"
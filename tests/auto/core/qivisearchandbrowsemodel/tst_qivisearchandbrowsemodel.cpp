@@ -92,6 +92,12 @@ public:
         m_lists.insert(type, list);
     }
 
+    //Changes the data without notifying the models
+    void removeItemSilently(const QString &type, int index)
+    {
+        m_lists[type].removeAt(index);
+    }
+
     QList<QIviStandardItem> createItemList(const QString &name)
     {
         QList<QIviStandardItem> list;
@@ -174,6 +180,12 @@ public:
                 if (value.canConvert(filterTerm->value().userType()))
                     value.convert(filterTerm->value().userType());
 
+                //Support the '*' wildcard for strings, to be able to test the incremental search
+                const QString pattern = filterTerm->value().toString();
+                const bool isWildcard = filterTerm->value().type() == QVariant::String && pattern.contains('*');
+                if (isWildcard && filterTerm->operatorType() == QIviFilterTerm::Equals)
+                    value = QRegExp(pattern, Qt::CaseSensitive, QRegExp::Wildcard).exactMatch(value.toString()) ? filterTerm->value() : QVariant();
+
                 bool filterCondition = (filterTerm->operatorType() == QIviFilterTerm::Equals && value == filterTerm->value()) ||
                                        (filterTerm->operatorType() == QIviFilterTerm::GreaterThan && value > filterTerm->value()) ||
                                        (filterTerm->operatorType() == QIviFilterTerm::GreaterEquals && value >= filterTerm->value()) ||
@@ -404,6 +416,9 @@ private Q_SLOTS:
     void testNavigation();
     void testFilter_data();
     void testFilter();
+    void testLocalQueryFallback();
+    void testIncrementalQuery();
+    void testIncrementalQuery_verifyAllRows();
     void testEditing();
     void testIndexOf_qml();
     void testInputErrors();
@@ -413,9 +428,11 @@ private:
     QIviServiceManager *manager;
 };
 
-tst_QIviSearchAndBrowseModel::tst_QIviSearchAndBrowseModel()\
-    : manager(QIviServiceManager::instance())
+tst_QIviSearchAndBrowseModel::tst_QIviSearchAndBrowseModel()
 {
+    //Don't touch the plugin cache of the user
+    qputenv("QTIVI_DISABLE_PLUGIN_CACHE", "1");
+    manager = QIviServiceManager::instance();
 }
 
 void tst_QIviSearchAndBrowseModel::cleanup()
@@ -850,6 +867,167 @@ void tst_QIviSearchAndBrowseModel::testFilter()
     QCOMPARE(model.at<QIviStandardItem>(0).id(), QString::number(0));
 }
 
+void tst_QIviSearchAndBrowseModel::testLocalQueryFallback()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    service->testBackend()->setCapabilities(QtIviCoreModule::ModelCapabilities(QtIviCoreModule::SupportsInsert |
+                                                                               QtIviCoreModule::SupportsRemove));
+    service->testBackend()->initializeFilterData();
+
+    QIviSearchAndBrowseModel model;
+    model.setServiceObject(service);
+    model.setContentType("filter");
+    QCOMPARE(model.at<QIviStandardItem>(0).id(), QString::number(0));
+
+    QSignalSpy fallbackChangedSpy(&model, SIGNAL(localQueryFallbackChanged(bool)));
+    model.setLocalQueryFallback(true);
+    QVERIFY(model.localQueryFallback());
+    QCOMPARE(fallbackChangedSpy.count(), 1);
+
+    // The backend can neither filter nor sort, the model applies the query on all rows
+    model.setQuery(QString("id='1*'[\\id]"));
+    QTRY_COMPARE(model.rowCount(), 11);
+    QCOMPARE(model.at<QIviStandardItem>(0).id(), QString("19"));
+    QCOMPARE(model.at<QIviStandardItem>(10).id(), QString("1"));
+    QVERIFY(!model.canFetchMore(QModelIndex()));
+
+    // The index reported by the backend is mapped to the row of the model
+    QIviPendingReply<int> reply = model.indexOf(QVariant::fromValue(model.at<QIviStandardItem>(1)));
+    QVERIFY(reply.isResultAvailable());
+    QCOMPARE(reply.reply(), 1);
+
+    // Removing a row removes the matching row in the backend and applies the query again
+    QSignalSpy resetSpy(&model, SIGNAL(modelReset()));
+    QSignalSpy removedSpy(&model, SIGNAL(rowsRemoved(const QModelIndex &, int , int )));
+    QSignalSpy insertedSpy(&model, SIGNAL(rowsInserted(const QModelIndex &, int , int )));
+    model.remove(0);
+    QTRY_COMPARE(model.rowCount(), 10);
+    QCOMPARE(removedSpy.count(), 1);
+    QCOMPARE(model.at<QIviStandardItem>(0).id(), QString("18"));
+
+    // A new row is inserted at the position given by the query, without resetting the model
+    QIviStandardItem newItem;
+    newItem.setId(QLatin1String("1a"));
+    model.insert(5, QVariant::fromValue(newItem));
+    QTRY_COMPARE(insertedSpy.count(), 1);
+    QCOMPARE(insertedSpy.at(0).at(1).toInt(), 0);
+    QCOMPARE(insertedSpy.at(0).at(2).toInt(), 0);
+    QCOMPARE(model.rowCount(), 11);
+    QCOMPARE(model.at<QIviStandardItem>(0).id(), QString("1a"));
+    QCOMPARE(model.at<QIviStandardItem>(1).id(), QString("18"));
+    QCOMPARE(resetSpy.count(), 0);
+
+    // Without a query the rows are fetched from the backend again
+    model.setQuery(QString());
+    QCOMPARE(model.at<QIviStandardItem>(0).id(), QString::number(0));
+    QVERIFY(model.canFetchMore(QModelIndex()));
+}
+
+void tst_QIviSearchAndBrowseModel::testIncrementalQuery()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    service->testBackend()->setCapabilities(QtIviCoreModule::ModelCapabilities( QtIviCoreModule::SupportsFiltering |
+                                                                                QtIviCoreModule::SupportsSorting));
+    service->testBackend()->initializeFilterData();
+
+    QIviSearchAndBrowseModel model;
+    model.setServiceObject(service);
+    model.setContentType("filter");
+    QCOMPARE(model.rowCount(), 30);
+
+    QSignalSpy incrementalChangedSpy(&model, SIGNAL(incrementalQueryChanged(bool)));
+    model.setIncrementalQuery(true);
+    QVERIFY(model.incrementalQuery());
+    QCOMPARE(incrementalChangedSpy.count(), 1);
+
+    QSignalSpy resetSpy(&model, SIGNAL(modelReset()));
+    QSignalSpy removedSpy(&model, SIGNAL(rowsRemoved(const QModelIndex &, int , int )));
+
+    // Every filter narrows the unfiltered content, the loaded rows are filtered locally
+    model.setQuery(QString("id='1*'"));
+    QCOMPARE(resetSpy.count(), 0);
+    QVERIFY(removedSpy.count());
+    QCOMPARE(model.rowCount(), 11);
+    QCOMPARE(model.at<QIviStandardItem>(0).id(), QString("1"));
+    QCOMPARE(model.at<QIviStandardItem>(10).id(), QString("19"));
+    // The backend confirmed that there are no more rows
+    QVERIFY(!model.canFetchMore(QModelIndex()));
+
+    removedSpy.clear();
+    model.setQuery(QString("id='12*'"));
+    QCOMPARE(resetSpy.count(), 0);
+    QVERIFY(removedSpy.count());
+    QCOMPARE(model.rowCount(), 1);
+    QCOMPARE(model.at<QIviStandardItem>(0).id(), QString("12"));
+
+    // A query which doesn't narrow the previous one resets the model
+    model.setQuery(QString("id='2*'"));
+    QCOMPARE(resetSpy.count(), 1);
+    QCOMPARE(model.rowCount(), 11);
+    QCOMPARE(model.at<QIviStandardItem>(0).id(), QString("2"));
+
+    // The same works if the query is applied locally
+    service->testBackend()->setCapabilities(QtIviCoreModule::NoExtras);
+    model.setQuery(QString());
+    model.setLocalQueryFallback(true);
+    model.setQuery(QString("id='1*'"));
+    QTRY_COMPARE(model.rowCount(), 11);
+
+    resetSpy.clear();
+    removedSpy.clear();
+    model.setQuery(QString("id='12'"));
+    QCOMPARE(resetSpy.count(), 0);
+    QCOMPARE(removedSpy.count(), 2);
+    QCOMPARE(model.rowCount(), 1);
+    QCOMPARE(model.at<QIviStandardItem>(0).id(), QString("12"));
+}
+
+void tst_QIviSearchAndBrowseModel::testIncrementalQuery_verifyAllRows()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    service->testBackend()->setCapabilities(QtIviCoreModule::ModelCapabilities( QtIviCoreModule::SupportsFiltering |
+                                                                                QtIviCoreModule::SupportsSorting));
+    service->testBackend()->initializeFilterData();
+
+    QIviSearchAndBrowseModel model;
+    model.setChunkSize(5);
+    model.setIncrementalQuery(true);
+    model.setServiceObject(service);
+    model.setContentType("filter");
+    while (model.rowCount() < 30 && model.canFetchMore(QModelIndex()))
+        model.fetchMore(QModelIndex());
+    QCOMPARE(model.rowCount(), 30);
+
+    // The backend agrees with all locally filtered rows, even though they are more than a chunk
+    QSignalSpy resetSpy(&model, SIGNAL(modelReset()));
+    model.setQuery(QString("id='1*'"));
+    QCOMPARE(resetSpy.count(), 0);
+    QCOMPARE(model.rowCount(), 11);
+    QCOMPARE(model.at<QIviStandardItem>(10).id(), QString("19"));
+    QVERIFY(!model.canFetchMore(QModelIndex()));
+
+    model.setQuery(QString());
+    while (model.rowCount() < 30 && model.canFetchMore(QModelIndex()))
+        model.fetchMore(QModelIndex());
+    QCOMPARE(model.rowCount(), 30);
+
+    // The backend doesn't know about the row "17" anymore, which is behind the first chunk of the
+    // refined query. All locally filtered rows are verified, so the model is reset.
+    service->testBackend()->removeItemSilently("filter", 17);
+    resetSpy.clear();
+    model.setQuery(QString("id='1*'"));
+    QCOMPARE(resetSpy.count(), 1);
+
+    while (model.canFetchMore(QModelIndex()))
+        model.fetchMore(QModelIndex());
+    QCOMPARE(model.rowCount(), 10);
+    for (int i = 0; i < model.rowCount(); i++)
+        QVERIFY(model.at<QIviStandardItem>(i).id() != QString("17"));
+}
+
 void tst_QIviSearchAndBrowseModel::testEditing()
 {
     TestServiceObject *service = new TestServiceObject();
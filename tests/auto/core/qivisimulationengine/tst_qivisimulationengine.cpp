@@ -258,6 +258,8 @@ private Q_SLOTS:
     void testFunctionCalls();
     void testFunctionOverride_data();
     void testFunctionOverride();
+    void testPartialFunctionOverride();
+    void testFunctionOverrideArgumentMismatch();
     void testCallingBaseFunction_data();
     void testCallingBaseFunction();
     void testRecursionPrevention();
@@ -714,6 +716,80 @@ void tst_QIviSimulationEngine::testFunctionOverride()
         QCOMPARE(retValue, returnValue);
 }
 
+void tst_QIviSimulationEngine::testPartialFunctionOverride()
+{
+    QIviSimulationEngine engine;
+
+    SimpleAPI testObject;
+    engine.registerSimulationInstance<SimpleAPI>(&testObject, "TestAPI", 1, 0, "SimpleAPI");
+
+    QByteArray qml ("import QtQuick 2.0; \n\
+                     import TestAPI 1.0; \n\
+                     SimpleAPI { \n\
+                        function simpleFunction() { \n\
+                            simpleFunctionCalled(); \n\
+                        } \n\
+                        function unknownFunction() { \n\
+                        } \n\
+                     }");
+
+    QQmlComponent component(&engine);
+    component.setData(qml, QUrl());
+    QScopedPointer<QObject> obj(component.create());
+    QVERIFY2(obj, qPrintable(component.errorString()));
+
+    QSignalSpy simpleSpy(&testObject, SIGNAL(simpleFunctionCalled()));
+    QSignalSpy argumentsSpy(&testObject, SIGNAL(functionWithArgumentsCalled(int, QString)));
+
+    //Only the function declared in QML is overridden, also when it is called repeatedly
+    testObject.simpleFunction();
+    testObject.simpleFunction();
+    QCOMPARE(simpleSpy.count(), 2);
+    QCOMPARE(testObject.m_callCounter, 0);
+
+    //The other functions still call the implementation
+    testObject.functionWithArguments(100, "Test");
+    QCOMPARE(argumentsSpy.count(), 1);
+    QCOMPARE(argumentsSpy.at(0), QVariantList({ 100, "Test" }));
+    QCOMPARE(testObject.m_callCounter, 1);
+    QCOMPARE(testObject.functionWithReturnValue(100), 100);
+    QCOMPARE(testObject.m_callCounter, 2);
+}
+
+void tst_QIviSimulationEngine::testFunctionOverrideArgumentMismatch()
+{
+    QIviSimulationEngine engine;
+
+    SimpleAPI testObject;
+    engine.registerSimulationInstance<SimpleAPI>(&testObject, "TestAPI", 1, 0, "SimpleAPI");
+
+    //The QML function takes less arguments than the C++ function
+    QByteArray qml ("import QtQuick 2.0; \n\
+                     import TestAPI 1.0; \n\
+                     SimpleAPI { \n\
+                        property int qmlCalls: 0 \n\
+                        function functionWithArguments(intArgument) { \n\
+                            qmlCalls++; \n\
+                        } \n\
+                     }");
+
+    QQmlComponent component(&engine);
+    component.setData(qml, QUrl());
+    QScopedPointer<QObject> obj(component.create());
+    QVERIFY2(obj, qPrintable(component.errorString()));
+
+    QSignalSpy spy(&testObject, SIGNAL(functionWithArgumentsCalled(int, QString)));
+
+    //The call is resolved by QMetaObject::invokeMethod instead. No function matches the arguments
+    //and the implementation is called
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("No such method .*functionWithArguments\\(QVariant,QVariant\\)"));
+    testObject.functionWithArguments(100, "Test");
+    QCOMPARE(obj->property("qmlCalls").toInt(), 0);
+    QCOMPARE(testObject.m_callCounter, 1);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.at(0), QVariantList({ 100, "Test" }));
+}
+
 void tst_QIviSimulationEngine::testCallingBaseFunction_data()
 {
     QTest::addColumn<QByteArray>("function");
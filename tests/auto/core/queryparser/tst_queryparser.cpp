@@ -56,6 +56,7 @@ private slots:
     void identifierList();
     void invalidIdentifierList_data();
     void invalidIdentifierList();
+    void sharedQuery();
 };
 
 void TestQueryParser::validQueries_data()
@@ -240,6 +241,32 @@ void TestQueryParser::invalidIdentifierList()
     QVERIFY(!parser.lastError().isEmpty());
 }
 
+void TestQueryParser::sharedQuery()
+{
+    QIviQuery empty;
+    QVERIFY(empty.isEmpty());
+    QVERIFY(!empty.term());
+    QVERIFY(empty.orderTerms().isEmpty());
+
+    QIviQueryParser parser;
+    parser.setQuery(QStringLiteral("name=\"Foo\" [/name]"));
+    QIviAbstractQueryTerm *term = parser.parse();
+    QVERIFY2(term, qPrintable(parser.lastError()));
+
+    QIviQuery copy;
+    {
+        QIviQuery query(term, parser.orderTerms());
+        QVERIFY(!query.isEmpty());
+        copy = query;
+    }
+
+    //The terms are owned by the query and stay alive as long as a copy exists
+    QCOMPARE(copy.term(), term);
+    QCOMPARE(copy.term()->toString(), QStringLiteral("name=Foo"));
+    QCOMPARE(copy.orderTerms().count(), 1);
+    QVERIFY(copy.orderTerms().first().isAscending());
+}
+
 //TODO add autotests for the orderTerms
 
 QTEST_MAIN(TestQueryParser)
@@ -30,8 +30,11 @@
 
 #include "simpleplugin.h"
 
+#include <QtCore/QThread>
+
 SimplePlugin::SimplePlugin()
     : QObject()
+    , m_creationThread(QThread::currentThread())
 {
 
 }
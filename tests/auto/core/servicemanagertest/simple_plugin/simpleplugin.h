@@ -35,10 +35,13 @@
 #include <QtCore/QStringList>
 #include <QtIviCore/QIviServiceInterface>
 
+class QThread;
+
 class SimplePlugin : public QObject, public QIviServiceInterface
 {
     Q_OBJECT
     Q_INTERFACES(QIviServiceInterface)
+    Q_PROPERTY(QObject *creationThread READ creationThread CONSTANT)
     Q_PLUGIN_METADATA(IID QIviServiceInterface_iid FILE "simple_plugin.json")
 public:
     explicit SimplePlugin();
@@ -53,6 +56,12 @@ public:
         return 0;
     }
 
+    QObject *creationThread() const {
+        return m_creationThread;
+    }
+
+private:
+    QObject *m_creationThread;
 };
 
 #endif // SIMPLEPLUGIN_H
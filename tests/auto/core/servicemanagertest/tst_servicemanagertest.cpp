@@ -100,14 +100,20 @@ private Q_SLOTS:
     void testRegisterNonServiceBackendInterfaceObject();
     void testManagerListModel();
     void pluginLoaderTest();
+    void pluginMetaDataCacheTest();
+    void pluginAsyncLoadingTest();
+    void pluginAsyncLoadingReplaceTest();
 
 private:
     QIviServiceManager *manager;
     QString m_simplePluginID;
+    QTemporaryDir m_cacheDir;
 };
 
 ServiceManagerTest::ServiceManagerTest()
 {
+    //Don't touch the plugin cache of the user
+    qputenv("QTIVI_PLUGIN_CACHE", QFile::encodeName(m_cacheDir.filePath("plugincache.json")));
 }
 
 void ServiceManagerTest::initTestCase()
@@ -326,6 +332,186 @@ void ServiceManagerTest::pluginLoaderTest()
     QCOMPARE(services.count(), 0);
 }
 
+static void ignorePluginWarnings()
+{
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("PluginManager - Malformed metaData in '(.*)wrongmetadata_plugin(.*)'. MetaData must contain a list of interfaces"));
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("PluginManager - Malformed metaData in static plugin 'WrongMetadataStaticPlugin'. MetaData must contain a list of interfaces"));
+#ifdef DEBUG_AND_RELEASE
+    QTest::ignoreMessage(QtInfoMsg, QRegularExpression("Found the same plugin in two configurations. Using the '.*' configuration: .*"));
+#endif
+}
+
+// Replaces the interfaces of the cached simple_plugin entries and optionally
+// invalidates the entry by changing the cached size.
+static bool modifyPluginCache(const QString &cacheFile, const QString &interface, bool invalidate)
+{
+    QFile file(cacheFile);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    QJsonObject cache = QJsonDocument::fromJson(file.readAll()).object();
+    file.close();
+
+    bool modified = false;
+    QJsonObject directories = cache.value("directories").toObject();
+    for (auto dirIt = directories.begin(); dirIt != directories.end(); ++dirIt) {
+        QJsonObject directory = dirIt.value().toObject();
+        QJsonObject plugins = directory.value("plugins").toObject();
+        for (auto it = plugins.begin(); it != plugins.end(); ++it) {
+            QJsonObject entry = it.value().toObject();
+            QJsonObject metaData = entry.value("MetaData").toObject();
+            QJsonObject pluginMetaData = metaData.value("MetaData").toObject();
+            const QJsonArray interfaces = pluginMetaData.value("interfaces").toArray();
+            if (!interfaces.contains(QJsonValue(QStringLiteral("simple_plugin")))
+                    && !interfaces.contains(QJsonValue(interface))) {
+                continue;
+            }
+            pluginMetaData.insert("interfaces", QJsonArray({ interface }));
+            metaData.insert("MetaData", pluginMetaData);
+            entry.insert("MetaData", metaData);
+            if (invalidate)
+                entry.insert("size", -1);
+            it.value() = entry;
+            modified = true;
+        }
+        directory.insert("plugins", plugins);
+        dirIt.value() = directory;
+    }
+    cache.insert("directories", directories);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+    file.write(QJsonDocument(cache).toJson());
+    return modified;
+}
+
+static QJsonObject cachedDirectories(const QString &cacheFile)
+{
+    QFile file(cacheFile);
+    if (!file.open(QIODevice::ReadOnly))
+        return QJsonObject();
+    return QJsonDocument::fromJson(file.readAll()).object().value("directories").toObject();
+}
+
+// Adds an empty entry for the directory, like an application with a different plugin directory would
+static bool addCachedDirectory(const QString &cacheFile, const QString &directory)
+{
+    QFile file(cacheFile);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    QJsonObject cache = QJsonDocument::fromJson(file.readAll()).object();
+    file.close();
+
+    QJsonObject directories = cache.value("directories").toObject();
+    const QString canonicalPath = QDir(directory).canonicalPath();
+    directories.insert(canonicalPath.isEmpty() ? directory : canonicalPath, QJsonObject({
+        { "lastModified", 0 },
+        { "files", QJsonArray() },
+        { "plugins", QJsonObject() }
+    }));
+    cache.insert("directories", directories);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+    return file.write(QJsonDocument(cache).toJson()) != -1;
+}
+
+void ServiceManagerTest::pluginMetaDataCacheTest()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString cacheFile = tempDir.filePath("plugincache.json");
+    qputenv("QTIVI_PLUGIN_CACHE", QFile::encodeName(cacheFile));
+
+    //The first scan reads the metadata from the plugins and creates the cache
+    ignorePluginWarnings();
+    QIviServiceManagerPrivate::get(manager)->searchPlugins();
+    QVERIFY(QFile::exists(cacheFile));
+    QVERIFY(manager->hasInterface("simple_plugin"));
+    manager->unloadAllBackends();
+
+    //As long as the plugin is unchanged, the metadata is taken from the cache
+    QVERIFY(modifyPluginCache(cacheFile, QStringLiteral("cached_simple_plugin"), false));
+    ignorePluginWarnings();
+    QIviServiceManagerPrivate::get(manager)->searchPlugins();
+    QVERIFY(manager->hasInterface("cached_simple_plugin"));
+    QVERIFY(!manager->hasInterface("simple_plugin"));
+    manager->unloadAllBackends();
+
+    //An outdated entry is ignored and the metadata is read from the plugin again
+    QVERIFY(modifyPluginCache(cacheFile, QStringLiteral("cached_simple_plugin"), true));
+    ignorePluginWarnings();
+    QIviServiceManagerPrivate::get(manager)->searchPlugins();
+    QVERIFY(manager->hasInterface("simple_plugin"));
+    QVERIFY(!manager->hasInterface("cached_simple_plugin"));
+    manager->unloadAllBackends();
+
+    //The entries of directories searched by other applications are kept, unless they don't exist anymore
+    QVERIFY(addCachedDirectory(cacheFile, tempDir.path()));
+    QVERIFY(addCachedDirectory(cacheFile, tempDir.filePath("removed")));
+    ignorePluginWarnings();
+    QIviServiceManagerPrivate::get(manager)->searchPlugins();
+    QVERIFY(manager->hasInterface("simple_plugin"));
+    QVERIFY(cachedDirectories(cacheFile).contains(QDir(tempDir.path()).canonicalPath()));
+    QVERIFY(!cachedDirectories(cacheFile).contains(tempDir.filePath("removed")));
+    manager->unloadAllBackends();
+
+    qputenv("QTIVI_PLUGIN_CACHE", QFile::encodeName(m_cacheDir.filePath("plugincache.json")));
+}
+
+void ServiceManagerTest::pluginAsyncLoadingTest()
+{
+    QIviServiceManagerPrivate *d = QIviServiceManagerPrivate::get(manager);
+    ignorePluginWarnings();
+    d->searchPlugins();
+
+    bool loaded = false;
+    d->loadBackendsAsync("simple_plugin", QIviServiceManager::IncludeProductionBackends, this, [&loaded]() {
+        loaded = true;
+    });
+    QTRY_VERIFY(loaded);
+
+    //The library is loaded on a worker thread, but the plugin is created in the thread of the manager
+    const QVector<Backend*> backends = d->m_interfaceIndex.value("simple_plugin");
+    QCOMPARE(backends.count(), 1);
+    QVERIFY(backends.first()->loader);
+    QObject *plugin = backends.first()->loader->instance();
+    QVERIFY(plugin);
+    QCOMPARE(plugin->property("creationThread").value<QObject*>(), static_cast<QObject*>(manager->thread()));
+    QCOMPARE(plugin->thread(), manager->thread());
+    QCOMPARE(manager->findServiceByInterface("simple_plugin", QIviServiceManager::IncludeProductionBackends).count(), 1);
+    manager->unloadAllBackends();
+}
+
+void ServiceManagerTest::pluginAsyncLoadingReplaceTest()
+{
+    QIviServiceManagerPrivate *d = QIviServiceManagerPrivate::get(manager);
+    ignorePluginWarnings();
+    d->searchPlugins();
+
+    bool loaded = false;
+    d->loadBackendsAsync("simple_plugin", QIviServiceManager::IncludeProductionBackends, this, [&loaded]() {
+        loaded = true;
+    });
+
+    //Replacing the backend while it is loading, e.g. by the same plugin in a different configuration
+    const QVector<Backend*> backends = d->m_interfaceIndex.value("simple_plugin");
+    QCOMPARE(backends.count(), 1);
+    Backend *oldBackend = backends.first();
+    QVERIFY(d->m_loadingBackends.contains(oldBackend));
+    auto *backend = new Backend(*oldBackend);
+    d->replaceBackend(d->m_backends.indexOf(oldBackend), backend);
+
+    //The waiting request is finished once the replacement is loaded
+    QVERIFY(d->m_loadingBackends.contains(backend));
+    QVERIFY(!loaded);
+    QTRY_VERIFY(loaded);
+    QVERIFY(backend->interface);
+    QVERIFY(backend->loader);
+    QVERIFY(d->m_loadingBackends.isEmpty());
+    QCOMPARE(manager->findServiceByInterface("simple_plugin", QIviServiceManager::IncludeProductionBackends).count(), 1);
+    manager->unloadAllBackends();
+}
+
 Q_IMPORT_PLUGIN(SimpleStaticPlugin)
 Q_IMPORT_PLUGIN(WrongMetadataStaticPlugin)
 
@@ -0,0 +1,19 @@
+QT       += testlib geniviextras
+
+TARGET = tst_dltasynchronous
+QMAKE_PROJECT_NAME = $$TARGET
+CONFIG   += testcase
+
+# Only the headers of DLT are needed. The functions used by QtGeniviExtras are defined by the
+# stub in this test and take precedence over the ones from the DLT library.
+QMAKE_USE += dlt
+QMAKE_LFLAGS += -Wl,--export-dynamic
+
+TEMPLATE = app
+
+HEADERS += \
+    dltstub.h
+
+SOURCES += \
+    dltstub.cpp \
+    tst_dltasynchronous.cpp
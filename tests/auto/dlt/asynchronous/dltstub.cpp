@@ -0,0 +1,150 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 Luxoft Sweden AB
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtIvi module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT-QTAS$
+** Commercial License Usage
+** Licensees holding valid commercial Qt Automotive Suite licenses may use
+** this file in accordance with the commercial license agreement provided
+** with the Software or, alternatively, in accordance with the terms
+** contained in a written agreement between you and The Qt Company.  For
+** licensing terms and conditions see https://www.qt.io/terms-conditions.
+** For further information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "dltstub.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+
+#include <dlt/dlt.h>
+
+#include <cstring>
+
+namespace {
+    QMutex mutex;
+    QWaitCondition unblocked;
+    QWaitCondition messageBlocked;
+    bool blocked = false;
+    int blockedMessages = 0;
+    QVector<DltStubMessage> messageList;
+
+    thread_local QByteArray currentPayload;
+}
+
+QVector<DltStubMessage> DltStub::messages()
+{
+    QMutexLocker locker(&mutex);
+    return messageList;
+}
+
+void DltStub::clear()
+{
+    QMutexLocker locker(&mutex);
+    messageList.clear();
+    blockedMessages = 0;
+}
+
+void DltStub::setBlocked(bool block)
+{
+    QMutexLocker locker(&mutex);
+    blocked = block;
+    if (!blocked)
+        unblocked.wakeAll();
+}
+
+bool DltStub::waitForBlockedMessage(int timeout)
+{
+    QMutexLocker locker(&mutex);
+    if (blockedMessages > 0)
+        return true;
+    return messageBlocked.wait(&mutex, timeout);
+}
+
+// The functions used by the DLT macros in QtGeniviExtras
+
+extern "C" {
+
+DltReturnValue dlt_register_app(const char *apid, const char *description)
+{
+    Q_UNUSED(apid)
+    Q_UNUSED(description)
+    return DLT_RETURN_OK;
+}
+
+DltReturnValue dlt_unregister_app(void)
+{
+    return DLT_RETURN_OK;
+}
+
+DltReturnValue dlt_register_context_ll_ts(DltContext *handle, const char *contextid, const char *description, int loglevel, int tracestatus)
+{
+    Q_UNUSED(description)
+    Q_UNUSED(tracestatus)
+    memset(handle, 0, sizeof(DltContext));
+    strncpy(handle->contextID, contextid, DLT_ID_SIZE);
+    handle->log_level_ptr = new int8_t(int8_t(loglevel));
+    return DLT_RETURN_OK;
+}
+
+DltReturnValue dlt_register_log_level_changed_callback(DltContext *handle, void (*dlt_log_level_changed_callback)(char context_id[DLT_ID_SIZE], uint8_t log_level, uint8_t trace_status))
+{
+    Q_UNUSED(handle)
+    Q_UNUSED(dlt_log_level_changed_callback)
+    return DLT_RETURN_OK;
+}
+
+DltReturnValue dlt_user_is_logLevel_enabled(DltContext *handle, DltLogLevelType loglevel)
+{
+    Q_UNUSED(handle)
+    Q_UNUSED(loglevel)
+    return DLT_RETURN_TRUE;
+}
+
+DltReturnValue dlt_user_log_write_start(DltContext *handle, DltContextData *log, DltLogLevelType loglevel)
+{
+    log->handle = handle;
+    log->log_level = loglevel;
+    currentPayload.clear();
+    return DLT_RETURN_TRUE;
+}
+
+DltReturnValue dlt_user_log_write_string(DltContextData *log, const char *text)
+{
+    Q_UNUSED(log)
+    currentPayload.append(text);
+    return DLT_RETURN_OK;
+}
+
+DltReturnValue dlt_user_log_write_finish(DltContextData *log)
+{
+    QMutexLocker locker(&mutex);
+    if (blocked) {
+        ++blockedMessages;
+        messageBlocked.wakeAll();
+        while (blocked)
+            unblocked.wait(&mutex);
+    }
+
+    messageList.append({ QByteArray(log->handle->contextID, qstrnlen(log->handle->contextID, DLT_ID_SIZE)),
+                         log->log_level,
+                         currentPayload });
+    return DLT_RETURN_OK;
+}
+
+}
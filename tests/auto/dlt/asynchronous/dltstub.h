@@ -0,0 +1,52 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 Luxoft Sweden AB
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtIvi module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT-QTAS$
+** Commercial License Usage
+** Licensees holding valid commercial Qt Automotive Suite licenses may use
+** this file in accordance with the commercial license agreement provided
+** with the Software or, alternatively, in accordance with the terms
+** contained in a written agreement between you and The Qt Company.  For
+** licensing terms and conditions see https://www.qt.io/terms-conditions.
+** For further information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef DLTSTUB_H
+#define DLTSTUB_H
+
+#include <QByteArray>
+#include <QVector>
+
+// Records all messages which are passed to DLT instead of sending them to a dlt-daemon
+struct DltStubMessage {
+    QByteArray contextId;
+    int logLevel;
+    QByteArray payload;
+};
+
+namespace DltStub {
+    QVector<DltStubMessage> messages();
+    void clear();
+
+    // While blocked, every message stalls inside DLT as if the dlt-daemon wouldn't respond
+    void setBlocked(bool blocked);
+    // Waits until a message stalls because the stub is blocked
+    bool waitForBlockedMessage(int timeout = 5000);
+}
+
+#endif // DLTSTUB_H
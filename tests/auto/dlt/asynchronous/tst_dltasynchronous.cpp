@@ -0,0 +1,218 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 Luxoft Sweden AB
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtIvi module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT-QTAS$
+** Commercial License Usage
+** Licensees holding valid commercial Qt Automotive Suite licenses may use
+** this file in accordance with the commercial license agreement provided
+** with the Software or, alternatively, in accordance with the terms
+** contained in a written agreement between you and The Qt Company.  For
+** licensing terms and conditions see https://www.qt.io/terms-conditions.
+** For further information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QString>
+#include <QtTest>
+#include <QtGeniviExtras/QtDlt>
+#include <QLoggingCategory>
+#include <QThread>
+
+#include "dltstub.h"
+
+Q_LOGGING_CATEGORY(TEST1, "qtgeniviextras.test1", QtWarningMsg)
+
+class LoggingThread : public QThread
+{
+public:
+    LoggingThread(int first, int count)
+        : m_first(first)
+        , m_count(count)
+    {}
+
+    void run() override
+    {
+        for (int i = m_first; i < m_first + m_count; ++i)
+            qCWarning(TEST1, "message %d", i);
+    }
+
+private:
+    int m_first;
+    int m_count;
+};
+
+class QDltAsynchronousTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanup();
+
+    void testLogging();
+    void testLevelFilter();
+    void testDropNewestMessage();
+    void testDropOldestMessage();
+    void testBlockUntilSpaceAvailable();
+
+private:
+    QStringList payloads() const;
+    void stallLogger();
+};
+
+void QDltAsynchronousTest::initTestCase()
+{
+    QDltRegistration *registration = globalDltRegistration();
+    registration->registerApplication("APP1", "Description for APP");
+    registration->registerCategory(&TEST1(), "TES1", "Test Category One");
+
+    qInstallMessageHandler(QDltRegistration::messageHandler);
+}
+
+void QDltAsynchronousTest::cleanup()
+{
+    DltStub::setBlocked(false);
+    globalDltRegistration()->disableAsynchronousLogging();
+    DltStub::clear();
+}
+
+QStringList QDltAsynchronousTest::payloads() const
+{
+    QStringList list;
+    const auto messages = DltStub::messages();
+    for (const DltStubMessage &message : messages)
+        list.append(QString::fromLocal8Bit(message.payload));
+    return list;
+}
+
+// Logs a message which stalls the logger thread inside DLT, all further messages stay queued
+void QDltAsynchronousTest::stallLogger()
+{
+    DltStub::setBlocked(true);
+    qCWarning(TEST1, "stalled");
+    QVERIFY(DltStub::waitForBlockedMessage());
+}
+
+void QDltAsynchronousTest::testLogging()
+{
+    QDltRegistration *registration = globalDltRegistration();
+    const quint64 dropped = registration->droppedMessages();
+    registration->enableAsynchronousLogging(1024);
+    QVERIFY(registration->isAsynchronousLoggingEnabled());
+
+    QVector<LoggingThread*> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.append(new LoggingThread(i * 100, 100));
+        threads.last()->start();
+    }
+    for (LoggingThread *thread : qAsConst(threads)) {
+        QVERIFY(thread->wait(5000));
+        delete thread;
+    }
+
+    // Disabling forwards all buffered messages
+    registration->disableAsynchronousLogging();
+    QVERIFY(!registration->isAsynchronousLoggingEnabled());
+
+    const auto messages = DltStub::messages();
+    QCOMPARE(messages.count(), 400);
+    QCOMPARE(messages.at(0).contextId, QByteArray("TES1"));
+    QCOMPARE(messages.at(0).logLevel, int(DLT_LOG_WARN));
+    QSet<QString> received = payloads().toSet();
+    for (int i = 0; i < 400; ++i)
+        QVERIFY(received.contains(QStringLiteral("qtgeniviextras.test1: message %1").arg(i)));
+    QCOMPARE(registration->droppedMessages(), dropped);
+}
+
+void QDltAsynchronousTest::testLevelFilter()
+{
+    globalDltRegistration()->enableAsynchronousLogging();
+
+    // The category was registered with the warning level, debug messages never reach DLT
+    TEST1().setEnabled(QtDebugMsg, true);
+    qCDebug(TEST1, "filtered");
+    TEST1().setEnabled(QtDebugMsg, false);
+    qCCritical(TEST1, "forwarded");
+
+    globalDltRegistration()->disableAsynchronousLogging();
+    QCOMPARE(payloads(), QStringList({ QStringLiteral("qtgeniviextras.test1: forwarded") }));
+}
+
+void QDltAsynchronousTest::testDropNewestMessage()
+{
+    QDltRegistration *registration = globalDltRegistration();
+    const quint64 dropped = registration->droppedMessages();
+    registration->enableAsynchronousLogging(4, QDltRegistration::DropNewestMessage);
+    stallLogger();
+
+    for (int i = 0; i < 10; ++i)
+        qCWarning(TEST1, "message %d", i);
+    QCOMPARE(registration->droppedMessages(), dropped + 6);
+
+    DltStub::setBlocked(false);
+    registration->disableAsynchronousLogging();
+    QCOMPARE(payloads(), QStringList({ QStringLiteral("qtgeniviextras.test1: stalled"),
+                                       QStringLiteral("qtgeniviextras.test1: message 0"),
+                                       QStringLiteral("qtgeniviextras.test1: message 1"),
+                                       QStringLiteral("qtgeniviextras.test1: message 2"),
+                                       QStringLiteral("qtgeniviextras.test1: message 3") }));
+}
+
+void QDltAsynchronousTest::testDropOldestMessage()
+{
+    QDltRegistration *registration = globalDltRegistration();
+    const quint64 dropped = registration->droppedMessages();
+    registration->enableAsynchronousLogging(4, QDltRegistration::DropOldestMessage);
+    stallLogger();
+
+    for (int i = 0; i < 10; ++i)
+        qCWarning(TEST1, "message %d", i);
+    QCOMPARE(registration->droppedMessages(), dropped + 6);
+
+    DltStub::setBlocked(false);
+    registration->disableAsynchronousLogging();
+    QCOMPARE(payloads(), QStringList({ QStringLiteral("qtgeniviextras.test1: stalled"),
+                                       QStringLiteral("qtgeniviextras.test1: message 6"),
+                                       QStringLiteral("qtgeniviextras.test1: message 7"),
+                                       QStringLiteral("qtgeniviextras.test1: message 8"),
+                                       QStringLiteral("qtgeniviextras.test1: message 9") }));
+}
+
+void QDltAsynchronousTest::testBlockUntilSpaceAvailable()
+{
+    QDltRegistration *registration = globalDltRegistration();
+    const quint64 dropped = registration->droppedMessages();
+    registration->enableAsynchronousLogging(2, QDltRegistration::BlockUntilSpaceAvailable);
+    stallLogger();
+
+    // The thread can't finish as long as the logger thread is stalled
+    LoggingThread thread(0, 5);
+    thread.start();
+    QVERIFY(!thread.wait(200));
+
+    DltStub::setBlocked(false);
+    QVERIFY(thread.wait(5000));
+    registration->disableAsynchronousLogging();
+
+    QCOMPARE(payloads().count(), 6);
+    QCOMPARE(payloads().last(), QStringLiteral("qtgeniviextras.test1: message 4"));
+    QCOMPARE(registration->droppedMessages(), dropped);
+}
+
+QTEST_APPLESS_MAIN(QDltAsynchronousTest)
+
+#include "tst_dltasynchronous.moc"
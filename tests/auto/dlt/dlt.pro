@@ -1,14 +1,8 @@
-QT       += testlib geniviextras
+TEMPLATE = subdirs
 
-TARGET = tst_dlt
-QMAKE_PROJECT_NAME = $$TARGET
-CONFIG   += testcase
+QT_FOR_CONFIG += geniviextras-private
 
-QMAKE_USE += dlt
+SUBDIRS = logging
 
-TEMPLATE = app
-
-SOURCES += \
-    tst_dlt.cpp
-
-DEFINES += SRCDIR=\\\"$$PWD/\\\"
+# The stub replaces the DLT library functions as provided by DLT >= 2.12
+qtConfig(dlt_2_12): SUBDIRS += asynchronous